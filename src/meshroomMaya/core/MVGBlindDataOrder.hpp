@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>
+
+namespace meshroomMaya
+{
+
+/**
+ * @brief Order of the blind data of a vertex (see MVGMesh::ClickedCSPosition), by camera id.
+ *
+ * Camera ids are AliceVision view ids: uint32 hashes, half of them >= 2^31, which MeshroomMaya
+ * passes around as int. Sorting and searching must both compare them as stored, unsigned.
+ * These do not depend on Maya, so that they can be checked outside of it (see src/tests).
+ */
+namespace blindDataOrder
+{
+
+template <typename BlindData>
+bool isLess(const BlindData& a, const BlindData& b)
+{
+    return a.cameraId < b.cameraId;
+}
+
+template <typename BlindData>
+bool isLessId(const BlindData& blindData, const unsigned int cameraId)
+{
+    return blindData.cameraId < cameraId;
+}
+
+/// Blind data of the camera in [first, last) sorted with isLess, NULL if there is none
+template <typename BlindData>
+const BlindData* find(const BlindData* first, const BlindData* last, const int cameraId)
+{
+    const unsigned int id = static_cast<unsigned int>(cameraId);
+    const BlindData* it = std::lower_bound(first, last, id, isLessId<BlindData>);
+    return (it == last || it->cameraId != id) ? NULL : it;
+}
+
+} // namespace blindDataOrder
+
+} // namespace
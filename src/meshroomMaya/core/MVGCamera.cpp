@@ -3,6 +3,8 @@
 #include "meshroomMaya/core/MVGLog.hpp"
 #include "meshroomMaya/core/MVGPointCloud.hpp"
 #include "meshroomMaya/core/MVGPointCloudItem.hpp"
+#include "meshroomMaya/core/MVGSceneRegistry.hpp"
+#include "meshroomMaya/core/MVGVisibilityIndex.hpp"
 #include "meshroomMaya/maya/MVGMayaUtil.hpp"
 #include "meshroomMaya/maya/cmd/MVGImagePlaneCmd.hpp"
 #include <maya/MPoint.h>
@@ -15,12 +17,43 @@
 #include <maya/MDagModifier.h>
 #include <maya/MFnNumericAttribute.h>
 #include <maya/MFnTypedAttribute.h>
-#include <maya/MItDependencyNodes.h>
 #include <maya/MDagPathArray.h>
+#include <maya/MFnIntArrayData.h>
 
 namespace meshroomMaya
 {
 
+namespace
+{ // empty namespace
+
+/// One image plane per cached image and per view
+const size_t MAX_FREE_IMAGE_PLANES = IMAGE_CACHE_SIZE + 2;
+
+bool containsNode(const std::list<MObjectHandle>& nodes, const MObject& node)
+{
+    for(std::list<MObjectHandle>::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+    {
+        if(it->object() == node)
+            return true;
+    }
+    return false;
+}
+
+/// Camera the image plane is connected to, null object if none
+MObject getImagePlaneCamera(const MObject& imageNode)
+{
+    MPlugArray connectedPlugs;
+    MFnDependencyNode(imageNode).findPlug("message").connectedTo(connectedPlugs, false, true);
+    for(unsigned int i = 0; i < connectedPlugs.length(); ++i)
+    {
+        if(connectedPlugs[i].node().hasFn(MFn::kCamera))
+            return connectedPlugs[i].node();
+    }
+    return MObject::kNullObj;
+}
+
+} // empty namespace
+
 // dynamic attributes
 MString MVGCamera::_MVG_ITEMS = "mvg_visibleItems";
 
@@ -33,6 +66,11 @@ MString MVGCamera::_MVG_IMAGE_PATH = "mvg_imagePath";
 MString MVGCamera::_MVG_THUMBNAIL_PATH = "mvg_thumbnailPath";
 MString MVGCamera::_MVG_SENSOR_SIZE = "mvg_sensorSizePix";
 
+// static
+std::list<MObjectHandle> MVGCamera::_freeImagePlanes;
+// static
+std::list<MObjectHandle> MVGCamera::_createdImagePlanes;
+
 MVGCamera::MVGCamera()
     : MVGNodeWrapper()
 {
@@ -51,20 +89,11 @@ MVGCamera::MVGCamera(const MDagPath& dagPath)
 MVGCamera::MVGCamera(const int& id)
     : MVGNodeWrapper()
 {
-    MStatus status;
     MDagPath path;
-    MItDependencyNodes it(MFn::kCamera);
-    for(; !it.isDone(); it.next())
+    if(MVGSceneRegistry::getCameraPath(id, path) && MVGCamera(path).isValid())
     {
-        MFnDependencyNode fn(it.thisNode());
-        status = MDagPath::getAPathTo(fn.object(), path);
-        CHECK_RETURN(status)
-        MVGCamera camera(path);
-        if(camera.isValid() && (camera.getId() == id))
-        {
-            status = MDagPath::getAPathTo(fn.object(), _dagpath);
-            return;
-        }
+        _dagpath = path;
+        return;
     }
     LOG_ERROR("Unable to find camera with id " << id)
 }
@@ -108,60 +137,102 @@ bool MVGCamera::isValid() const
     return true;
 }
 
-MVGCamera MVGCamera::create(MDagPath& cameraDagPath, const std::map<int, MIntArray>& itemsPerCamera)
+/**
+ * Batched configuration of the cameras imported by AbcImport: the MVG attributes of all the
+ * cameras are added by one doIt() of the modifier, then all the plug values are queued on the
+ * same modifier and set by a second doIt().
+ * The image paths follow the Meshroom export layout: the source image path is kept in
+ * mvg_imageSourcePath, mvg_imagePath and mvg_thumbnailPath point to the undistorted images.
+ */
+// static
+MStatus MVGCamera::create(const MDagPathArray& cameraPaths, const MVGVisibilityIndex& visibility,
+                          const std::string& projectDirectory)
 {
     MStatus status;
-
-    cameraDagPath.extendToShape();
-    MObject cameraNode = cameraDagPath.node();
-
-    MVGCamera camera(cameraDagPath);
-
-    // Configure camera
-    MFnCamera fnCamera(cameraDagPath);
-    fnCamera.setPanZoomEnabled(true);
-    // Reset film offset (should not be necessary, but kept for compatibility)
-    fnCamera.setHorizontalFilmOffset((0.0));
-    fnCamera.setVerticalFilmOffset((0.0));
-
-    // Add MVG attributes
     MDagModifier dagModifier;
     MFnTypedAttribute tAttr;
-    // Visibility
-    int viewID;
-    MVGMayaUtil::getIntAttribute(cameraNode, "mvg_viewId", viewID);
-    MObject itemsAttr = tAttr.create(MVGCamera::_MVG_ITEMS, "itm", MFnData::kIntArray);
-    dagModifier.addAttribute(cameraNode, itemsAttr);
-    MObject thumbnailAttr = tAttr.create(MVGCamera::_MVG_THUMBNAIL_PATH, "mtp", MFnData::kString);
-    dagModifier.addAttribute(cameraNode, thumbnailAttr);
-    MObject imgSourceAttr =
-        tAttr.create(MVGCamera::_MVG_IMAGE_SOURCE_PATH, "misp", MFnData::kString);
-    dagModifier.addAttribute(cameraNode, imgSourceAttr);
-    dagModifier.doIt();
-
-    // Set MVG attributes
-    if(itemsPerCamera.find(viewID) != itemsPerCamera.end())
+    std::vector<MDagPath> cameras;
+    cameras.reserve(cameraPaths.length());
+    std::vector<int> viewIds;
+    viewIds.reserve(cameraPaths.length());
+
+    // Add MVG attributes
+    for(unsigned int i = 0; i < cameraPaths.length(); ++i)
     {
-        MVGMayaUtil::setIntArrayAttribute(cameraNode, MVGCamera::_MVG_ITEMS, itemsPerCamera.at(viewID));
+        const MDagPath& cameraDagPath = cameraPaths[i];
+        if(cameraDagPath.apiType() != MFn::kCamera)
+            continue;
+        MObject cameraNode = cameraDagPath.node();
+        int viewID = -1;
+        MVGMayaUtil::getIntAttribute(cameraNode, _MVG_VIEW_ID, viewID);
+        cameras.push_back(cameraDagPath);
+        viewIds.push_back(viewID);
+        dagModifier.addAttribute(cameraNode,
+                                 tAttr.create(MVGCamera::_MVG_ITEMS, "itm", MFnData::kIntArray));
+        dagModifier.addAttribute(
+            cameraNode, tAttr.create(MVGCamera::_MVG_THUMBNAIL_PATH, "mtp", MFnData::kString));
+        dagModifier.addAttribute(
+            cameraNode, tAttr.create(MVGCamera::_MVG_IMAGE_SOURCE_PATH, "misp", MFnData::kString));
     }
-    else
+    status = dagModifier.doIt();
+    CHECK_RETURN_STATUS(status)
+
+    // Set camera and MVG attributes
+    MFnIntArrayData fnItems;
+    MIntArray items;
+    std::string proxyPath;
+    std::string thumbnailPath;
+    for(size_t i = 0; i < cameras.size(); ++i)
     {
-        // No visibility information
-        LOG_INFO("MVGCamera: viewID=" << viewID << " is NOT in the itemsPerCamera, so we initialize it to an empty array.")
-        MIntArray empyArray;
-        MVGMayaUtil::setIntArrayAttribute(cameraNode, MVGCamera::_MVG_ITEMS, empyArray);
+        MFnDependencyNode fnCamera(cameras[i].node());
+        dagModifier.newPlugValueBool(fnCamera.findPlug("panZoomEnabled", false), true);
+        // Reset film offset (should not be necessary, but kept for compatibility)
+        dagModifier.newPlugValueDouble(fnCamera.findPlug("horizontalFilmOffset", false), 0.0);
+        dagModifier.newPlugValueDouble(fnCamera.findPlug("verticalFilmOffset", false), 0.0);
+
+        // Visibility
+        const int cameraIndex = visibility.findCamera(viewIds[i]);
+        if(cameraIndex < 0)
+        {
+            LOG_INFO("MVGCamera: viewID=" << viewIds[i]
+                                          << " is NOT in the visibility index, so we initialize "
+                                             "it to an empty array.")
+        }
+        visibility.getCameraPoints(cameraIndex, items);
+        dagModifier.newPlugValue(fnCamera.findPlug(_MVG_ITEMS, false), fnItems.create(items));
+
+        // Image paths
+        MPlug imagePathPlug = fnCamera.findPlug(_MVG_IMAGE_PATH, false);
+        if(imagePathPlug.isNull())
+            continue;
+        const MString imagePath = imagePathPlug.asString();
+        getUndistortedImagePaths(projectDirectory, imagePath.asChar(), viewIds[i], proxyPath,
+                                 thumbnailPath);
+        dagModifier.newPlugValueString(fnCamera.findPlug(_MVG_IMAGE_SOURCE_PATH, false),
+                                       imagePath);
+        dagModifier.newPlugValueString(imagePathPlug, proxyPath.c_str());
+        dagModifier.newPlugValueString(fnCamera.findPlug(_MVG_THUMBNAIL_PATH, false),
+                                       thumbnailPath.c_str());
     }
+    status = dagModifier.doIt();
+    CHECK_RETURN_STATUS(status)
+    return status;
+}
 
-    // create, reparent & connect image plane
-    MString cmd;
-    MGlobal::executePythonCommand("from meshroomMaya import camera");
-    MString fileName = "";
-    cmd.format("camera.mvgSetImagePlane(\'^1s\', \'^2s\')", cameraDagPath.fullPathName(), fileName);
-    MGlobal::executePythonCommand(cmd);
-
-    // Configure image plane
-    camera.setImagePlane();
-    return camera;
+// static
+void MVGCamera::getUndistortedImagePaths(const std::string& projectDirectory,
+                                         const std::string& imagePath, const int viewId,
+                                         std::string& proxyPath, std::string& thumbnailPath)
+{
+    const size_t separator = imagePath.find_last_of("/\\");
+    std::string imageName =
+        (separator == std::string::npos) ? imagePath : imagePath.substr(separator + 1);
+    const size_t dot = imageName.find_last_of('.');
+    if(dot != std::string::npos)
+        imageName.resize(dot);
+    imageName += "-" + std::to_string(viewId);
+    proxyPath = projectDirectory + "/undistort/proxy/" + imageName + "-UOP.jpg";
+    thumbnailPath = projectDirectory + "/undistort/thumbnail/" + imageName + "-UOT.jpg";
 }
 
 /**
@@ -175,14 +246,20 @@ std::vector<MVGCamera> MVGCamera::getCameras()
     // Retrieve meshroomMaya camera group path
     MDagPath cameraGroupDagPath;
     status = MVGMayaUtil::getDagPathByName(MVGProject::_CAMERAS_GROUP.c_str(), cameraGroupDagPath);
+    if(!status)
+        return list;
+    const MString cameraGroupPrefix = cameraGroupDagPath.fullPathName() + "|";
 
-    MDagPathArray cameraPaths;
-    cameraGroupDagPath.getAllPathsBelow(cameraPaths);
-    list.reserve(cameraPaths.length());
+    std::vector<MDagPath> cameraPaths;
+    MVGSceneRegistry::getCameraPaths(cameraPaths);
+    list.reserve(cameraPaths.size());
 
-    for(unsigned int i = 0; i < cameraPaths.length(); ++i)
+    for(std::vector<MDagPath>::const_iterator it = cameraPaths.begin(); it != cameraPaths.end();
+        ++it)
     {
-        MVGCamera cam(cameraPaths[i]);
+        if(it->fullPathName().indexW(cameraGroupPrefix) != 0)
+            continue;
+        MVGCamera cam(*it);
         if(cam.isValid())
             list.push_back(cam);
     }
@@ -218,11 +295,9 @@ MDagPath MVGCamera::getImagePlaneShapeDagPath() const
     MPlugArray connectedPlugs;
     imagePlug.connectedTo(connectedPlugs, true, true, &status);
     CHECK(status)
+    // image planes are created on demand
     if(connectedPlugs.length() == 0)
-    {
-        LOG_ERROR("No plug connected to the plug for camera : " << getName())
         return path;
-    }
     status = MDagPath::getAPathTo(connectedPlugs[0].node(), path);
     CHECK(status)
     return path;
@@ -237,11 +312,101 @@ std::string MVGCamera::getThumbnailPath() const
     return imageName;
 }
 
+/**
+ * Cameras get an image plane the first time they are shown: the plane released by a camera
+ * evicted from the image cache is moved to this camera, a new one is created only if none is
+ * free. The number of image planes is thus bounded by the cameras shown recently, instead of
+ * one per camera.
+ */
+MDagPath MVGCamera::acquireImagePlane() const
+{
+    MDagPath imagePath = getImagePlaneShapeDagPath();
+    if(imagePath.isValid())
+    {
+        // the camera takes back its own plane if it has not been recycled yet
+        const MObject imageNode = imagePath.node();
+        for(std::list<MObjectHandle>::iterator it = _freeImagePlanes.begin();
+            it != _freeImagePlanes.end(); ++it)
+        {
+            if(it->object() != imageNode)
+                continue;
+            _freeImagePlanes.erase(it);
+            break;
+        }
+        return imagePath;
+    }
+
+    // MVG cameras are locked once loaded
+    MFnDagNode fnCamera(_dagpath);
+    const bool isLocked = fnCamera.isLocked();
+    fnCamera.setLocked(false);
+    // the planes that could not be moved are kept for the next cameras
+    std::list<MObjectHandle> unmovedImagePlanes;
+    while(!_freeImagePlanes.empty() && !imagePath.isValid())
+    {
+        const MObjectHandle handle = _freeImagePlanes.front();
+        _freeImagePlanes.pop_front();
+        MDagPath freePath;
+        if(!handle.isValid() || !MDagPath::getAPathTo(handle.object(), freePath))
+            continue;
+        // the plane is also disconnected from its previous camera, locked as well
+        MFnDependencyNode fnPreviousCamera;
+        bool isPreviousLocked = false;
+        const MObject previousCamera = getImagePlaneCamera(handle.object());
+        if(!previousCamera.isNull())
+        {
+            fnPreviousCamera.setObject(previousCamera);
+            isPreviousLocked = fnPreviousCamera.isLocked();
+            fnPreviousCamera.setLocked(false);
+        }
+        MString cmd;
+        cmd.format("imagePlane -edit -camera \"^1s\" \"^2s\"", _dagpath.fullPathName(),
+                   freePath.fullPathName());
+        if(MGlobal::executeCommand(cmd))
+            imagePath = getImagePlaneShapeDagPath();
+        if(!previousCamera.isNull())
+            fnPreviousCamera.setLocked(isPreviousLocked);
+        if(!imagePath.isValid())
+            unmovedImagePlanes.push_back(handle);
+    }
+    _freeImagePlanes.splice(_freeImagePlanes.end(), unmovedImagePlanes);
+    if(imagePath.isValid())
+    {
+        // configured for its previous camera
+        setImagePlane();
+    }
+    else
+    {
+        createImagePlane();
+        imagePath = getImagePlaneShapeDagPath();
+    }
+    fnCamera.setLocked(isLocked);
+    return imagePath;
+}
+
+void MVGCamera::createImagePlane() const
+{
+    // create, reparent & connect image plane
+    MString cmd;
+    MGlobal::executePythonCommand("from meshroomMaya import camera");
+    MString fileName = "";
+    cmd.format("camera.mvgSetImagePlane(\'^1s\', \'^2s\')", _dagpath.fullPathName(), fileName);
+    MGlobal::executePythonCommand(cmd);
+
+    // Configure image plane
+    setImagePlane();
+    const MDagPath imagePath = getImagePlaneShapeDagPath();
+    if(imagePath.isValid())
+        _createdImagePlanes.push_back(MObjectHandle(imagePath.node()));
+}
+
 void MVGCamera::setImagePlane() const
 {
     MStatus status;
     // Configure image plane
     MDagPath imagePath = getImagePlaneShapeDagPath();
+    if(!imagePath.isValid())
+        return;
 
     MFnDagNode fnImage(imagePath, &status);
     CHECK_RETURN(status)
@@ -259,15 +424,61 @@ void MVGCamera::setImagePlane() const
 void MVGCamera::unloadImagePlane() const
 {
     MStatus status;
-    MFnDagNode fnImage(getImagePlaneShapeDagPath(), &status);
+    MDagPath imagePath = getImagePlaneShapeDagPath();
+    if(!imagePath.isValid())
+        return;
+    MFnDagNode fnImage(imagePath, &status);
     CHECK_RETURN(status)
     MPlug imageNamePlug = fnImage.findPlug("imageName", &status);
     CHECK_RETURN(status)
     MString name = imageNamePlug.asString();
-    if(name.length() == 0)
+    if(name.length() != 0)
+    {
+        status = imageNamePlug.setValue("");
+        CHECK(status)
+    }
+    releaseImagePlane(imagePath);
+}
+
+/**
+ * Keep the image plane for the next camera to show. If the pool is full, the image plane is
+ * deleted if it was created by the pool, left to its camera otherwise (e.g. scenes loaded with
+ * one image plane per camera).
+ */
+// static
+void MVGCamera::releaseImagePlane(const MDagPath& imagePath)
+{
+    const MObject imageNode = imagePath.node();
+    if(containsNode(_freeImagePlanes, imageNode))
         return;
-    status = imageNamePlug.setValue("");
-    CHECK_RETURN(status)
+    if(_freeImagePlanes.size() < MAX_FREE_IMAGE_PLANES)
+    {
+        _freeImagePlanes.push_back(MObjectHandle(imageNode));
+        return;
+    }
+    std::list<MObjectHandle>::iterator it = _createdImagePlanes.begin();
+    while(it != _createdImagePlanes.end() && it->object() != imageNode)
+    {
+        // forget the deleted ones on the way
+        if(it->isValid())
+            ++it;
+        else
+            it = _createdImagePlanes.erase(it);
+    }
+    if(it == _createdImagePlanes.end())
+        return;
+    _createdImagePlanes.erase(it);
+    // the image plane shape is parented under its own transform
+    MDagPath transformPath = imagePath;
+    transformPath.pop();
+    MGlobal::deleteNode(transformPath.node());
+}
+
+// static
+void MVGCamera::clearImagePlanes()
+{
+    _freeImagePlanes.clear();
+    _createdImagePlanes.clear();
 }
 
 MPoint MVGCamera::getCenter(MSpace::Space space) const
@@ -421,6 +632,8 @@ void MVGCamera::setImagePlaneDepth(const double depth) const
 {
     MStatus status;
     MDagPath imagePath = getImagePlaneShapeDagPath();
+    if(!imagePath.isValid())
+        return;
     MFnDagNode fnImage(imagePath, &status);
     CHECK_RETURN(status)
     fnImage.findPlug("depth").setValue(depth);
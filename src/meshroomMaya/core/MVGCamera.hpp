@@ -2,17 +2,21 @@
 
 #include "meshroomMaya/core/MVGNodeWrapper.hpp"
 #include <maya/MColor.h>
+#include <maya/MObjectHandle.h>
+#include <list>
 #include <vector>
 #include <map>
 
 class MString;
 class MPoint;
 class MIntArray;
+class MDagPathArray;
 
 namespace meshroomMaya
 {
 
 class MVGPointCloudItem;
+class MVGVisibilityIndex;
 
 class MVGCamera : public MVGNodeWrapper
 {
@@ -31,15 +35,26 @@ public:
     virtual bool isValid() const;
 
 public:
-    static MVGCamera create(MDagPath& cameraDagPath, const std::map<int, MIntArray>& itemsPerCamera);
+    static MStatus create(const MDagPathArray& cameraPaths, const MVGVisibilityIndex& visibility,
+                          const std::string& projectDirectory);
+    /// Undistorted proxy and thumbnail images of a view, as exported by Meshroom
+    static void getUndistortedImagePaths(const std::string& projectDirectory,
+                                         const std::string& imagePath, const int viewId,
+                                         std::string& proxyPath, std::string& thumbnailPath);
     static std::vector<MVGCamera> getCameras();
+    /// Forget the image planes of the pool, when the scene changes
+    static void clearImagePlanes();
 
 public:
     int getId() const;
     void setId(const int&) const;
+    /// Image plane connected to the camera, invalid path if it has none
     MDagPath getImagePlaneShapeDagPath() const;
     std::string getThumbnailPath() const;
+    /// Image plane of the camera, recycled from the pool or created if it has none
+    MDagPath acquireImagePlane() const;
     void setImagePlane() const;
+    /// Clear the image and give the image plane back to the pool
     void unloadImagePlane() const;
     MPoint getCenter(MSpace::Space space = MSpace::kWorld) const;
     void getSensorSize(MIntArray& sensorSize) const;
@@ -72,12 +87,20 @@ public:
     static MString _MVG_THUMBNAIL_PATH;
     static MString _MVG_ITEMS;
     static MString _MVG_VIEW_ID;
-
-private:
     static MString _MVG_INTRINSIC_ID;
     static MString _MVG_INTRINSIC_TYPE;
     static MString _MVG_INTRINSICS_PARAMS;
     static MString _MVG_SENSOR_SIZE;
+
+private:
+    void createImagePlane() const;
+    static void releaseImagePlane(const MDagPath& imagePath);
+
+private:
+    /// image planes without image, still connected to their last camera until recycled
+    static std::list<MObjectHandle> _freeImagePlanes;
+    /// image planes created by the pool, the only ones it deletes
+    static std::list<MObjectHandle> _createdImagePlanes;
 };
 
 } // namespace
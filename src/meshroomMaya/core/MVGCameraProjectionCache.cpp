@@ -0,0 +1,180 @@
+#include "meshroomMaya/core/MVGCameraProjectionCache.hpp"
+#include "meshroomMaya/core/MVGCamera.hpp"
+#include "meshroomMaya/core/MVGGeometryUtil.hpp"
+#include "meshroomMaya/core/MVGLog.hpp"
+#include "meshroomMaya/core/MVGSceneRegistry.hpp"
+#include "meshroomMaya/maya/MVGMayaUtil.hpp"
+#include <aliceVision/multiview/projection.hpp>
+#include <maya/MDoubleArray.h>
+#include <maya/MFnAttribute.h>
+#include <maya/MIntArray.h>
+#include <maya/MMatrix.h>
+#include <maya/MMessage.h>
+#include <maya/MPlug.h>
+#include <maya/MTransformationMatrix.h>
+
+namespace meshroomMaya
+{
+
+std::map<int, MVGCameraProjectionCache::Entry> MVGCameraProjectionCache::_entries;
+
+void MVGCameraProjectionCache::Projection::cameraToImageSpace(const MPoint& cameraPoint,
+                                                              MPoint& imagePoint) const
+{
+    assert(horizontalFilmAperture != 0.0);
+    const double width = sensorWidth;
+    const double height = sensorHeight;
+    const MPoint pointCenteredNorm = cameraPoint / horizontalFilmAperture;
+    const double verticalMargin = (width - height) / 2.0;
+    imagePoint.x = (pointCenteredNorm.x + 0.5) * width;
+    imagePoint.y = (-pointCenteredNorm.y + 0.5) * width - verticalMargin;
+}
+
+// static
+const MVGCameraProjectionCache::Projection* MVGCameraProjectionCache::get(const int cameraId)
+{
+    std::map<int, Entry>::iterator it = _entries.find(cameraId);
+    if(it == _entries.end())
+        it = _entries.insert(std::make_pair(cameraId, Entry())).first;
+    Entry& entry = it->second;
+    if(entry.isValid)
+        return &entry.projection;
+    if(build(cameraId, entry))
+        return &entry.projection;
+    // no entry for the invalid ids: build() removed the callbacks, and the registry remembers
+    // the missing cameras until one is added
+    _entries.erase(it);
+    return NULL;
+}
+
+// static
+void MVGCameraProjectionCache::clear()
+{
+    for(std::map<int, Entry>::iterator it = _entries.begin(); it != _entries.end(); ++it)
+        removeCallbacks(it->second);
+    _entries.clear();
+}
+
+/**
+ * @brief Compute the projection matrix of the camera and watch the camera for changes.
+ */
+// static
+bool MVGCameraProjectionCache::build(const int cameraId, Entry& entry)
+{
+    // callbacks are never removed from inside themselves: drop the previous ones here
+    removeCallbacks(entry);
+    // deleted cameras are remembered by the registry, without logging
+    MDagPath cameraPath;
+    if(!MVGSceneRegistry::getCameraPath(cameraId, cameraPath))
+        return false;
+    MVGCamera camera(cameraPath);
+    if(!camera.isValid())
+        return false;
+    const MDagPath& path = camera.getDagPath();
+
+    // Retrieve the intrinsic matrix from 'mvg_intrinsicParams' attribute
+    //
+    // K Matrix:
+    // f*k_u     0      c_u
+    //   0     f*k_v    c_v
+    //   0       0       1
+    // c_u, c_v : the principal point, which would be ideally in the centre of the image.
+    //
+    MStatus status;
+    MDoubleArray intrinsicsArray;
+    status = MVGMayaUtil::getDoubleArrayAttribute(path.node(), MVGCamera::_MVG_INTRINSICS_PARAMS,
+                                                  intrinsicsArray);
+    CHECK_RETURN_VARIABLE(status, false)
+    MIntArray sensorSize;
+    camera.getSensorSize(sensorSize);
+    if(intrinsicsArray.length() < 1 || sensorSize.length() < 2)
+        return false;
+    Projection& projection = entry.projection;
+    projection.focal = intrinsicsArray[0];
+    projection.sensorWidth = sensorSize[0];
+    projection.sensorHeight = sensorSize[1];
+    projection.horizontalFilmAperture = camera.getHorizontalFilmAperture();
+
+    // Keep ideal matrix with principal point centered
+    aliceVision::Mat3 K;
+    K << projection.focal, 0.0, projection.sensorWidth / 2.0, 0.0, projection.focal,
+        projection.sensorHeight / 2.0, 0.0, 0.0, 1.0;
+
+    // Retrieve transformation matrix
+    const MTransformationMatrix transformMatrix(path.inclusiveMatrix());
+    const MMatrix rotationMatrix = transformMatrix.asRotateMatrix();
+    aliceVision::Mat3 R;
+    for(int m = 0; m < 3; ++m)
+    {
+        for(int j = 0; j < 3; ++j)
+        {
+            // Maya has inverted Y and Z axes
+            const int sign = (m > 0) ? -1 : 1;
+            R(m, j) = sign * rotationMatrix[m][j];
+        }
+    }
+
+    // Retrieve translation vector
+    const aliceVision::Vec3 C = TO_VEC3(camera.getCenter());
+    const aliceVision::Vec3 t = -R * C;
+
+    // Compute projection matrix
+    aliceVision::Mat34 P;
+    aliceVision::P_From_KRt(K, R, t, &P);
+    projection.P = P;
+
+    // Watch the camera: the entry address is stable until clear(), which removes the callbacks
+    entry.node = MObjectHandle(path.node());
+    MObject node = path.node();
+    MDagPath transformPath = path;
+    transformPath.pop();
+    MCallbackId id =
+        MDagMessage::addWorldMatrixModifiedCallback(transformPath, worldMatrixModifiedCB, &entry,
+                                                    &status);
+    if(status)
+        entry.callbacks.append(id);
+    id = MNodeMessage::addAttributeChangedCallback(node, attributeChangedCB, &entry, &status);
+    if(status)
+        entry.callbacks.append(id);
+    id = MNodeMessage::addNodePreRemovalCallback(node, nodePreRemovalCB, &entry, &status);
+    if(status)
+        entry.callbacks.append(id);
+    entry.isValid = true;
+    return true;
+}
+
+// static
+void MVGCameraProjectionCache::removeCallbacks(Entry& entry)
+{
+    if(entry.callbacks.length() > 0)
+        MMessage::removeCallbacks(entry.callbacks);
+    entry.callbacks.clear();
+}
+
+// static
+void MVGCameraProjectionCache::worldMatrixModifiedCB(MObject&, MDagMessage::MatrixModifiedFlags&,
+                                                     void* data)
+{
+    static_cast<Entry*>(data)->isValid = false;
+}
+
+// static
+void MVGCameraProjectionCache::attributeChangedCB(MNodeMessage::AttributeMessage msg, MPlug& plug,
+                                                  MPlug&, void* data)
+{
+    if(!(msg & MNodeMessage::kAttributeSet))
+        return;
+    MFnAttribute fnAttr(plug.attribute());
+    const MString name = fnAttr.name();
+    if(name == MVGCamera::_MVG_INTRINSICS_PARAMS || name == MVGCamera::_MVG_SENSOR_SIZE ||
+       name == MVGCamera::_MVG_VIEW_ID || name == "horizontalFilmAperture")
+        static_cast<Entry*>(data)->isValid = false;
+}
+
+// static
+void MVGCameraProjectionCache::nodePreRemovalCB(MObject&, void* data)
+{
+    static_cast<Entry*>(data)->isValid = false;
+}
+
+} // namespace
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "MVGEigen.hpp"
+#include <maya/MCallbackIdArray.h>
+#include <maya/MDagMessage.h>
+#include <maya/MNodeMessage.h>
+#include <maya/MObjectHandle.h>
+#include <maya/MPoint.h>
+#include <map>
+
+namespace meshroomMaya
+{
+
+/**
+ * @brief Process-wide cache of the camera projections used by the N-view triangulation.
+ *
+ * Building a projection matrix reads the intrinsics and the sensor size through plugs and
+ * decomposes the camera world matrix. Projections are computed once per camera id, then reused
+ * until the camera world matrix or one of its MeshroomMaya attributes change, the camera is
+ * deleted or a new scene is opened.
+ */
+class MVGCameraProjectionCache
+{
+public:
+    struct Projection
+    {
+        /// unaligned: stored in a std::map
+        Eigen::Matrix<double, 3, 4, Eigen::DontAlign> P;
+        double focal;
+        int sensorWidth;
+        int sensorHeight;
+        double horizontalFilmAperture;
+
+        /// Same as MVGGeometryUtil::cameraToImageSpace, without reading the camera attributes
+        void cameraToImageSpace(const MPoint& cameraPoint, MPoint& imagePoint) const;
+    };
+
+public:
+    /**
+     * @brief Get the projection of the camera with the given id, computing it if needed.
+     * @param[in] cameraId MeshroomMaya view id
+     * @return NULL if there is no valid camera with this id, nothing is cached then. The pointer
+     * stays valid until the next call to clear(), or to get() with this id if it fails.
+     */
+    static const Projection* get(const int cameraId);
+    /// Remove all the projections and their callbacks
+    static void clear();
+
+private:
+    struct Entry
+    {
+        Entry()
+            : isValid(false)
+        {
+        }
+        Projection projection;
+        MObjectHandle node;
+        MCallbackIdArray callbacks;
+        bool isValid;
+    };
+
+private:
+    static bool build(const int cameraId, Entry& entry);
+    static void removeCallbacks(Entry& entry);
+    static void worldMatrixModifiedCB(MObject& transformNode,
+                                      MDagMessage::MatrixModifiedFlags& modified, void* data);
+    static void attributeChangedCB(MNodeMessage::AttributeMessage msg, MPlug& plug,
+                                   MPlug& otherPlug, void* data);
+    static void nodePreRemovalCB(MObject& node, void* data);
+
+private:
+    static std::map<int, Entry> _entries;
+};
+
+} // namespace
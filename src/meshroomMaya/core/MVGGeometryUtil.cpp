@@ -2,9 +2,11 @@
 #include "meshroomMaya/core/MVGPointCloud.hpp"
 #include "meshroomMaya/core/MVGProject.hpp"
 #include "meshroomMaya/core/MVGCamera.hpp"
+#include "meshroomMaya/core/MVGCameraProjectionCache.hpp"
 #include "meshroomMaya/core/MVGLog.hpp"
 #include "meshroomMaya/core/MVGPlaneKernel.hpp"
 #include "meshroomMaya/core/MVGLineConstrainedPlaneKernel.hpp"
+#include "meshroomMaya/core/MVGWindingNumber.hpp"
 #include "meshroomMaya/maya/MVGMayaUtil.hpp"
 #include <aliceVision/multiview/triangulation/Triangulation.hpp>
 #include <aliceVision/multiview/projection.hpp>
@@ -18,22 +20,31 @@
 namespace meshroomMaya
 {
 
+namespace
+{ // empty namespace
+
+double getBoundingBoxDiagonal(const aliceVision::Mat& points)
+{
+    return (points.rowwise().maxCoeff() - points.rowwise().minCoeff()).norm();
+}
+
+} // empty namespace
+
+MVGGeometryUtil::EPlaneEstimator MVGGeometryUtil::_planeEstimator =
+    MVGGeometryUtil::ePlaneEstimatorAngularSweep;
+MVGRansacOptions MVGGeometryUtil::_ransacOptions;
+double MVGGeometryUtil::_ransacRelativeThreshold = 0.01;
+
+MVGGeometryUtil::PlaneEstimationSettings::PlaneEstimationSettings()
+    : estimator(_planeEstimator)
+    , ransacOptions(_ransacOptions)
+    , ransacRelativeThreshold(_ransacRelativeThreshold)
+{
+}
+
 void MVGGeometryUtil::viewToCameraSpace(M3dView& view, const MPoint& viewPoint, MPoint& cameraPoint)
 {
-    double portHeight = (double)view.portHeight();
-    double portWidth = (double)view.portWidth();
-    MDagPath dagPath;
-    view.getCamera(dagPath);
-    MVGCamera camera(dagPath);
-    // center
-    cameraPoint.x = (viewPoint.x / portWidth) - 0.5;
-    cameraPoint.y = (viewPoint.y / portWidth) - 0.5 - 0.5 * (portHeight / portWidth - 1.0);
-    cameraPoint.z = 0.;
-    // zoom
-    cameraPoint = cameraPoint * camera.getHorizontalFilmAperture() * camera.getZoom();
-    // pan
-    cameraPoint.x += camera.getHorizontalPan();
-    cameraPoint.y += camera.getVerticalPan();
+    MVGProjectionSnapshot(view).viewToCamera(viewPoint, cameraPoint);
 }
 
 MPoint MVGGeometryUtil::viewToCameraSpace(M3dView& view, const MPoint& viewPoint)
@@ -46,9 +57,7 @@ MPoint MVGGeometryUtil::viewToCameraSpace(M3dView& view, const MPoint& viewPoint
 void MVGGeometryUtil::viewToCameraSpace(M3dView& view, const MPointArray& viewPoints,
                                         MPointArray& cameraPoints)
 {
-    cameraPoints.setLength(viewPoints.length());
-    for(size_t i = 0; i < viewPoints.length(); ++i)
-        viewToCameraSpace(view, viewPoints[i], cameraPoints[i]);
+    viewToCameraSpace(MVGProjectionSnapshot(view), viewPoints, cameraPoints);
 }
 
 MPointArray MVGGeometryUtil::viewToCameraSpace(M3dView& view, const MPointArray& viewPoints)
@@ -60,21 +69,7 @@ MPointArray MVGGeometryUtil::viewToCameraSpace(M3dView& view, const MPointArray&
 
 void MVGGeometryUtil::cameraToViewSpace(M3dView& view, const MPoint& cameraPoint, MPoint& viewPoint)
 {
-    MDagPath dagPath;
-    view.getCamera(dagPath);
-    MVGCamera camera(dagPath);
-    float x = cameraPoint.x;
-    float y = cameraPoint.y;
-    // pan
-    x -= camera.getHorizontalPan();
-    y -= camera.getVerticalPan();
-    // zoom
-    x /= (camera.getHorizontalFilmAperture() * camera.getZoom());
-    y /= (camera.getHorizontalFilmAperture() * camera.getZoom());
-    // center
-    viewPoint.x = round((x + 0.5) * view.portWidth());
-    viewPoint.y = round((y + 0.5 + 0.5 * (view.portHeight() / (float)view.portWidth() - 1.0)) *
-                        view.portWidth());
+    MVGProjectionSnapshot(view).cameraToView(cameraPoint, viewPoint);
 }
 
 MPoint MVGGeometryUtil::cameraToViewSpace(M3dView& view, const MPoint& cameraPoint)
@@ -87,9 +82,7 @@ MPoint MVGGeometryUtil::cameraToViewSpace(M3dView& view, const MPoint& cameraPoi
 void MVGGeometryUtil::cameraToViewSpace(M3dView& view, const MPointArray& cameraPoints,
                                         MPointArray& viewPoints)
 {
-    viewPoints.setLength(cameraPoints.length());
-    for(size_t i = 0; i < viewPoints.length(); ++i)
-        cameraToViewSpace(view, cameraPoints[i], viewPoints[i]);
+    cameraToViewSpace(MVGProjectionSnapshot(view), cameraPoints, viewPoints);
 }
 
 MPointArray MVGGeometryUtil::cameraToViewSpace(M3dView& view, const MPointArray& cameraPoints)
@@ -101,18 +94,7 @@ MPointArray MVGGeometryUtil::cameraToViewSpace(M3dView& view, const MPointArray&
 
 void MVGGeometryUtil::worldToViewSpace(M3dView& view, const MPoint& worldPoint, MPoint& viewPoint)
 {
-    // don't use M3dView::worldToView() because of the cast to short values
-    MMatrix modelViewMatrix, projectionMatrix;
-    CHECK(view.modelViewMatrix(modelViewMatrix))
-    CHECK(view.projectionMatrix(projectionMatrix))
-    MPoint point = worldPoint * (modelViewMatrix * projectionMatrix);
-    unsigned int viewportX, viewportY, viewportWidth, viewportHeight;
-    view.viewport(viewportX, viewportY, viewportWidth, viewportHeight);
-    viewPoint.x =
-        static_cast<int>(static_cast<double>(viewportWidth) * (point.x / point.w + 1.0) / 2.0);
-    viewPoint.y =
-        static_cast<int>(static_cast<double>(viewportHeight) * (point.y / point.w + 1.0) / 2.0);
-    viewPoint.z = 0.0;
+    MVGProjectionSnapshot(view).worldToView(worldPoint, viewPoint);
 }
 
 MPoint MVGGeometryUtil::worldToViewSpace(M3dView& view, const MPoint& worldPoint)
@@ -125,9 +107,7 @@ MPoint MVGGeometryUtil::worldToViewSpace(M3dView& view, const MPoint& worldPoint
 void MVGGeometryUtil::worldToViewSpace(M3dView& view, const MPointArray& worldPoints,
                                        MPointArray& viewPoints)
 {
-    viewPoints.setLength(worldPoints.length());
-    for(size_t i = 0; i < worldPoints.length(); ++i)
-        worldToViewSpace(view, worldPoints[i], viewPoints[i]);
+    worldToViewSpace(MVGProjectionSnapshot(view), worldPoints, viewPoints);
 }
 
 MPointArray MVGGeometryUtil::worldToViewSpace(M3dView& view, const MPointArray& worldPoints)
@@ -170,28 +150,26 @@ MPointArray MVGGeometryUtil::viewToWorldSpace(M3dView& view, const MPointArray&
 void MVGGeometryUtil::worldToCameraSpace(M3dView& view, const MPoint& worldPoint,
                                          MPoint& cameraPoint)
 {
-    viewToCameraSpace(view, worldToViewSpace(view, worldPoint), cameraPoint);
+    MVGProjectionSnapshot(view).worldToCamera(worldPoint, cameraPoint);
 }
 
 MPoint MVGGeometryUtil::worldToCameraSpace(M3dView& view, const MPoint& worldPoint)
 {
     MPoint point;
-    viewToCameraSpace(view, worldToViewSpace(view, worldPoint), point);
+    worldToCameraSpace(view, worldPoint, point);
     return point;
 }
 
 void MVGGeometryUtil::worldToCameraSpace(M3dView& view, const MPointArray& worldPoints,
                                          MPointArray& cameraPoints)
 {
-    cameraPoints.setLength(worldPoints.length());
-    for(size_t i = 0; i < worldPoints.length(); ++i)
-        viewToCameraSpace(view, worldToViewSpace(view, worldPoints[i]), cameraPoints[i]);
+    worldToCameraSpace(MVGProjectionSnapshot(view), worldPoints, cameraPoints);
 }
 
 MPointArray MVGGeometryUtil::worldToCameraSpace(M3dView& view, const MPointArray& worldPoints)
 {
     MPointArray points;
-    viewToCameraSpace(view, worldToViewSpace(view, worldPoints), points);
+    worldToCameraSpace(view, worldPoints, points);
     return points;
 }
 
@@ -211,9 +189,7 @@ MPoint MVGGeometryUtil::cameraToWorldSpace(M3dView& view, const MPoint& cameraPo
 void MVGGeometryUtil::cameraToWorldSpace(M3dView& view, const MPointArray& cameraPoints,
                                          MPointArray& worldPoints)
 {
-    worldPoints.setLength(cameraPoints.length());
-    for(size_t i = 0; i < worldPoints.length(); ++i)
-        cameraToWorldSpace(view, cameraPoints[i], worldPoints[i]);
+    viewToWorldSpace(view, cameraToViewSpace(view, cameraPoints), worldPoints);
 }
 
 MPointArray MVGGeometryUtil::cameraToWorldSpace(M3dView& view, const MPointArray& cameraPoints)
@@ -223,11 +199,159 @@ MPointArray MVGGeometryUtil::cameraToWorldSpace(M3dView& view, const MPointArray
     return points;
 }
 
+void MVGGeometryUtil::viewToCameraSpace(const MVGProjectionSnapshot& projection,
+                                        const MPointArray& viewPoints, MPointArray& cameraPoints)
+{
+    const unsigned int length = viewPoints.length();
+    cameraPoints.setLength(length);
+    for(unsigned int i = 0; i < length; ++i)
+        projection.viewToCamera(viewPoints[i], cameraPoints[i]);
+}
+
+MPointArray MVGGeometryUtil::viewToCameraSpace(const MVGProjectionSnapshot& projection,
+                                               const MPointArray& viewPoints)
+{
+    MPointArray points;
+    viewToCameraSpace(projection, viewPoints, points);
+    return points;
+}
+
+MPoint MVGGeometryUtil::viewToCameraSpace(const MVGProjectionSnapshot& projection,
+                                          const MPoint& viewPoint)
+{
+    MPoint point;
+    projection.viewToCamera(viewPoint, point);
+    return point;
+}
+
+void MVGGeometryUtil::cameraToViewSpace(const MVGProjectionSnapshot& projection,
+                                        const MPointArray& cameraPoints, MPointArray& viewPoints)
+{
+    const unsigned int length = cameraPoints.length();
+    viewPoints.setLength(length);
+    for(unsigned int i = 0; i < length; ++i)
+        projection.cameraToView(cameraPoints[i], viewPoints[i]);
+}
+
+MPointArray MVGGeometryUtil::cameraToViewSpace(const MVGProjectionSnapshot& projection,
+                                               const MPointArray& cameraPoints)
+{
+    MPointArray points;
+    cameraToViewSpace(projection, cameraPoints, points);
+    return points;
+}
+
+MPoint MVGGeometryUtil::cameraToViewSpace(const MVGProjectionSnapshot& projection,
+                                          const MPoint& cameraPoint)
+{
+    MPoint point;
+    projection.cameraToView(cameraPoint, point);
+    return point;
+}
+
+void MVGGeometryUtil::worldToViewSpace(const MVGProjectionSnapshot& projection,
+                                       const MPointArray& worldPoints, MPointArray& viewPoints)
+{
+    const unsigned int length = worldPoints.length();
+    viewPoints.setLength(length);
+    for(unsigned int i = 0; i < length; ++i)
+        projection.worldToView(worldPoints[i], viewPoints[i]);
+}
+
+MPointArray MVGGeometryUtil::worldToViewSpace(const MVGProjectionSnapshot& projection,
+                                              const MPointArray& worldPoints)
+{
+    MPointArray points;
+    worldToViewSpace(projection, worldPoints, points);
+    return points;
+}
+
+MPoint MVGGeometryUtil::worldToViewSpace(const MVGProjectionSnapshot& projection,
+                                         const MPoint& worldPoint)
+{
+    MPoint point;
+    projection.worldToView(worldPoint, point);
+    return point;
+}
+
+void MVGGeometryUtil::viewToWorldSpace(const MVGProjectionSnapshot& projection,
+                                       const MPointArray& viewPoints, MPointArray& worldPoints)
+{
+    const unsigned int length = viewPoints.length();
+    worldPoints.setLength(length);
+    for(unsigned int i = 0; i < length; ++i)
+        projection.viewToWorld(viewPoints[i], worldPoints[i]);
+}
+
+MPointArray MVGGeometryUtil::viewToWorldSpace(const MVGProjectionSnapshot& projection,
+                                              const MPointArray& viewPoints)
+{
+    MPointArray points;
+    viewToWorldSpace(projection, viewPoints, points);
+    return points;
+}
+
+MPoint MVGGeometryUtil::viewToWorldSpace(const MVGProjectionSnapshot& projection,
+                                         const MPoint& viewPoint)
+{
+    MPoint point;
+    projection.viewToWorld(viewPoint, point);
+    return point;
+}
+
+void MVGGeometryUtil::worldToCameraSpace(const MVGProjectionSnapshot& projection,
+                                         const MPointArray& worldPoints, MPointArray& cameraPoints)
+{
+    const unsigned int length = worldPoints.length();
+    cameraPoints.setLength(length);
+    for(unsigned int i = 0; i < length; ++i)
+        projection.worldToCamera(worldPoints[i], cameraPoints[i]);
+}
+
+MPointArray MVGGeometryUtil::worldToCameraSpace(const MVGProjectionSnapshot& projection,
+                                                const MPointArray& worldPoints)
+{
+    MPointArray points;
+    worldToCameraSpace(projection, worldPoints, points);
+    return points;
+}
+
+MPoint MVGGeometryUtil::worldToCameraSpace(const MVGProjectionSnapshot& projection,
+                                           const MPoint& worldPoint)
+{
+    MPoint point;
+    projection.worldToCamera(worldPoint, point);
+    return point;
+}
+
+void MVGGeometryUtil::cameraToWorldSpace(const MVGProjectionSnapshot& projection,
+                                         const MPointArray& cameraPoints, MPointArray& worldPoints)
+{
+    const unsigned int length = cameraPoints.length();
+    worldPoints.setLength(length);
+    for(unsigned int i = 0; i < length; ++i)
+        projection.cameraToWorld(cameraPoints[i], worldPoints[i]);
+}
+
+MPointArray MVGGeometryUtil::cameraToWorldSpace(const MVGProjectionSnapshot& projection,
+                                                const MPointArray& cameraPoints)
+{
+    MPointArray points;
+    cameraToWorldSpace(projection, cameraPoints, points);
+    return points;
+}
+
+MPoint MVGGeometryUtil::cameraToWorldSpace(const MVGProjectionSnapshot& projection,
+                                           const MPoint& cameraPoint)
+{
+    MPoint point;
+    projection.cameraToWorld(cameraPoint, point);
+    return point;
+}
+
 void MVGGeometryUtil::cameraToImageSpace(MVGCamera& camera, const MPoint& cameraPoint,
                                          MPoint& imagePoint)
 {
-    MFnDagNode fnImage(camera.getImagePlaneShapeDagPath());
-
     MIntArray sensorSize;
     camera.getSensorSize(sensorSize);
     const double width = sensorSize[0];
@@ -268,6 +392,13 @@ MPointArray MVGGeometryUtil::cameraToImageSpace(MVGCamera& camera, const MPointA
  * @return
  */
 bool MVGGeometryUtil::computePlane(const MPointArray& pointsWS, PlaneKernel::Model& model)
+{
+    return computePlane(pointsWS, PlaneEstimationSettings(), model);
+}
+
+bool MVGGeometryUtil::computePlane(const MPointArray& pointsWS,
+                                   const PlaneEstimationSettings& settings,
+                                   PlaneKernel::Model& model)
 {
     if(pointsWS.length() < 3)
         return false;
@@ -276,6 +407,14 @@ bool MVGGeometryUtil::computePlane(const MPointArray& pointsWS, PlaneKernel::Mod
     for(size_t i = 0; i < pointsWS.length(); ++i)
         facePointsMat.col(i) = TO_VEC3(pointsWS[i]);
     PlaneKernel kernel(facePointsMat);
+    if(settings.estimator != ePlaneEstimatorLeastMedianOfSquares)
+    {
+        MVGRansacOptions options(settings.ransacOptions);
+        options.threshold =
+            settings.ransacRelativeThreshold * getBoundingBoxDiagonal(facePointsMat);
+        if(adaptiveRansac(kernel, options, &model))
+            return true;
+    }
     double outlierThreshold = std::numeric_limits<double>::infinity();
     aliceVision::robustEstimation::LeastMedianOfSquares(kernel, &model, &outlierThreshold);
 
@@ -292,6 +431,15 @@ bool MVGGeometryUtil::computePlane(const MPointArray& pointsWS, PlaneKernel::Mod
 bool MVGGeometryUtil::computePlaneWithLineConstraint(const MPointArray& pointsWS,
                                                      const MPointArray& constraintPoints,
                                                      LineConstrainedPlaneKernel::Model& model)
+{
+    return computePlaneWithLineConstraint(pointsWS, constraintPoints, PlaneEstimationSettings(),
+                                          model);
+}
+
+bool MVGGeometryUtil::computePlaneWithLineConstraint(const MPointArray& pointsWS,
+                                                     const MPointArray& constraintPoints,
+                                                     const PlaneEstimationSettings& settings,
+                                                     LineConstrainedPlaneKernel::Model& model)
 {
     if(pointsWS.length() < 3)
         return false;
@@ -302,52 +450,76 @@ bool MVGGeometryUtil::computePlaneWithLineConstraint(const MPointArray& pointsWS
         facePointsMat.col(i) = TO_VEC3(pointsWS[i]);
     LineConstrainedPlaneKernel kernel(facePointsMat, TO_VEC3(constraintPoints[0]),
                                       TO_VEC3(constraintPoints[1]));
+    if(settings.estimator == ePlaneEstimatorAngularSweep && kernel.FitLeastMedian(&model))
+        return true;
+    if(settings.estimator == ePlaneEstimatorAdaptiveRansac)
+    {
+        MVGRansacOptions options(settings.ransacOptions);
+        options.threshold =
+            settings.ransacRelativeThreshold * getBoundingBoxDiagonal(facePointsMat);
+        if(adaptiveRansac(kernel, options, &model))
+            return true;
+    }
     double outlierThreshold = std::numeric_limits<double>::infinity();
     aliceVision::robustEstimation::LeastMedianOfSquares(kernel, &model, &outlierThreshold);
 
     return true;
 }
 
+bool MVGGeometryUtil::projectPointsOnPlane(M3dView& view, const MPointArray& toProjectCSPoints,
+                                           const PlaneKernel::Model& planeModel,
+                                           MPointArray& projectedWSPoints)
+{
+    return projectPointsOnPlane(MVGProjectionSnapshot(view), toProjectCSPoints, planeModel,
+                                projectedWSPoints);
+}
+
+bool MVGGeometryUtil::projectPointOnPlane(M3dView& view, const MPoint& toProjectCSPoint,
+                                          const PlaneKernel::Model& planeModel,
+                                          MPoint& projectedWSPoint)
+{
+    return projectPointOnPlane(MVGProjectionSnapshot(view), toProjectCSPoint, planeModel,
+                               projectedWSPoint);
+}
+
 /**
  *
- * @param view
+ * @param[in] projection : viewing parameters of the view
  * @param[in] toProjectCSPoints : points to project in the computed plane in Camera Space
  *coordinates
- * @param[in] faceWSPoints : all points used to compute plane in World Space coordinates
+ * @param[in] planeModel : plane to project on
  * @param[out] projectedWSPoints : toPojectCSPoints projected in plane in World Space coordinates
  * @return
  */
-bool MVGGeometryUtil::projectPointsOnPlane(M3dView& view, const MPointArray& toProjectCSPoints,
+bool MVGGeometryUtil::projectPointsOnPlane(const MVGProjectionSnapshot& projection,
+                                           const MPointArray& toProjectCSPoints,
                                            const PlaneKernel::Model& planeModel,
                                            MPointArray& projectedWSPoints)
 {
-    // Retrieve camera center
-    MDagPath cameraPath;
-    view.getCamera(cameraPath);
-    MVGCamera camera(cameraPath);
-    MPoint cameraCenter = camera.getCenter();
+    const MPoint& cameraCenter = projection.getCameraCenter();
 
     // project points on computed plane
+    MPoint toProjectWSPoint;
     MPoint projectedWSPoint;
     for(size_t i = 0; i < toProjectCSPoints.length(); ++i)
     {
-        plane_line_intersect(planeModel, cameraCenter,
-                             MVGGeometryUtil::cameraToWorldSpace(view, toProjectCSPoints[i]),
-                             projectedWSPoint);
+        projection.cameraToWorld(toProjectCSPoints[i], toProjectWSPoint);
+        plane_line_intersect(planeModel, cameraCenter, toProjectWSPoint, projectedWSPoint);
         projectedWSPoints.append(projectedWSPoint);
     }
     assert(toProjectCSPoints.length() == projectedWSPoints.length());
     return true;
 }
 
-bool MVGGeometryUtil::projectPointOnPlane(M3dView& view, const MPoint& toProjectCSPoint,
+bool MVGGeometryUtil::projectPointOnPlane(const MVGProjectionSnapshot& projection,
+                                          const MPoint& toProjectCSPoint,
                                           const PlaneKernel::Model& planeModel,
                                           MPoint& projectedWSPoint)
 {
     MPointArray toProjectCSPoints;
     MPointArray projectedWSPoints;
     toProjectCSPoints.append(toProjectCSPoint);
-    if(projectPointsOnPlane(view, toProjectCSPoints, planeModel, projectedWSPoints))
+    if(projectPointsOnPlane(projection, toProjectCSPoints, planeModel, projectedWSPoints))
     {
         assert(projectedWSPoints.length() == 1);
         projectedWSPoint = projectedWSPoints[0];
@@ -371,65 +543,43 @@ void MVGGeometryUtil::triangulatePoint(const std::map<int, MPoint>& point2dPerCa
     aliceVision::Mat2X imagePoints(2, cameraCount);
 
     std::vector<aliceVision::Mat34> projectiveCameras;
+    projectiveCameras.reserve(cameraCount);
     {
         std::map<int, MPoint>::const_iterator it = point2dPerCamera_CS.begin();
         for(size_t i = 0; it != point2dPerCamera_CS.end(); ++i, ++it)
         {
-            MVGCamera camera(it->first);
-            const MPoint& point2d_CS = it->second;
-
-            // Retrieve the intrinsic matrix from 'pinholeProjectionMatrix' attribute
-            //
-            // K Matrix:
-            // f*k_u     0      c_u
-            //   0     f*k_v    c_v
-            //   0       0       1
-            // c_u, c_v : the principal point, which would be ideally in the centre of the image.
-            //
-            MDoubleArray intrinsicsArray;
-            MVGMayaUtil::getDoubleArrayAttribute(camera.getDagPath().node(), "mvg_intrinsicParams",
-                                                 intrinsicsArray);
-            MIntArray sensorSize;
-            camera.getSensorSize(sensorSize);
-
-            // Keep ideal matrix with principal point centered
-            aliceVision::Mat3 K;
-            K << intrinsicsArray[0], 0.0, sensorSize[0] / 2.0, 0.0, intrinsicsArray[0],
-                sensorSize[1] / 2.0, 0.0, 0.0, 1.0;
-
-            // Retrieve transformation matrix
-            const MMatrix inclusiveMatrix = camera.getDagPath().inclusiveMatrix();
-            const MTransformationMatrix transformMatrix(inclusiveMatrix);
-            aliceVision::Mat3 R;
-            MMatrix rotationMatrix = transformMatrix.asRotateMatrix();
-            for(int m = 0; m < 3; ++m)
+            const MVGCameraProjectionCache::Projection* projection =
+                MVGCameraProjectionCache::get(it->first);
+            if(!projection)
             {
-                for(int j = 0; j < 3; ++j)
-                {
-                    // Maya has inverted Y and Z axes
-                    int sign = 1;
-                    if(m > 0)
-                        sign = -1;
-                    R(m, j) = sign * rotationMatrix[m][j];
-                }
+                LOG_ERROR("Unable to retrieve projection of camera with id " << it->first)
+                return;
             }
-
-            // Retrieve translation vector
-            const aliceVision::Vec3 C = TO_VEC3(camera.getCenter());
-            const aliceVision::Vec3 t = -R * C;
-
-            // Compute projection matrix
-            aliceVision::Mat34 P;
-            aliceVision::P_From_KRt(K, R, t, &P);
-            projectiveCameras.push_back(P);
+            projectiveCameras.push_back(projection->P);
 
             // clicked point matrix (image space)
             MPoint clickedISPosition;
-            MVGGeometryUtil::cameraToImageSpace(camera, point2d_CS, clickedISPosition);
+            projection->cameraToImageSpace(it->second, clickedISPosition);
             imagePoints.col(i) = aliceVision::Vec2(clickedISPosition.x, clickedISPosition.y);
         }
     }
 
+    if(!triangulatePoint(imagePoints, projectiveCameras, outTriangulatedPoint_WS))
+        LOG_ERROR("Triangulated point w = 0")
+}
+
+/**
+ * @brief N-View triangulation from image space observations.
+ *
+ * @param imagePoints observations in Image Space, one column per camera
+ * @param projectiveCameras projection matrices, in the same order as imagePoints
+ * @param outTriangulatedPoint_WS 3D triangulated point in World Space
+ * @return false if the triangulated point is at infinity
+ */
+bool MVGGeometryUtil::triangulatePoint(const aliceVision::Mat2X& imagePoints,
+                                       const std::vector<aliceVision::Mat34>& projectiveCameras,
+                                       MPoint& outTriangulatedPoint_WS)
+{
     // call n-view triangulation function
     aliceVision::Vec4 result;
     aliceVision::TriangulateNViewAlgebraic(imagePoints, projectiveCameras, &result);
@@ -437,11 +587,9 @@ void MVGGeometryUtil::triangulatePoint(const std::map<int, MPoint>& point2dPerCa
     outTriangulatedPoint_WS.y = result(1);
     outTriangulatedPoint_WS.z = result(2);
     if(result(3) == 0.0)
-    {
-        LOG_ERROR("Triangulated point w = 0")
-        return;
-    }
+        return false;
     outTriangulatedPoint_WS = outTriangulatedPoint_WS / result(3);
+    return true;
 }
 
 double MVGGeometryUtil::crossProduct2D(MVector& A, MVector& B)
@@ -469,4 +617,49 @@ bool MVGGeometryUtil::doEdgesIntersect(MPoint A, MPoint B, MVector AD, MVector B
     return false;
 }
 
+/**
+ * @brief Winding number of a point with respect to a closed polygon.
+ *
+ * See: Algorithm 1 "Area of Triangles and Polygons".
+ *
+ * @param[in] closedPolygon vertices of the polygon, with closedPolygon[n] == closedPolygon[0]
+ * @param[in] point 2D point to test
+ * @return the winding number (0 only when point is outside)
+ */
+int MVGGeometryUtil::computeWindingNumber(const MPointArray& closedPolygon, const MPoint& point)
+{
+    int windingNumber;
+    computeWindingNumbers(closedPolygon, &point.x, &point.y, 1, &windingNumber);
+    return windingNumber;
+}
+
+/**
+ * @brief Winding numbers of a batch of 2D points, stored as separate x and y arrays.
+ *
+ * Points are tested 4 at a time when the CPU supports AVX2, the remaining ones with the scalar
+ * loop (see MVGWindingNumber.hpp). The side test uses the exact cross product
+ * sign: it used to be truncated to int, which made no difference for the integer view space
+ * coordinates it is called with.
+ *
+ * @param[in] closedPolygon vertices of the polygon, with closedPolygon[n] == closedPolygon[0]
+ * @param[in] x x coordinates of the points to test
+ * @param[in] y y coordinates of the points to test
+ * @param[in] count number of points to test
+ * @param[out] windingNumbers winding number of each point (0 only when outside)
+ */
+void MVGGeometryUtil::computeWindingNumbers(const MPointArray& closedPolygon, const double* x,
+                                            const double* y, const int count, int* windingNumbers)
+{
+    const int edgesCount = static_cast<int>(closedPolygon.length()) - 1;
+    std::vector<double> polygonX(edgesCount + 1);
+    std::vector<double> polygonY(edgesCount + 1);
+    for(int i = 0; i <= edgesCount; ++i)
+    {
+        polygonX[i] = closedPolygon[i].x;
+        polygonY[i] = closedPolygon[i].y;
+    }
+    windingNumber::compute(&polygonX[0], &polygonY[0], edgesCount, x, y, count,
+                           windingNumbers);
+}
+
 } // namespace
@@ -2,10 +2,13 @@
 
 #include "meshroomMaya/core/MVGPlaneKernel.hpp"
 #include "meshroomMaya/core/MVGLineConstrainedPlaneKernel.hpp"
+#include "meshroomMaya/core/MVGProjectionSnapshot.hpp"
+#include "meshroomMaya/core/MVGRansac.hpp"
 
 #include <maya/MVector.h>
 
 #include <map>
+#include <vector>
 
 
 class MPoint;
@@ -22,6 +25,24 @@ class MVGCamera;
 
 struct MVGGeometryUtil
 {
+    enum EPlaneEstimator
+    {
+        ePlaneEstimatorLeastMedianOfSquares = 0,
+        ePlaneEstimatorAdaptiveRansac,
+        /// exact least median sweep for line constrained fits, adaptive RANSAC otherwise
+        ePlaneEstimatorAngularSweep
+    };
+
+    /// Copy of the plane estimation settings, taken in the main thread for the worker threads
+    struct PlaneEstimationSettings
+    {
+        /// Current values of the settings static members
+        PlaneEstimationSettings();
+        EPlaneEstimator estimator;
+        MVGRansacOptions ransacOptions;
+        double ransacRelativeThreshold;
+    };
+
     // space conversion
     static void viewToCameraSpace(M3dView& view, const MPoint& viewPoint, MPoint& cameraPoint);
     static MPoint viewToCameraSpace(M3dView& view, const MPoint& viewPoint);
@@ -59,6 +80,49 @@ struct MVGGeometryUtil
                                    MPointArray& worldPoints);
     static MPointArray cameraToWorldSpace(M3dView& view, const MPointArray& cameraPoints);
 
+    // space conversion using viewing parameters captured once
+    static void viewToCameraSpace(const MVGProjectionSnapshot& projection,
+                                  const MPointArray& viewPoints, MPointArray& cameraPoints);
+    static MPointArray viewToCameraSpace(const MVGProjectionSnapshot& projection,
+                                         const MPointArray& viewPoints);
+    static MPoint viewToCameraSpace(const MVGProjectionSnapshot& projection,
+                                    const MPoint& viewPoint);
+
+    static void cameraToViewSpace(const MVGProjectionSnapshot& projection,
+                                  const MPointArray& cameraPoints, MPointArray& viewPoints);
+    static MPointArray cameraToViewSpace(const MVGProjectionSnapshot& projection,
+                                         const MPointArray& cameraPoints);
+    static MPoint cameraToViewSpace(const MVGProjectionSnapshot& projection,
+                                    const MPoint& cameraPoint);
+
+    static void worldToViewSpace(const MVGProjectionSnapshot& projection,
+                                 const MPointArray& worldPoints, MPointArray& viewPoints);
+    static MPointArray worldToViewSpace(const MVGProjectionSnapshot& projection,
+                                        const MPointArray& worldPoints);
+    static MPoint worldToViewSpace(const MVGProjectionSnapshot& projection,
+                                   const MPoint& worldPoint);
+
+    static void viewToWorldSpace(const MVGProjectionSnapshot& projection,
+                                 const MPointArray& viewPoints, MPointArray& worldPoints);
+    static MPointArray viewToWorldSpace(const MVGProjectionSnapshot& projection,
+                                        const MPointArray& viewPoints);
+    static MPoint viewToWorldSpace(const MVGProjectionSnapshot& projection,
+                                   const MPoint& viewPoint);
+
+    static void worldToCameraSpace(const MVGProjectionSnapshot& projection,
+                                   const MPointArray& worldPoints, MPointArray& cameraPoints);
+    static MPointArray worldToCameraSpace(const MVGProjectionSnapshot& projection,
+                                          const MPointArray& worldPoints);
+    static MPoint worldToCameraSpace(const MVGProjectionSnapshot& projection,
+                                     const MPoint& worldPoint);
+
+    static void cameraToWorldSpace(const MVGProjectionSnapshot& projection,
+                                   const MPointArray& cameraPoints, MPointArray& worldPoints);
+    static MPointArray cameraToWorldSpace(const MVGProjectionSnapshot& projection,
+                                          const MPointArray& cameraPoints);
+    static MPoint cameraToWorldSpace(const MVGProjectionSnapshot& projection,
+                                     const MPoint& cameraPoint);
+
     static void cameraToImageSpace(MVGCamera& camera, const MPoint& cameraPoint,
                                    MPoint& imagePoint);
     static MPoint cameraToImageSpace(MVGCamera& camera, const MPoint& cameraPoint);
@@ -68,22 +132,50 @@ struct MVGGeometryUtil
 
     // projections
     static bool computePlane(const MPointArray& points, PlaneKernel::Model& model);
+    static bool computePlane(const MPointArray& points, const PlaneEstimationSettings& settings,
+                             PlaneKernel::Model& model);
+    static bool computePlaneWithLineConstraint(const MPointArray& pointsWS,
+                                               const MPointArray& constraintPoints,
+                                               LineConstrainedPlaneKernel::Model& model);
     static bool computePlaneWithLineConstraint(const MPointArray& pointsWS,
                                                const MPointArray& constraintPoints,
+                                               const PlaneEstimationSettings& settings,
                                                LineConstrainedPlaneKernel::Model& model);
     static bool projectPointsOnPlane(M3dView& view, const MPointArray& toProjectCSPoints,
                                      const PlaneKernel::Model& planeModel,
                                      MPointArray& projectedWSPoints);
     static bool projectPointOnPlane(M3dView& view, const MPoint& toProjectCSPoint,
                                     const PlaneKernel::Model& planeModel, MPoint& projectedWSPoint);
+    static bool projectPointsOnPlane(const MVGProjectionSnapshot& projection,
+                                     const MPointArray& toProjectCSPoints,
+                                     const PlaneKernel::Model& planeModel,
+                                     MPointArray& projectedWSPoints);
+    static bool projectPointOnPlane(const MVGProjectionSnapshot& projection,
+                                    const MPoint& toProjectCSPoint,
+                                    const PlaneKernel::Model& planeModel, MPoint& projectedWSPoint);
 
     // triangulation
     static void triangulatePoint(const std::map<int, MPoint>& point2dPerCamera_CS,
                                  MPoint& outTriangulatedPoint_WS);
+    /// Thread-safe: does not access the Maya scene nor log
+    static bool triangulatePoint(const aliceVision::Mat2X& imagePoints,
+                                 const std::vector<aliceVision::Mat34>& projectiveCameras,
+                                 MPoint& outTriangulatedPoint_WS);
 
     // intersections
     static double crossProduct2D(MVector& A, MVector& B);
     static bool doEdgesIntersect(MPoint A, MPoint B, MVector AD, MVector BC);
+    static int computeWindingNumber(const MPointArray& closedPolygon, const MPoint& point);
+    static void computeWindingNumbers(const MPointArray& closedPolygon, const double* x,
+                                      const double* y, const int count, int* windingNumbers);
+
+    // plane estimation settings
+    /// Robust estimator used by computePlane and computePlaneWithLineConstraint
+    static EPlaneEstimator _planeEstimator;
+    /// Adaptive RANSAC parameters (the threshold is computed from _ransacRelativeThreshold)
+    static MVGRansacOptions _ransacOptions;
+    /// Adaptive RANSAC inlier threshold, relative to the points bounding box diagonal
+    static double _ransacRelativeThreshold;
 };
 
 } // namespace
@@ -0,0 +1,283 @@
+#include "meshroomMaya/core/MVGIncrementalPlaneEstimator.hpp"
+#include "meshroomMaya/core/MVGGeometryUtil.hpp"
+#include <maya/MPointArray.h>
+#include <algorithm>
+#include <cmath>
+
+namespace meshroomMaya
+{
+
+namespace
+{ // empty namespace
+
+/// Enclosed items changes, relative to the enclosed items count, triggering a full fit
+const double MAX_CHANGED_RATIO = 0.5;
+/// Inlier ratio drop, relative to the ratio of the last full fit, triggering a full fit
+const double MIN_INLIER_RATIO_FACTOR = 0.5;
+
+// _isEnclosed flags
+const char ENCLOSED = 1;
+const char NEWLY_ENCLOSED = 2;
+
+} // empty namespace
+
+MVGIncrementalPlaneEstimator::MVGIncrementalPlaneEstimator()
+    : _isValid(false)
+    , _isLineConstrained(false)
+    , _threshold(0.0)
+    , _inliersCount(0)
+    , _fullFitInlierRatio(0.0)
+    , _fullFitsCount(0)
+{
+}
+
+void MVGIncrementalPlaneEstimator::reset()
+{
+    _isValid = false;
+    _enclosedIndexes.clear();
+    _isEnclosed.clear();
+    _isInlier.clear();
+    _inliersCount = 0;
+    _fullFitsCount = 0;
+}
+
+bool MVGIncrementalPlaneEstimator::update(const std::vector<MVGPointCloudItem>& items,
+                                          const std::vector<int>& enclosedIndexes,
+                                          PlaneKernel::Model& model)
+{
+    if(_isLineConstrained)
+        _isValid = false;
+    _isLineConstrained = false;
+    if(!updateIncremental(items, enclosedIndexes) && !fullFit(items, enclosedIndexes))
+        return false;
+    model = _model;
+    return true;
+}
+
+bool MVGIncrementalPlaneEstimator::update(const std::vector<MVGPointCloudItem>& items,
+                                          const std::vector<int>& enclosedIndexes,
+                                          const MPointArray& constraintPoints,
+                                          LineConstrainedPlaneKernel::Model& model)
+{
+    if(constraintPoints.length() < 2)
+        return false;
+    const aliceVision::Vec3 constraintP0 = TO_VEC3(constraintPoints[0]);
+    const aliceVision::Vec3 constraintP1 = TO_VEC3(constraintPoints[1]);
+    if(!_isLineConstrained || constraintP0 != _constraintP0 || constraintP1 != _constraintP1)
+        _isValid = false;
+    _isLineConstrained = true;
+    _constraintP0 = constraintP0;
+    _constraintP1 = constraintP1;
+    if(!updateIncremental(items, enclosedIndexes) && !fullFit(items, enclosedIndexes))
+        return false;
+    model = _model;
+    return true;
+}
+
+/**
+ * @brief Apply the enclosed items changes to the inliers moments and refit the plane.
+ * @return false if a full fit is needed
+ */
+bool MVGIncrementalPlaneEstimator::updateIncremental(const std::vector<MVGPointCloudItem>& items,
+                                                     const std::vector<int>& enclosedIndexes)
+{
+    if(!_isValid || _isEnclosed.size() != items.size())
+        return false;
+
+    // flag the currently enclosed items
+    for(size_t i = 0; i < enclosedIndexes.size(); ++i)
+        _isEnclosed[enclosedIndexes[i]] |= NEWLY_ENCLOSED;
+    // remove the leaving items
+    int changedCount = 0;
+    for(size_t i = 0; i < _enclosedIndexes.size(); ++i)
+    {
+        const int index = _enclosedIndexes[i];
+        if(_isEnclosed[index] & NEWLY_ENCLOSED)
+            continue;
+        _isEnclosed[index] = 0;
+        ++changedCount;
+        if(!_isInlier[index])
+            continue;
+        _isInlier[index] = 0;
+        addMoments(items[index]._position, -1.0);
+        --_inliersCount;
+    }
+    // classify the enclosed items against the current plane: the entering ones, and the
+    // remaining ones again so that the refitted plane does not drift onto outliers
+    for(size_t i = 0; i < enclosedIndexes.size(); ++i)
+    {
+        const int index = enclosedIndexes[i];
+        if(_isEnclosed[index] == NEWLY_ENCLOSED)
+            ++changedCount;
+        _isEnclosed[index] = ENCLOSED;
+        const MPoint& position = items[index]._position;
+        const char isInlier = (getDistance(position) < _threshold) ? 1 : 0;
+        if(isInlier == _isInlier[index])
+            continue;
+        _isInlier[index] = isInlier;
+        addMoments(position, isInlier ? 1.0 : -1.0);
+        _inliersCount += isInlier ? 1 : -1;
+    }
+    _enclosedIndexes = enclosedIndexes;
+
+    if(enclosedIndexes.empty())
+        return false;
+    if(changedCount > MAX_CHANGED_RATIO * enclosedIndexes.size())
+        return false;
+    const double inlierRatio = (double)_inliersCount / enclosedIndexes.size();
+    if(inlierRatio < MIN_INLIER_RATIO_FACTOR * _fullFitInlierRatio)
+        return false;
+    return refit();
+}
+
+/**
+ * @brief Robust estimation from scratch, then inliers moments initialization.
+ * The robust model is the result: the moments are only used by the next incremental updates.
+ * @return false if no plane could be estimated
+ */
+bool MVGIncrementalPlaneEstimator::fullFit(const std::vector<MVGPointCloudItem>& items,
+                                           const std::vector<int>& enclosedIndexes)
+{
+    _isValid = false;
+    if(enclosedIndexes.size() < 3)
+        return false;
+    ++_fullFitsCount;
+
+    MPointArray enclosedWSPoints;
+    enclosedWSPoints.setLength(enclosedIndexes.size());
+    for(size_t i = 0; i < enclosedIndexes.size(); ++i)
+        enclosedWSPoints[i] = items[enclosedIndexes[i]]._position;
+    PlaneKernel::Model model;
+    if(_isLineConstrained)
+    {
+        MPointArray constraintPoints;
+        constraintPoints.append(TO_MPOINT(_constraintP0));
+        constraintPoints.append(TO_MPOINT(_constraintP1));
+        if(!MVGGeometryUtil::computePlaneWithLineConstraint(enclosedWSPoints, constraintPoints,
+                                                            _settings, model))
+            return false;
+    }
+    else if(!MVGGeometryUtil::computePlane(enclosedWSPoints, _settings, model))
+        return false;
+    _model = model;
+    // inlier threshold relative to the extent of the robust inliers, not of all the enclosed
+    // points: the outliers would inflate it
+    _threshold = _settings.ransacRelativeThreshold * getDiagonal(enclosedWSPoints, -1.0);
+    const double inliersDiagonal = getDiagonal(enclosedWSPoints, _threshold);
+    if(inliersDiagonal > 0.0)
+        _threshold = _settings.ransacRelativeThreshold * inliersDiagonal;
+
+    // inliers moments
+    _origin = _isLineConstrained ? _constraintP0 : TO_VEC3(enclosedWSPoints[0]);
+    _sum.setZero();
+    _sumOfSquares.setZero();
+    _inliersCount = 0;
+    _isEnclosed.assign(items.size(), 0);
+    _isInlier.assign(items.size(), 0);
+    for(size_t i = 0; i < enclosedIndexes.size(); ++i)
+    {
+        const int index = enclosedIndexes[i];
+        _isEnclosed[index] = ENCLOSED;
+        const MPoint& position = items[index]._position;
+        if(getDistance(position) >= _threshold)
+            continue;
+        _isInlier[index] = 1;
+        addMoments(position, 1.0);
+        ++_inliersCount;
+    }
+    _enclosedIndexes = enclosedIndexes;
+    _fullFitInlierRatio = (double)_inliersCount / enclosedIndexes.size();
+    _isValid = true;
+    return true;
+}
+
+double MVGIncrementalPlaneEstimator::getDistance(const MPoint& position) const
+{
+    return std::fabs(_model[0] * position.x + _model[1] * position.y + _model[2] * position.z +
+                     _model[3]);
+}
+
+/**
+ * @brief Bounding box diagonal of the points closer to the plane than maxDistance.
+ * @param[in] maxDistance negative to take all the points
+ */
+double MVGIncrementalPlaneEstimator::getDiagonal(const MPointArray& points,
+                                                 const double maxDistance) const
+{
+    bool isEmpty = true;
+    MPoint minPoint;
+    MPoint maxPoint;
+    for(unsigned int i = 0; i < points.length(); ++i)
+    {
+        const MPoint& position = points[i];
+        if(maxDistance >= 0.0 && getDistance(position) >= maxDistance)
+            continue;
+        if(isEmpty)
+        {
+            minPoint = maxPoint = position;
+            isEmpty = false;
+            continue;
+        }
+        minPoint.x = std::min(minPoint.x, position.x);
+        minPoint.y = std::min(minPoint.y, position.y);
+        minPoint.z = std::min(minPoint.z, position.z);
+        maxPoint.x = std::max(maxPoint.x, position.x);
+        maxPoint.y = std::max(maxPoint.y, position.y);
+        maxPoint.z = std::max(maxPoint.z, position.z);
+    }
+    return isEmpty ? 0.0 : (maxPoint - minPoint).length();
+}
+
+void MVGIncrementalPlaneEstimator::addMoments(const MPoint& position, const double sign)
+{
+    const aliceVision::Vec3 point = TO_VEC3(position) - _origin;
+    _sum += sign * point;
+    _sumOfSquares += sign * point * point.transpose();
+}
+
+/**
+ * @brief Least squares plane from the inliers moments, oriented like the previous one.
+ * @return false if there are not enough inliers
+ */
+bool MVGIncrementalPlaneEstimator::refit()
+{
+    aliceVision::Vec3 normal;
+    if(_isLineConstrained)
+    {
+        // the plane contains the line: search the normal in the plane orthogonal to it
+        const aliceVision::Vec3 line = _constraintP1 - _constraintP0;
+        if(_inliersCount < LineConstrainedPlaneKernel::MINIMUM_SAMPLES || line.norm() <= 0.0)
+            return false;
+        const aliceVision::Vec3 u = line.normalized().unitOrthogonal();
+        const aliceVision::Vec3 v = line.normalized().cross(u);
+        Eigen::Matrix<double, 3, 2> basis;
+        basis << u, v;
+        const Eigen::Matrix2d covariance = basis.transpose() * _sumOfSquares * basis;
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> solver(covariance);
+        if(solver.info() != Eigen::Success)
+            return false;
+        normal = basis * solver.eigenvectors().col(0);
+    }
+    else
+    {
+        if(_inliersCount < PlaneKernel::MINIMUM_SAMPLES)
+            return false;
+        const aliceVision::Vec3 mean = _sum / _inliersCount;
+        const aliceVision::Mat3 covariance =
+            _sumOfSquares / _inliersCount - mean * mean.transpose();
+        Eigen::SelfAdjointEigenSolver<aliceVision::Mat3> solver(covariance);
+        if(solver.info() != Eigen::Success)
+            return false;
+        normal = solver.eigenvectors().col(0);
+    }
+    if(normal.dot(_model.head<3>()) < 0.0)
+        normal = -normal;
+    // the plane goes through the inliers centroid (the line point when constrained)
+    const aliceVision::Vec3 center =
+        _isLineConstrained ? _origin : aliceVision::Vec3(_origin + _sum / _inliersCount);
+    _model.head<3>() = normal;
+    _model[3] = -1.0 * normal.dot(center);
+    return true;
+}
+
+} // namespace
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "meshroomMaya/core/MVGGeometryUtil.hpp"
+#include "meshroomMaya/core/MVGPlaneKernel.hpp"
+#include "meshroomMaya/core/MVGLineConstrainedPlaneKernel.hpp"
+#include "meshroomMaya/core/MVGPointCloudItem.hpp"
+#include <vector>
+
+class MPointArray;
+
+namespace meshroomMaya
+{
+
+/**
+ * @brief Plane estimation warm-started from the previous mouse event of a drag.
+ *
+ * Between two drag events, the face polygon only moves by a few pixels: most of the enclosed
+ * items stay the same. The estimator keeps the enclosed items, their inlier status and the
+ * first and second order moments of the inliers. On update, the enclosed items are classified
+ * against the current plane, the ones entering or leaving the inliers are added to or removed
+ * from the moments, and the plane is refitted in closed form from the moments.
+ * A full robust fit (MVGGeometryUtil::computePlane or computePlaneWithLineConstraint) is run on
+ * the first update after reset(), when the line constraint changes, when most of the enclosed
+ * items changed or when the inlier ratio collapses. Its robust model is returned as is: the
+ * moments refit is only used between two full fits.
+ */
+class MVGIncrementalPlaneEstimator
+{
+public:
+    MVGIncrementalPlaneEstimator();
+
+public:
+    /// Forget the previous estimation; to be called at the beginning of each drag
+    void reset();
+    /// Settings of the next full fits, instead of the MVGGeometryUtil static members
+    void setSettings(const MVGGeometryUtil::PlaneEstimationSettings& settings)
+    {
+        _settings = settings;
+    }
+    /**
+     * @brief Estimate the plane through the enclosed items.
+     * @param[in] items visible point cloud items
+     * @param[in] enclosedIndexes indexes, in items, of the items enclosed by the face polygon
+     * @param[out] model estimated plane
+     * @return false if there are not enough inliers
+     */
+    bool update(const std::vector<MVGPointCloudItem>& items,
+                const std::vector<int>& enclosedIndexes, PlaneKernel::Model& model);
+    /**
+     * @brief Estimate the plane through the enclosed items and containing the constraint line.
+     * @param[in] items visible point cloud items
+     * @param[in] enclosedIndexes indexes, in items, of the items enclosed by the face polygon
+     * @param[in] constraintPoints two world space points describing the constraint line
+     * @param[out] model estimated plane
+     * @return false if there are not enough inliers
+     */
+    bool update(const std::vector<MVGPointCloudItem>& items,
+                const std::vector<int>& enclosedIndexes, const MPointArray& constraintPoints,
+                LineConstrainedPlaneKernel::Model& model);
+
+public:
+    /// Number of full robust fits since the last reset
+    int getFullFitsCount() const { return _fullFitsCount; }
+
+private:
+    bool updateIncremental(const std::vector<MVGPointCloudItem>& items,
+                           const std::vector<int>& enclosedIndexes);
+    bool fullFit(const std::vector<MVGPointCloudItem>& items,
+                 const std::vector<int>& enclosedIndexes);
+    double getDistance(const MPoint& position) const;
+    double getDiagonal(const MPointArray& points, const double maxDistance) const;
+    void addMoments(const MPoint& position, const double sign);
+    bool refit();
+
+private:
+    MVGGeometryUtil::PlaneEstimationSettings _settings;
+    bool _isValid;
+    bool _isLineConstrained;
+    aliceVision::Vec3 _constraintP0;
+    aliceVision::Vec3 _constraintP1;
+    /// unaligned: the estimator is a member of manipulators allocated by Maya
+    Eigen::Matrix<double, 4, 1, Eigen::DontAlign> _model;
+    /// inlier threshold, relative to the extent of the inliers of the last full fit
+    double _threshold;
+    /// moments are computed relative to this origin to limit cancellation errors
+    aliceVision::Vec3 _origin;
+    aliceVision::Vec3 _sum;
+    aliceVision::Mat3 _sumOfSquares;
+    int _inliersCount;
+    double _fullFitInlierRatio;
+    std::vector<int> _enclosedIndexes;
+    std::vector<char> _isEnclosed;
+    std::vector<char> _isInlier;
+    int _fullFitsCount;
+};
+
+} // namespace
@@ -1,6 +1,8 @@
 #include "MVGLineConstrainedPlaneKernel.hpp"
 
 #include <aliceVision/robustEstimation/leastMedianOfSquares.hpp>
+#include <algorithm>
+#include <cmath>
 
 namespace meshroomMaya
 {
@@ -42,4 +44,174 @@ void LineConstrainedPlaneKernel::Fit(const std::vector<size_t>& samples, std::ve
     equation->push_back(m);
 }
 
+/**
+ * @brief Least squares plane containing the constraint line, through the given samples.
+ *
+ * The normal is searched in the plane orthogonal to the line: it is the eigenvector with the
+ * smallest eigenvalue of the 2D covariance of the samples expressed in that plane.
+ * It is oriented like the normal of the input equation, which is kept if the samples are
+ * degenerate.
+ */
+void LineConstrainedPlaneKernel::Refit(const std::vector<size_t>& samples, Model* equation) const
+{
+    assert(samples.size() >= MINIMUM_SAMPLES);
+    aliceVision::Vec3 u, v;
+    if(!getOrthogonalBasis(u, v))
+        return;
+    Eigen::Matrix2d covariance = Eigen::Matrix2d::Zero();
+    for(size_t i = 0; i < samples.size(); ++i)
+    {
+        const aliceVision::Vec3 p2p0 = _pt.col(samples[i]) - _constraintP0;
+        const Eigen::Vector2d q(u.dot(p2p0), v.dot(p2p0));
+        covariance += q * q.transpose();
+    }
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> solver(covariance);
+    if(solver.info() != Eigen::Success)
+        return;
+    // eigenvalues are sorted in increasing order
+    const Eigen::Vector2d coefficients = solver.eigenvectors().col(0);
+    aliceVision::Vec3 normal = coefficients(0) * u + coefficients(1) * v;
+    if(normal.dot(equation->head<3>()) < 0.0)
+        normal = -normal;
+    equation->head<3>() = normal;
+    (*equation)[3] = -1.0 * normal.dot(_constraintP0);
+}
+
+/**
+ * @brief Exact least median of squares plane containing the constraint line.
+ *
+ * Planes containing the line only depend on their rotation angle around it. In the plane
+ * orthogonal to the line, a sample at distance r from the line and lying on the plane of angle a
+ * has an error r * |sin(angle - a)|: it is below a threshold t on an interval of angles centered
+ * on a, of half width asin(t / r). For a given t, sorting the interval bounds and sweeping them
+ * gives the angle covered by the most samples; the smallest t for which half of the samples can be
+ * covered, found by bisection, is the least median error.
+ *
+ * @param[out] equation plane minimizing the median error
+ * @param[out] medianError median error of the returned plane (optional)
+ * @return false if the line or the samples are degenerate
+ */
+bool LineConstrainedPlaneKernel::FitLeastMedian(Model* equation, double* medianError) const
+{
+    const size_t samplesCount = NumSamples();
+    if(samplesCount < MINIMUM_SAMPLES)
+        return false;
+    aliceVision::Vec3 u, v;
+    if(!getOrthogonalBasis(u, v))
+        return false;
+
+    // angle of the plane going through each sample, in [0, pi[, and distance to the line
+    std::vector<double> angles(samplesCount);
+    std::vector<double> radii(samplesCount);
+    double maxRadius = 0.0;
+    for(size_t i = 0; i < samplesCount; ++i)
+    {
+        const aliceVision::Vec3 p2p0 = _pt.col(i) - _constraintP0;
+        const double x = u.dot(p2p0);
+        const double y = v.dot(p2p0);
+        // the plane normal is orthogonal to the sample direction
+        double angle = std::atan2(y, x) + M_PI / 2.0;
+        angle = std::fmod(angle, M_PI);
+        if(angle < 0.0)
+            angle += M_PI;
+        angles[i] = angle;
+        radii[i] = std::sqrt(x * x + y * y);
+        maxRadius = std::max(maxRadius, radii[i]);
+    }
+
+    // bisection on the median error
+    const int medianCount = static_cast<int>(samplesCount / 2 + 1);
+    double bestAngle = 0.0;
+    double low = 0.0;
+    double high = maxRadius;
+    getMaxCoverage(angles, radii, high, bestAngle);
+    for(int iteration = 0; iteration < 64 && (high - low) > 1e-9 * maxRadius; ++iteration)
+    {
+        const double threshold = 0.5 * (low + high);
+        double angle;
+        if(getMaxCoverage(angles, radii, threshold, angle) >= medianCount)
+        {
+            high = threshold;
+            bestAngle = angle;
+        }
+        else
+            low = threshold;
+    }
+
+    const aliceVision::Vec3 normal = std::cos(bestAngle) * u + std::sin(bestAngle) * v;
+    equation->head<3>() = normal;
+    (*equation)[3] = -1.0 * normal.dot(_constraintP0);
+    if(medianError)
+        *medianError = high;
+    return true;
+}
+
+bool LineConstrainedPlaneKernel::getOrthogonalBasis(aliceVision::Vec3& u,
+                                                    aliceVision::Vec3& v) const
+{
+    const double lineLength = _P1P0.norm();
+    if(lineLength <= 0.0)
+        return false;
+    // orthonormal basis (u, v) of the plane orthogonal to the line
+    const aliceVision::Vec3 direction = _P1P0 / lineLength;
+    u = direction.unitOrthogonal();
+    v = direction.cross(u);
+    return true;
+}
+
+/**
+ * @brief Sweep the angular intervals where the samples error is below the threshold.
+ *
+ * @param[in] angles angle of the plane going through each sample, in [0, pi[
+ * @param[in] radii distance of each sample to the constraint line
+ * @param[in] threshold maximum error of a covered sample
+ * @param[out] bestAngle angle covered by the most samples
+ * @return the number of samples covered at bestAngle
+ */
+int LineConstrainedPlaneKernel::getMaxCoverage(const std::vector<double>& angles,
+                                               const std::vector<double>& radii,
+                                               double threshold, double& bestAngle) const
+{
+    // (angle, +1) opens an interval, (angle, -1) closes it; opening first on ties
+    std::vector<std::pair<double, int> > events;
+    events.reserve(2 * angles.size());
+    int coverage = 0; // samples covered at angle 0
+    int alwaysCovered = 0;
+    for(size_t i = 0; i < angles.size(); ++i)
+    {
+        if(radii[i] <= threshold)
+        {
+            ++alwaysCovered;
+            continue;
+        }
+        const double halfWidth = std::asin(threshold / radii[i]);
+        double first = angles[i] - halfWidth;
+        double last = angles[i] + halfWidth;
+        if(first < 0.0)
+            first += M_PI;
+        if(last >= M_PI)
+            last -= M_PI;
+        if(first > last) // wraps around 0
+            ++coverage;
+        events.push_back(std::make_pair(first, -1));
+        events.push_back(std::make_pair(last, 1));
+    }
+    // sort opening events (-1 key) before closing ones (+1 key) at equal angles
+    std::sort(events.begin(), events.end());
+
+    int maxCoverage = coverage;
+    bestAngle = events.empty() ? 0.0 : 0.5 * events.front().first;
+    for(size_t e = 0; e < events.size(); ++e)
+    {
+        coverage -= events[e].second;
+        if(coverage > maxCoverage)
+        {
+            maxCoverage = coverage;
+            const double next = (e + 1 < events.size()) ? events[e + 1].first : M_PI;
+            bestAngle = 0.5 * (events[e].first + next);
+        }
+    }
+    return maxCoverage + alwaysCovered;
+}
+
 } // namespace
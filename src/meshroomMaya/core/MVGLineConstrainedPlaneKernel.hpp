@@ -2,6 +2,7 @@
 
 #include "MVGEigen.hpp"
 #include <maya/MPoint.h>
+#include <vector>
 
 namespace meshroomMaya
 {
@@ -18,6 +19,8 @@ struct LineConstrainedPlaneKernel
                                const aliceVision::Vec3& constraintP1);
     size_t NumSamples() const { return _pt.cols(); }
     void Fit(const std::vector<size_t>& samples, std::vector<Model>* equation) const;
+    void Refit(const std::vector<size_t>& samples, Model* equation) const;
+    bool FitLeastMedian(Model* equation, double* medianError = NULL) const;
     inline double Error(size_t sample, const Model& model) const
     {
         // Calculate the distance from the point to the plane normal as the dot
@@ -27,9 +30,14 @@ struct LineConstrainedPlaneKernel
         aliceVision::Vec4 pt4(pt3(0), pt3(1), pt3(2), 1.0);
         return fabs(model.dot(pt4));
     }
+    bool getOrthogonalBasis(aliceVision::Vec3& u, aliceVision::Vec3& v) const;
+    int getMaxCoverage(const std::vector<double>& angles, const std::vector<double>& radii,
+                       double threshold, double& bestAngle) const;
+
     const aliceVision::Mat& _pt;
-    const aliceVision::Vec3& _constraintP0;
-    const aliceVision::Vec3& _constraintP1;
+    // stored by value: callers usually pass temporaries
+    const aliceVision::Vec3 _constraintP0;
+    const aliceVision::Vec3 _constraintP1;
     const aliceVision::Vec3 _P1P0;
 };
 
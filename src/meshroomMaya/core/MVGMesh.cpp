@@ -1,6 +1,7 @@
 #include "meshroomMaya/core/MVGMesh.hpp"
 #include "meshroomMaya/core/MVGLog.hpp"
 #include "meshroomMaya/core/MVGProject.hpp"
+#include "meshroomMaya/core/MVGSceneRegistry.hpp"
 #include "meshroomMaya/maya/context/MVGContextCmd.hpp"
 #include "meshroomMaya/maya/context/MVGContext.hpp"
 #include "meshroomMaya/maya/cmd/MVGEditCmd.hpp"
@@ -11,13 +12,14 @@
 #include <maya/MItMeshPolygon.h>
 #include <maya/MItMeshVertex.h>
 #include <maya/MItMeshEdge.h>
-#include <maya/MItDag.h>
 #include <maya/MGlobal.h>
 #include <maya/MPointArray.h>
+#include <maya/MStringArray.h>
 #include <maya/MFloatPointArray.h>
 #include <maya/MFnNumericAttribute.h>
 #include <maya/MPlug.h>
 #include <maya/MArgList.h>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -27,12 +29,151 @@ namespace meshroomMaya
 namespace
 { // empty namespace
 
+/*
+ * Blind data layout of the observations of a vertex.
+ * Version 0: raw array of MVGMesh::ClickedCSPosition (24 bytes each, no header).
+ * Version 1: PackedHeaderV1 followed by PackedHeaderV1::count PackedObservation (12 bytes each).
+ * Version 2: PackedHeader followed by PackedHeader::count PackedObservation, the count is no
+ * longer limited to 65535.
+ * The older versions are still read; observations are always written with the current version,
+ * so scenes are migrated as their vertices are edited. Plugin builds reading version 0 only
+ * misread the migrated vertices: once edited, a scene must not be opened with them.
+ * The clicked positions are stored as floats: camera space coordinates are relative to the film
+ * width, so the rounding error stays far below a pixel for any image size.
+ */
+const unsigned int PACKED_MAGIC = 0x4F47564D; // "MVGO"
+const unsigned short PACKED_VERSION = 2;
+
+struct PackedHeaderV1
+{
+    unsigned int magic;
+    unsigned short version;
+    unsigned short count;
+};
+
+struct PackedHeader
+{
+    unsigned int magic;
+    unsigned short version;
+    unsigned short reserved;
+    unsigned int count;
+};
+
+struct PackedObservation
+{
+    int cameraId;
+    float x;
+    float y;
+};
+
+/**
+ * @brief Read the header of a packed blind data blob (version 1 or later).
+ * @param[out] count number of observations
+ * @param[out] headerSize offset of the first observation
+ * @return false if the blob is not packed, or is invalid
+ */
+bool readPackedHeader(const char* binaryData, const int binarySize, int& count, int& headerSize)
+{
+    PackedHeaderV1 headerV1;
+    if(binarySize < (int)sizeof(PackedHeaderV1))
+        return false;
+    memcpy(&headerV1, binaryData, sizeof(PackedHeaderV1));
+    if(headerV1.magic != PACKED_MAGIC)
+        return false;
+    if(headerV1.version == 1)
+    {
+        count = headerV1.count;
+        headerSize = sizeof(PackedHeaderV1);
+    }
+    else if(headerV1.version == PACKED_VERSION && binarySize >= (int)sizeof(PackedHeader))
+    {
+        PackedHeader header;
+        memcpy(&header, binaryData, sizeof(PackedHeader));
+        if(header.count > (unsigned int)(binarySize / sizeof(PackedObservation)))
+            return false;
+        count = static_cast<int>(header.count);
+        headerSize = sizeof(PackedHeader);
+    }
+    else
+        return false;
+    return binarySize == headerSize + count * (int)sizeof(PackedObservation);
+}
+
+/// Number of observations stored in a blind data blob, -1 if the layout is unknown
+int getObservationsCount(const char* binaryData, const int binarySize)
+{
+    int count = 0;
+    int headerSize = 0;
+    if(readPackedHeader(binaryData, binarySize, count, headerSize))
+        return count;
+    if(binarySize >= (int)sizeof(unsigned int))
+    {
+        unsigned int magic = 0;
+        memcpy(&magic, binaryData, sizeof(unsigned int));
+        if(magic == PACKED_MAGIC)
+            return -1;
+    }
+    // version 0
+    if(binarySize % sizeof(MVGMesh::ClickedCSPosition) != 0)
+        return -1;
+    return binarySize / sizeof(MVGMesh::ClickedCSPosition);
+}
+
+/**
+ * @brief Decode the observations of a blind data blob, in any supported version.
+ * @param[out] observations getObservationsCount(binaryData, binarySize) observations
+ */
+void unpackObservations(const char* binaryData, const int binarySize,
+                        MVGMesh::ClickedCSPosition* observations)
+{
+    int count = 0;
+    int headerSize = 0;
+    if(!readPackedHeader(binaryData, binarySize, count, headerSize))
+    {
+        count = getObservationsCount(binaryData, binarySize);
+        if(count > 0)
+            memcpy(observations, binaryData, binarySize);
+        return;
+    }
+    const char* record = binaryData + headerSize;
+    PackedObservation packed;
+    for(int i = 0; i < count; ++i, record += sizeof(PackedObservation))
+    {
+        memcpy(&packed, record, sizeof(PackedObservation));
+        observations[i].cameraId = packed.cameraId;
+        observations[i].x = packed.x;
+        observations[i].y = packed.y;
+    }
+}
+
 void binaryToVectorData(const char* binaryData, const int binarySize,
                         std::vector<MVGMesh::ClickedCSPosition>& vectorData)
 {
-    const size_t nbElements = size_t(binarySize / sizeof(MVGMesh::ClickedCSPosition));
-    vectorData.resize(nbElements);
-    memcpy(vectorData.data(), binaryData, binarySize);
+    vectorData.resize(std::max(0, getObservationsCount(binaryData, binarySize)));
+    if(!vectorData.empty())
+        unpackObservations(binaryData, binarySize, &vectorData[0]);
+}
+
+/// Encode observations with the current blind data layout
+void vectorDataToBinary(const std::vector<MVGMesh::ClickedCSPosition>& vectorData,
+                        std::vector<char>& binaryData)
+{
+    PackedHeader header;
+    header.magic = PACKED_MAGIC;
+    header.version = PACKED_VERSION;
+    header.reserved = 0;
+    header.count = static_cast<unsigned int>(vectorData.size());
+    binaryData.resize(sizeof(PackedHeader) + vectorData.size() * sizeof(PackedObservation));
+    memcpy(&binaryData[0], &header, sizeof(PackedHeader));
+    PackedObservation packed;
+    for(size_t i = 0; i < vectorData.size(); ++i)
+    {
+        packed.cameraId = vectorData[i].cameraId;
+        packed.x = static_cast<float>(vectorData[i].x);
+        packed.y = static_cast<float>(vectorData[i].y);
+        memcpy(&binaryData[sizeof(PackedHeader) + i * sizeof(PackedObservation)], &packed,
+               sizeof(PackedObservation));
+    }
 }
 
 } // empty namespace
@@ -114,15 +255,11 @@ MVGMesh MVGMesh::create(const std::string& name)
 std::vector<MVGMesh> MVGMesh::listActiveMeshes()
 {
     std::vector<MVGMesh> list;
-    MDagPath path;
-    MItDag it(MItDag::kDepthFirst, MFn::kMesh);
-    for(; !it.isDone(); it.next())
+    std::vector<MDagPath> paths;
+    MVGSceneRegistry::getMeshPaths(paths);
+    for(std::vector<MDagPath>::const_iterator it = paths.begin(); it != paths.end(); ++it)
     {
-        MFnDagNode fn(it.currentItem());
-        if(fn.isIntermediateObject())
-            continue;
-        fn.getPath(path);
-        MVGMesh mesh(path);
+        MVGMesh mesh(*it);
         if(mesh.isValid() && mesh.isActive())
             list.push_back(mesh);
     }
@@ -133,15 +270,11 @@ std::vector<MVGMesh> MVGMesh::listActiveMeshes()
 std::vector<MVGMesh> MVGMesh::listAllMeshes()
 {
     std::vector<MVGMesh> list;
-    MDagPath path;
-    MItDag it(MItDag::kDepthFirst, MFn::kMesh);
-    for(; !it.isDone(); it.next())
+    std::vector<MDagPath> paths;
+    MVGSceneRegistry::getMeshPaths(paths);
+    for(std::vector<MDagPath>::const_iterator it = paths.begin(); it != paths.end(); ++it)
     {
-        MFnDagNode fn(it.currentItem());
-        if(fn.isIntermediateObject())
-            continue;
-        fn.getPath(path);
-        MVGMesh mesh(path);
+        MVGMesh mesh(*it);
         if(mesh.isValid())
             list.push_back(mesh);
     }
@@ -367,8 +500,10 @@ MStatus MVGMesh::setBlindData(const int vertexId,
     MStatus status;
     MFnMesh fnMesh(_object, &status);
     CHECK_RETURN_STATUS(status);
-    char* charData = reinterpret_cast<char*>(clickedCSPositions.data());
-    const int binarySize = clickedCSPositions.size() * sizeof(ClickedCSPosition);
+    std::vector<char> binary;
+    vectorDataToBinary(clickedCSPositions, binary);
+    char* charData = &binary[0];
+    const int binarySize = static_cast<int>(binary.size());
     CHECK_RETURN_STATUS(
         fnMesh.setIntBlindData(vertexId, MFn::kMeshVertComponent, _blindDataID, "size", binarySize))
     CHECK_RETURN_STATUS(fnMesh.setBinaryBlindData(vertexId, MFn::kMeshVertComponent, _blindDataID,
@@ -415,16 +550,10 @@ MStatus MVGMesh::unsetAllBlindData() const
     MStatus status;
 
     // Get all vertices
-    MItMeshVertex vIt(_dagpath, MObject::kNullObj, &status);
-    vIt.updateSurface();
-    vIt.geomChanged();
-    MIntArray componentId;
-    while(!vIt.isDone())
-    {
-        const int index = vIt.index(&status);
-        componentId.append(index);
-        vIt.next();
-    }
+    const int verticesCount = getVerticesCount();
+    MIntArray componentId(verticesCount);
+    for(int index = 0; index < verticesCount; ++index)
+        componentId[index] = index;
     MVGEditCmd* cmd = new MVGEditCmd();
     if(cmd)
     {
@@ -510,4 +639,127 @@ MStatus MVGMesh::unsetBlindDataPerCamera(const int vertexId, const int cameraId)
     return status;
 }
 
+MStatus MVGMesh::getAllBlindData(std::vector<int>& offsets,
+                                 std::vector<ClickedCSPosition>& data) const
+{
+    MStatus status;
+    MFnMesh fnMesh(_object, &status);
+    CHECK_RETURN_STATUS(status);
+    const int verticesCount = fnMesh.numVertices();
+    offsets.assign(verticesCount + 1, 0);
+    data.clear();
+    if(!fnMesh.hasBlindData(MFn::kMeshVertComponent))
+        return status;
+    MIntArray vertexIds;
+    MStringArray binaryData;
+    CHECK_RETURN_STATUS(fnMesh.getBinaryBlindData(MFn::kMeshVertComponent, _blindDataID, "data",
+                                                  vertexIds, binaryData))
+    // vertices are not sorted: count, then copy at the vertex offsets
+    std::vector<int> binarySizes(vertexIds.length(), 0);
+    for(unsigned int i = 0; i < vertexIds.length(); ++i)
+    {
+        if(vertexIds[i] < 0 || vertexIds[i] >= verticesCount)
+            continue;
+        const char* binary = binaryData[i].asChar(binarySizes[i]);
+        offsets[vertexIds[i] + 1] = std::max(0, getObservationsCount(binary, binarySizes[i]));
+    }
+    for(int index = 0; index < verticesCount; ++index)
+        offsets[index + 1] += offsets[index];
+    data.resize(offsets[verticesCount]);
+    for(unsigned int i = 0; i < vertexIds.length(); ++i)
+    {
+        if(vertexIds[i] < 0 || vertexIds[i] >= verticesCount)
+            continue;
+        if(offsets[vertexIds[i] + 1] == offsets[vertexIds[i]])
+            continue;
+        unpackObservations(binaryData[i].asChar(binarySizes[i]), binarySizes[i],
+                           &data[offsets[vertexIds[i]]]);
+    }
+    return status;
+}
+
+MStatus MVGMesh::getBlindData(const MIntArray& vertexIds,
+                              std::vector<std::vector<ClickedCSPosition> >& data) const
+{
+    MStatus status;
+    std::vector<int> offsets;
+    std::vector<ClickedCSPosition> allData;
+    status = getAllBlindData(offsets, allData);
+    CHECK_RETURN_STATUS(status)
+    data.resize(vertexIds.length());
+    const int verticesCount = static_cast<int>(offsets.size()) - 1;
+    for(unsigned int i = 0; i < vertexIds.length(); ++i)
+    {
+        data[i].clear();
+        if(vertexIds[i] < 0 || vertexIds[i] >= verticesCount)
+            continue;
+        data[i].assign(allData.begin() + offsets[vertexIds[i]],
+                       allData.begin() + offsets[vertexIds[i] + 1]);
+    }
+    return status;
+}
+
+MStatus MVGMesh::setBlindData(const MIntArray& vertexIds,
+                              const std::vector<std::vector<ClickedCSPosition> >& data) const
+{
+    MStatus status;
+    assert(vertexIds.length() == data.size());
+    MFnMesh fnMesh(_object, &status);
+    CHECK_RETURN_STATUS(status);
+    MIntArray binarySizes(vertexIds.length());
+    MStringArray binaryData(vertexIds.length(), MString());
+    std::vector<char> binary;
+    for(unsigned int i = 0; i < vertexIds.length(); ++i)
+    {
+        vectorDataToBinary(data[i], binary);
+        binarySizes[i] = static_cast<int>(binary.size());
+        binaryData[i].set(&binary[0], binarySizes[i]);
+    }
+    CHECK_RETURN_STATUS(fnMesh.setIntBlindData(vertexIds, MFn::kMeshVertComponent, _blindDataID,
+                                               "size", binarySizes))
+    CHECK_RETURN_STATUS(fnMesh.setBinaryBlindData(vertexIds, MFn::kMeshVertComponent,
+                                                  _blindDataID, "data", binaryData))
+    return status;
+}
+
+MStatus MVGMesh::unsetBlindData(const MIntArray& vertexIds) const
+{
+    MStatus status;
+    std::vector<std::vector<ClickedCSPosition> > data(vertexIds.length());
+    status = setBlindData(vertexIds, data);
+    CHECK(status)
+    return status;
+}
+
+MStatus MVGMesh::setBlindDataPerCamera(const MIntArray& vertexIds, const int cameraId,
+                                       const MPointArray& points2D) const
+{
+    MStatus status;
+    assert(vertexIds.length() == points2D.length());
+    std::vector<std::vector<ClickedCSPosition> > data;
+    status = getBlindData(vertexIds, data);
+    CHECK_RETURN_STATUS(status)
+    for(unsigned int i = 0; i < vertexIds.length(); ++i)
+    {
+        std::vector<ClickedCSPosition>::iterator it = data[i].begin();
+        for(; it != data[i].end(); ++it)
+        {
+            if(it->cameraId == cameraId)
+                break;
+        }
+        if(it == data[i].end())
+        {
+            ClickedCSPosition newData;
+            newData.cameraId = cameraId;
+            data[i].push_back(newData);
+            it = data[i].end() - 1;
+        }
+        it->x = points2D[i].x;
+        it->y = points2D[i].y;
+    }
+    status = setBlindData(vertexIds, data);
+    CHECK(status)
+    return status;
+}
+
 } // namespace
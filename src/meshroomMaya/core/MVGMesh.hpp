@@ -61,6 +61,22 @@ public:
                                   const MPoint& point2D) const;
     MStatus unsetBlindDataPerCamera(const int vertexId, const int cameraId) const;
 
+public:
+    // bulk blind data access, with one Maya call per blind data attribute
+    /**
+     * @brief Read the blind data of all the vertices.
+     * @param[out] offsets blind data of the vertex v are in [offsets[v], offsets[v + 1])
+     * @param[out] data blind data of all the vertices
+     */
+    MStatus getAllBlindData(std::vector<int>& offsets, std::vector<ClickedCSPosition>& data) const;
+    MStatus getBlindData(const MIntArray& vertexIds,
+                         std::vector<std::vector<ClickedCSPosition> >& data) const;
+    MStatus setBlindData(const MIntArray& vertexIds,
+                         const std::vector<std::vector<ClickedCSPosition> >& data) const;
+    MStatus unsetBlindData(const MIntArray& vertexIds) const;
+    MStatus setBlindDataPerCamera(const MIntArray& vertexIds, const int cameraId,
+                                  const MPointArray& points2D) const;
+
 private:
     static int _blindDataID;
     static MString _MVG;
@@ -35,5 +35,36 @@ void PlaneKernel::Fit(const std::vector<size_t>& samples, std::vector<Model>* eq
     equation->push_back(m);
 }
 
+/**
+ * @brief Least squares plane through the given samples.
+ *
+ * The normal is the eigenvector of the samples covariance with the smallest eigenvalue.
+ * It is oriented like the normal of the input equation, which is kept if the samples are
+ * degenerate.
+ */
+void PlaneKernel::Refit(const std::vector<size_t>& samples, Model* equation) const
+{
+    assert(samples.size() >= MINIMUM_SAMPLES);
+    aliceVision::Vec3 centroid = aliceVision::Vec3::Zero();
+    for(size_t i = 0; i < samples.size(); ++i)
+        centroid += _pt.col(samples[i]);
+    centroid /= (double)samples.size();
+    aliceVision::Mat3 covariance = aliceVision::Mat3::Zero();
+    for(size_t i = 0; i < samples.size(); ++i)
+    {
+        const aliceVision::Vec3 centered = _pt.col(samples[i]) - centroid;
+        covariance += centered * centered.transpose();
+    }
+    Eigen::SelfAdjointEigenSolver<aliceVision::Mat3> solver(covariance);
+    if(solver.info() != Eigen::Success)
+        return;
+    // eigenvalues are sorted in increasing order
+    aliceVision::Vec3 normal = solver.eigenvectors().col(0);
+    if(normal.dot(equation->head<3>()) < 0.0)
+        normal = -normal;
+    equation->head<3>() = normal;
+    (*equation)[3] = -1.0 * normal.dot(centroid);
+}
+
 
 } // namespace
@@ -20,6 +20,7 @@ struct PlaneKernel
     size_t NumSamples() const { return _pt.cols(); }
     
     void Fit(const std::vector<size_t>& samples, std::vector<Model>* equation) const;
+    void Refit(const std::vector<size_t>& samples, Model* equation) const;
     
     inline double Error(size_t sample, const Model& model) const
     {
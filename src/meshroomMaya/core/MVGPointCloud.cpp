@@ -4,6 +4,9 @@
 #include "meshroomMaya/core/MVGProject.hpp"
 #include "meshroomMaya/core/MVGGeometryUtil.hpp"
 #include "meshroomMaya/core/MVGPlaneKernel.hpp"
+#include "meshroomMaya/core/MVGPointCloudCache.hpp"
+#include "meshroomMaya/core/MVGPointCloudGrid.hpp"
+#include "meshroomMaya/core/MVGIncrementalPlaneEstimator.hpp"
 #include "meshroomMaya/maya/MVGMayaUtil.hpp"
 #include <maya/M3dView.h>
 #include <maya/MFnParticleSystem.h>
@@ -17,51 +20,11 @@
 #include <maya/MPlug.h>
 #include <maya/MMatrix.h>
 #include <stdexcept>
+#include <algorithm>
 
 namespace meshroomMaya
 {
 
-namespace
-{ // empty namespace
-
-int isLeft(const MPoint& P0, const MPoint& P1, const MPoint& P2)
-{
-    // isLeft(): tests if a point is Left|On|Right of an infinite line.
-    //    Input:  three points P0, P1, and P2
-    //    Return: >0 for P2 left of the line through P0 and P1
-    //            =0 for P2  on the line
-    //            <0 for P2  right of the line
-    //    See: Algorithm 1 "Area of Triangles and Polygons"
-    return (int)((P1.x - P0.x) * (P2.y - P0.y) - (P2.x - P0.x) * (P1.y - P0.y));
-}
-
-int wn_PnPoly(const MPoint& P, const MPointArray& V)
-{
-    // wn_PnPoly(): winding number test for a point in a polygon
-    //      Input:   P = a point,
-    //               V[] = vertex points of a polygon V[n+1] with V[n]=V[0]
-    //      Return:  wn = the winding number (=0 only when P is outside)
-    int wn = 0;
-    for(int i = 0; i < V.length() - 1; i++)
-    {
-        if(V[i].y <= P.y)
-        {
-            if(V[i + 1].y > P.y)
-                if(isLeft(V[i], V[i + 1], P) > 0)
-                    ++wn;
-        }
-        else
-        {
-            if(V[i + 1].y <= P.y)
-                if(isLeft(V[i], V[i + 1], P) < 0)
-                    --wn;
-        }
-    }
-    return wn;
-}
-
-} // empty namespace
-
 MVGPointCloud::MVGPointCloud(const std::string& name)
     : MVGNodeWrapper(name)
 {
@@ -83,89 +46,91 @@ bool MVGPointCloud::isValid() const
 
 MStatus MVGPointCloud::getItems(std::vector<MVGPointCloudItem>& items) const
 {
-    MStatus status;
+    MStatus status = MVGPointCloudCache::update(_dagpath);
     items.clear();
-    MFnParticleSystem fnParticle(_dagpath, &status);
     CHECK_RETURN_STATUS(status)
-    MVectorArray positionArray;
-    fnParticle.position(positionArray);
-    items.resize(positionArray.length());
-    for(int i = 0; i < positionArray.length(); ++i)
-    {
-        MVGPointCloudItem& item = items[i];
-        item._id = i;
-        item._position = positionArray[i];
-    }
+    MVGPointCloudCache::getItems(items);
     return status;
 }
 
+int MVGPointCloud::getItemsCount() const
+{
+    MStatus status;
+    MFnParticleSystem fn(_dagpath, &status);
+    CHECK_RETURN_VARIABLE(status, 0)
+    return (int)fn.count();
+}
+
 MStatus MVGPointCloud::getItems(std::vector<MVGPointCloudItem>& items,
                                 const MIntArray& indexes) const
 {
-    MStatus status;
+    MStatus status = MVGPointCloudCache::update(_dagpath);
     items.clear();
-    items.reserve(indexes.length());
-    MFnParticleSystem fnParticle(_dagpath, &status);
     CHECK_RETURN_STATUS(status)
-    MVectorArray positionArray;
-    fnParticle.position(positionArray);
-    for(int i = 0; i < indexes.length(); ++i)
-    {
-        MVGPointCloudItem item;
-        item._id = indexes[i];
-        item._position = positionArray[indexes[i]];
-        items.push_back(item);
-    }
+    MVGPointCloudCache::getItems(items, indexes);
     return status;
 }
 
 /**
  *
- * @param[in] view
+ * @param[in] projection : viewing parameters of the active view
  * @param[in] visibleItems : pointcloud items visible for the current camera
+ * @param[in,out] visibleItemsGrid : view space grid over visibleItems, rebuilt if outdated
+ * @param[in,out] planeEstimator : plane estimation state of the current drag
  * @param[in] faceCSPoints : points describing the face in camera space coordinates
  * @param[out] faceWSPoints : faceCSPoints projected on computed plane in world space
  *coordinates
  * @return
  */
-bool MVGPointCloud::projectPoints(M3dView& view, const std::vector<MVGPointCloudItem>& visibleItems,
+bool MVGPointCloud::projectPoints(const MVGProjectionSnapshot& projection,
+                                  const std::vector<MVGPointCloudItem>& visibleItems,
+                                  MVGPointCloudGrid& visibleItemsGrid,
+                                  MVGIncrementalPlaneEstimator& planeEstimator,
                                   const MPointArray& faceCSPoints, MPointArray& faceWSPoints)
 {
     if(!isValid())
         return false;
+    return projectPointsOnItems(projection, visibleItems, visibleItemsGrid, planeEstimator,
+                                faceCSPoints, faceWSPoints);
+}
+
+// static
+bool MVGPointCloud::projectPointsOnItems(const MVGProjectionSnapshot& projection,
+                                         const std::vector<MVGPointCloudItem>& visibleItems,
+                                         MVGPointCloudGrid& visibleItemsGrid,
+                                         MVGIncrementalPlaneEstimator& planeEstimator,
+                                         const MPointArray& faceCSPoints,
+                                         MPointArray& faceWSPoints)
+{
     if(faceCSPoints.length() < 3)
         return false;
     if(visibleItems.size() < 3)
         return false;
 
-    MPointArray closedVSPolygon(MVGGeometryUtil::cameraToViewSpace(view, faceCSPoints));
+    MPointArray closedVSPolygon(MVGGeometryUtil::cameraToViewSpace(projection, faceCSPoints));
     closedVSPolygon.append(closedVSPolygon[0]); // add an extra point (to describe a closed shape)
 
     // get enclosed items in pointcloud
-    MPointArray enclosedWSPoints;
-    std::vector<MVGPointCloudItem>::const_iterator it = visibleItems.begin();
-    int windingNumber = 0;
-    for(; it != visibleItems.end(); ++it)
-    {
-        windingNumber =
-            wn_PnPoly(MVGGeometryUtil::worldToViewSpace(view, it->_position), closedVSPolygon);
-        if(windingNumber != 0)
-            enclosedWSPoints.append(it->_position);
-    }
-    if(enclosedWSPoints.length() < 3)
+    visibleItemsGrid.update(projection, visibleItems);
+    std::vector<int> enclosedIndexes;
+    getEnclosedItems(visibleItemsGrid, closedVSPolygon, enclosedIndexes);
+    if(enclosedIndexes.size() < 3)
         return false;
 
-    // Compute plane
+    // Compute plane, from the previous one if any
     PlaneKernel::Model model;
-    MVGGeometryUtil::computePlane(enclosedWSPoints, model);
+    if(!planeEstimator.update(visibleItems, enclosedIndexes, model))
+        return false;
     // Project points
-    return MVGGeometryUtil::projectPointsOnPlane(view, faceCSPoints, model, faceWSPoints);
+    return MVGGeometryUtil::projectPointsOnPlane(projection, faceCSPoints, model, faceWSPoints);
 }
 
 /**
  *
- * @param[in] view
+ * @param[in] projection : viewing parameters of the active view
  * @param[in] visibleItems : pointcloud items visible for the current camera
+ * @param[in,out] visibleItemsGrid : view space grid over visibleItems, rebuilt if outdated
+ * @param[in,out] planeEstimator : plane estimation state of the current drag
  * @param[in] faceCSPoints : points describing the face in camera space coordinates
  * @param[in] constraintedWSPoints : points describing the line constraint in world space
  *coordinates
@@ -174,12 +139,26 @@ bool MVGPointCloud::projectPoints(M3dView& view, const std::vector<MVGPointCloud
  * @return
  */
 bool MVGPointCloud::projectPointsWithLineConstraint(
-    M3dView& view, const std::vector<MVGPointCloudItem>& visibleItems,
+    const MVGProjectionSnapshot& projection, const std::vector<MVGPointCloudItem>& visibleItems,
+    MVGPointCloudGrid& visibleItemsGrid, MVGIncrementalPlaneEstimator& planeEstimator,
     const MPointArray& faceCSPoints, const MPointArray& constraintedWSPoints,
     const MPoint& mouseCSPoint, MPoint& projectedWSMouse)
 {
     if(!isValid())
         return false;
+    return projectPointOnItemsWithLineConstraint(projection, visibleItems, visibleItemsGrid,
+                                                 planeEstimator, faceCSPoints,
+                                                 constraintedWSPoints, mouseCSPoint,
+                                                 projectedWSMouse);
+}
+
+// static
+bool MVGPointCloud::projectPointOnItemsWithLineConstraint(
+    const MVGProjectionSnapshot& projection, const std::vector<MVGPointCloudItem>& visibleItems,
+    MVGPointCloudGrid& visibleItemsGrid, MVGIncrementalPlaneEstimator& planeEstimator,
+    const MPointArray& faceCSPoints, const MPointArray& constraintedWSPoints,
+    const MPoint& mouseCSPoint, MPoint& projectedWSMouse)
+{
     if(faceCSPoints.length() < 3)
         return false;
     if(visibleItems.size() < 3)
@@ -187,28 +166,66 @@ bool MVGPointCloud::projectPointsWithLineConstraint(
     if(constraintedWSPoints.length() < 2)
         return false;
 
-    MPointArray closedVSPolygon(MVGGeometryUtil::cameraToViewSpace(view, faceCSPoints));
+    MPointArray closedVSPolygon(MVGGeometryUtil::cameraToViewSpace(projection, faceCSPoints));
     closedVSPolygon.append(closedVSPolygon[0]); // add an extra point (to describe a closed shape)
 
     // get enclosed items in pointcloud
-    MPointArray enclosedWSPoints;
-    std::vector<MVGPointCloudItem>::const_iterator it = visibleItems.begin();
-    int windingNumber = 0;
-    for(; it != visibleItems.end(); ++it)
-    {
-        windingNumber =
-            wn_PnPoly(MVGGeometryUtil::worldToViewSpace(view, it->_position), closedVSPolygon);
-        if(windingNumber != 0)
-            enclosedWSPoints.append(it->_position);
-    }
-    if(enclosedWSPoints.length() < 3)
+    visibleItemsGrid.update(projection, visibleItems);
+    std::vector<int> enclosedIndexes;
+    getEnclosedItems(visibleItemsGrid, closedVSPolygon, enclosedIndexes);
+    if(enclosedIndexes.size() < 3)
         return false;
 
+    // Compute plane, from the previous one if any
     LineConstrainedPlaneKernel::Model model;
-    MVGGeometryUtil::computePlaneWithLineConstraint(enclosedWSPoints, constraintedWSPoints, model);
+    if(!planeEstimator.update(visibleItems, enclosedIndexes, constraintedWSPoints, model))
+        return false;
 
     // Project the mouse point
-    return MVGGeometryUtil::projectPointOnPlane(view, mouseCSPoint, model, projectedWSMouse);
+    return MVGGeometryUtil::projectPointOnPlane(projection, mouseCSPoint, model, projectedWSMouse);
+}
+
+/**
+ *
+ * @param[in] visibleItemsGrid : up to date view space grid over the visible items
+ * @param[in] closedVSPolygon : closed polygon in view space coordinates
+ * @param[out] enclosedIndexes : indexes, in the visible items, of the items enclosed by the
+ *polygon
+ */
+// static
+void MVGPointCloud::getEnclosedItems(const MVGPointCloudGrid& visibleItemsGrid,
+                                     const MPointArray& closedVSPolygon,
+                                     std::vector<int>& enclosedIndexes)
+{
+    // only visit the cells overlapping the polygon bounding box
+    MPoint minVSPoint = closedVSPolygon[0];
+    MPoint maxVSPoint = closedVSPolygon[0];
+    for(int i = 1; i < closedVSPolygon.length(); ++i)
+    {
+        minVSPoint.x = std::min(minVSPoint.x, closedVSPolygon[i].x);
+        minVSPoint.y = std::min(minVSPoint.y, closedVSPolygon[i].y);
+        maxVSPoint.x = std::max(maxVSPoint.x, closedVSPolygon[i].x);
+        maxVSPoint.y = std::max(maxVSPoint.y, closedVSPolygon[i].y);
+    }
+    std::vector<MVGPointCloudGrid::SlotRange> ranges;
+    visibleItemsGrid.getCandidateRanges(minVSPoint, maxVSPoint, ranges);
+
+    std::vector<int> windingNumbers;
+    for(size_t r = 0; r < ranges.size(); ++r)
+    {
+        const int first = ranges[r].first;
+        const int count = ranges[r].second - first;
+        windingNumbers.resize(count);
+        MVGGeometryUtil::computeWindingNumbers(closedVSPolygon,
+                                               visibleItemsGrid.getXArray() + first,
+                                               visibleItemsGrid.getYArray() + first, count,
+                                               &windingNumbers[0]);
+        for(int i = 0; i < count; ++i)
+        {
+            if(windingNumbers[i] != 0)
+                enclosedIndexes.push_back(visibleItemsGrid.getItemIndex(first + i));
+        }
+    }
 }
 
 MStatus MVGPointCloud::setOpacity(double value)
@@ -6,12 +6,14 @@
 
 class MIntArray;
 class MPointArray;
-class M3dView;
 class MDoubleArray;
 namespace meshroomMaya
 {
 
 class MVGCamera;
+class MVGIncrementalPlaneEstimator;
+class MVGPointCloudGrid;
+class MVGProjectionSnapshot;
 class MVGPointCloudItem;
 
 class MVGPointCloud : public MVGNodeWrapper
@@ -27,15 +29,38 @@ public:
 
 public:
     MStatus getItems(std::vector<MVGPointCloudItem>& items) const;
+    /// Number of particles, without reading them
+    int getItemsCount() const;
     MStatus getItems(std::vector<MVGPointCloudItem>& items, const MIntArray& indexes) const;
-    bool projectPoints(M3dView& view, const std::vector<MVGPointCloudItem>& visibleItems,
+    bool projectPoints(const MVGProjectionSnapshot& projection,
+                       const std::vector<MVGPointCloudItem>& visibleItems,
+                       MVGPointCloudGrid& visibleItemsGrid,
+                       MVGIncrementalPlaneEstimator& planeEstimator,
                        const MPointArray& faceCSPoints, MPointArray& faceWSPoints);
-    bool projectPointsWithLineConstraint(M3dView& view,
+    bool projectPointsWithLineConstraint(const MVGProjectionSnapshot& projection,
                                          const std::vector<MVGPointCloudItem>& visibleItems,
+                                         MVGPointCloudGrid& visibleItemsGrid,
+                                         MVGIncrementalPlaneEstimator& planeEstimator,
                                          const MPointArray& faceCSPoints,
                                          const MPointArray& constraintedWSPoints,
                                          const MPoint& mouseCSPoint, MPoint& projectedWSMouse);
 
+public:
+    /// projectPoints without accessing the point cloud node: may run on a worker thread
+    static bool projectPointsOnItems(const MVGProjectionSnapshot& projection,
+                                     const std::vector<MVGPointCloudItem>& visibleItems,
+                                     MVGPointCloudGrid& visibleItemsGrid,
+                                     MVGIncrementalPlaneEstimator& planeEstimator,
+                                     const MPointArray& faceCSPoints, MPointArray& faceWSPoints);
+    /// projectPointsWithLineConstraint without accessing the point cloud node
+    static bool projectPointOnItemsWithLineConstraint(
+        const MVGProjectionSnapshot& projection, const std::vector<MVGPointCloudItem>& visibleItems,
+        MVGPointCloudGrid& visibleItemsGrid, MVGIncrementalPlaneEstimator& planeEstimator,
+        const MPointArray& faceCSPoints, const MPointArray& constraintedWSPoints,
+        const MPoint& mouseCSPoint, MPoint& projectedWSMouse);
+
+public:
+
     MStatus setOpacity(double value);
     MStatus setOpacity(const MIntArray& indices, double value);
 
@@ -44,6 +69,9 @@ protected:
     MStatus setOpacityPPAttribute(MDoubleArray& values);
 private:
     MStatus ensureOpacityPPAttribute();
+    static void getEnclosedItems(const MVGPointCloudGrid& visibleItemsGrid,
+                                 const MPointArray& closedVSPolygon,
+                                 std::vector<int>& enclosedIndexes);
 
 };
 
@@ -0,0 +1,142 @@
+#include "meshroomMaya/core/MVGPointCloudCache.hpp"
+#include "meshroomMaya/core/MVGPointCloudItem.hpp"
+#include "meshroomMaya/core/MVGLog.hpp"
+#include <maya/MFnAttribute.h>
+#include <maya/MFnParticleSystem.h>
+#include <maya/MMessage.h>
+#include <maya/MNodeMessage.h>
+#include <maya/MPlug.h>
+#include <maya/MVectorArray.h>
+
+namespace meshroomMaya
+{
+
+std::vector<float> MVGPointCloudCache::_x;
+std::vector<float> MVGPointCloudCache::_y;
+std::vector<float> MVGPointCloudCache::_z;
+MObjectHandle MVGPointCloudCache::_node;
+MCallbackIdArray MVGPointCloudCache::_callbacks;
+bool MVGPointCloudCache::_isValid = false;
+
+MVGPointCloudCache::IndexedView::IndexedView(const MIntArray& indexes)
+    : _x(MVGPointCloudCache::getX())
+    , _y(MVGPointCloudCache::getY())
+    , _z(MVGPointCloudCache::getZ())
+    , _indexes(indexes)
+{
+}
+
+// static
+MStatus MVGPointCloudCache::update(const MDagPath& particlePath)
+{
+    MStatus status;
+    MObject node = particlePath.node(&status);
+    CHECK_RETURN_STATUS(status)
+    const bool sameNode = _node.isValid() && (_node.object() == node);
+    if(_isValid && sameNode)
+        return status;
+
+    // Watch the new node
+    if(!sameNode)
+    {
+        removeCallbacks();
+        _node = MObjectHandle(node);
+        MCallbackId id =
+            MNodeMessage::addNodeDirtyPlugCallback(node, nodeDirtyPlugCB, NULL, &status);
+        if(status)
+            _callbacks.append(id);
+        id = MNodeMessage::addNodePreRemovalCallback(node, nodePreRemovalCB, NULL, &status);
+        if(status)
+            _callbacks.append(id);
+    }
+
+    MFnParticleSystem fnParticle(particlePath, &status);
+    CHECK_RETURN_STATUS(status)
+    MVectorArray positionArray;
+    fnParticle.position(positionArray);
+    const unsigned int count = positionArray.length();
+    _x.resize(count);
+    _y.resize(count);
+    _z.resize(count);
+    for(unsigned int i = 0; i < count; ++i)
+    {
+        const MVector& position = positionArray[i];
+        _x[i] = static_cast<float>(position.x);
+        _y[i] = static_cast<float>(position.y);
+        _z[i] = static_cast<float>(position.z);
+    }
+    _isValid = true;
+    return status;
+}
+
+// static
+void MVGPointCloudCache::invalidate()
+{
+    _isValid = false;
+}
+
+// static
+void MVGPointCloudCache::clear()
+{
+    removeCallbacks();
+    _node = MObjectHandle();
+    _isValid = false;
+    std::vector<float>().swap(_x);
+    std::vector<float>().swap(_y);
+    std::vector<float>().swap(_z);
+}
+
+// static
+void MVGPointCloudCache::getItems(std::vector<MVGPointCloudItem>& items)
+{
+    const unsigned int count = size();
+    items.resize(count);
+    for(unsigned int i = 0; i < count; ++i)
+    {
+        MVGPointCloudItem& item = items[i];
+        item._id = i;
+        item._position = MPoint(_x[i], _y[i], _z[i]);
+    }
+}
+
+// static
+void MVGPointCloudCache::getItems(std::vector<MVGPointCloudItem>& items, const MIntArray& indexes)
+{
+    const IndexedView view(indexes);
+    items.resize(view.length());
+    for(unsigned int i = 0; i < view.length(); ++i)
+    {
+        MVGPointCloudItem& item = items[i];
+        item._id = view.getId(i);
+        item._position = view.getPosition(i);
+    }
+}
+
+// static
+void MVGPointCloudCache::removeCallbacks()
+{
+    if(_callbacks.length() == 0)
+        return;
+    CHECK(MMessage::removeCallbacks(_callbacks))
+    _callbacks.clear();
+}
+
+// static
+void MVGPointCloudCache::nodeDirtyPlugCB(MObject& node, MPlug& plug, void*)
+{
+    // Opacity updates also dirty the particle shape: only watch positions
+    MFnAttribute fnAttribute(plug.attribute());
+    const MString attributeName = fnAttribute.name();
+    if(attributeName == "position" || attributeName == "count")
+        invalidate();
+}
+
+// static
+void MVGPointCloudCache::nodePreRemovalCB(MObject& node, void*)
+{
+    // Callbacks can't be removed from within themselves; they will be in the next update()
+    _node = MObjectHandle();
+    invalidate();
+}
+
+} // namespace
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <maya/MCallbackIdArray.h>
+#include <maya/MDagPath.h>
+#include <maya/MIntArray.h>
+#include <maya/MObjectHandle.h>
+#include <maya/MPoint.h>
+#include <vector>
+
+class MPlug;
+
+namespace meshroomMaya
+{
+
+class MVGPointCloudItem;
+
+/**
+ * @brief Process-wide structure-of-arrays copy of the point cloud positions.
+ *
+ * Positions are read once from the particle shape and stored in contiguous x/y/z arrays.
+ * The copy stays valid until the particle positions are dirtied, the shape is deleted or a new
+ * scene is opened; it is then lazily refilled by the next call to update().
+ */
+class MVGPointCloudCache
+{
+public:
+    /**
+     * @brief Read-only view on a subset of the cache, addressed through an index array.
+     *
+     * No position is copied: the view only references the cache arrays and the indexes, which
+     * must both outlive it.
+     */
+    class IndexedView
+    {
+    public:
+        IndexedView(const MIntArray& indexes);
+
+    public:
+        unsigned int length() const { return _indexes.length(); }
+        int getId(const unsigned int i) const { return _indexes[i]; }
+        float getX(const unsigned int i) const { return _x[_indexes[i]]; }
+        float getY(const unsigned int i) const { return _y[_indexes[i]]; }
+        float getZ(const unsigned int i) const { return _z[_indexes[i]]; }
+        MPoint getPosition(const unsigned int i) const
+        {
+            const int index = _indexes[i];
+            return MPoint(_x[index], _y[index], _z[index]);
+        }
+
+    private:
+        const float* _x;
+        const float* _y;
+        const float* _z;
+        const MIntArray& _indexes;
+    };
+
+public:
+    /**
+     * @brief Fill the cache from the given particle shape, if not already up to date.
+     * @param[in] particlePath dag path to the point cloud particle shape
+     */
+    static MStatus update(const MDagPath& particlePath);
+    /// Mark the cached positions as outdated; the memory is kept for the next refill.
+    static void invalidate();
+    /// Release the cached positions and remove the node callbacks.
+    static void clear();
+
+public:
+    static bool isValid() { return _isValid; }
+    static unsigned int size() { return static_cast<unsigned int>(_x.size()); }
+    static const float* getX() { return _x.empty() ? NULL : &_x[0]; }
+    static const float* getY() { return _y.empty() ? NULL : &_y[0]; }
+    static const float* getZ() { return _z.empty() ? NULL : &_z[0]; }
+    static MPoint getPosition(const int index) { return MPoint(_x[index], _y[index], _z[index]); }
+
+public:
+    static void getItems(std::vector<MVGPointCloudItem>& items);
+    static void getItems(std::vector<MVGPointCloudItem>& items, const MIntArray& indexes);
+
+private:
+    static void removeCallbacks();
+    static void nodeDirtyPlugCB(MObject& node, MPlug& plug, void*);
+    static void nodePreRemovalCB(MObject& node, void*);
+
+private:
+    static std::vector<float> _x;
+    static std::vector<float> _y;
+    static std::vector<float> _z;
+    static MObjectHandle _node;
+    static MCallbackIdArray _callbacks;
+    static bool _isValid;
+};
+
+} // namespace
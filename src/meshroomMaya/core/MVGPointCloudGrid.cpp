@@ -0,0 +1,159 @@
+#include "meshroomMaya/core/MVGPointCloudGrid.hpp"
+#include "meshroomMaya/core/MVGProjectionSnapshot.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace meshroomMaya
+{
+
+namespace
+{ // empty namespace
+
+/// Average number of items per cell
+const double ITEMS_PER_CELL = 8.0;
+/// Maximum number of cells along one axis
+const int MAX_CELLS_PER_AXIS = 512;
+
+} // empty namespace
+
+MVGPointCloudGrid::MVGPointCloudGrid()
+    : _zoom(0.0)
+    , _horizontalPan(0.0)
+    , _verticalPan(0.0)
+    , _horizontalFilmAperture(0.0)
+    , _portWidth(0.0)
+    , _portHeight(0.0)
+    , _itemsCount(0)
+    , _isValid(false)
+    , _columns(0)
+    , _rows(0)
+    , _cellWidth(1.0)
+    , _cellHeight(1.0)
+{
+}
+
+void MVGPointCloudGrid::update(const MVGProjectionSnapshot& projection,
+                               const std::vector<MVGPointCloudItem>& items)
+{
+    if(!isUpToDate(projection, items))
+        build(projection, items);
+}
+
+void MVGPointCloudGrid::build(const MVGProjectionSnapshot& projection,
+                              const std::vector<MVGPointCloudItem>& items)
+{
+    _cameraPath = projection.getCameraPath();
+    _zoom = projection.getZoom();
+    _horizontalPan = projection.getHorizontalPan();
+    _verticalPan = projection.getVerticalPan();
+    _horizontalFilmAperture = projection.getHorizontalFilmAperture();
+    _portWidth = std::max(projection.getPortWidth(), 1.0);
+    _portHeight = std::max(projection.getPortHeight(), 1.0);
+    _itemsCount = items.size();
+
+    // grid resolution: square-ish cells holding ITEMS_PER_CELL items on average
+    const double cellsCount = std::max(1.0, items.size() / ITEMS_PER_CELL);
+    const double columns = std::sqrt(cellsCount * _portWidth / _portHeight);
+    _columns = std::min(std::max(1, static_cast<int>(columns)), MAX_CELLS_PER_AXIS);
+    _rows = std::min(std::max(1, static_cast<int>(cellsCount / _columns)), MAX_CELLS_PER_AXIS);
+    _cellWidth = _portWidth / _columns;
+    _cellHeight = _portHeight / _rows;
+
+    // project items and count them per cell
+    const int itemsCount = static_cast<int>(items.size());
+    std::vector<double> itemX(itemsCount);
+    std::vector<double> itemY(itemsCount);
+    std::vector<int> itemCell(itemsCount);
+    _cellStart.assign(_columns * _rows + 1, 0);
+    MPoint itemVSPoint;
+    for(int i = 0; i < itemsCount; ++i)
+    {
+        projection.worldToView(items[i]._position, itemVSPoint);
+        itemX[i] = itemVSPoint.x;
+        itemY[i] = itemVSPoint.y;
+        itemCell[i] = getRow(itemVSPoint.y) * _columns + getColumn(itemVSPoint.x);
+        ++_cellStart[itemCell[i] + 1];
+    }
+    for(size_t cell = 1; cell < _cellStart.size(); ++cell)
+        _cellStart[cell] += _cellStart[cell - 1];
+
+    // counting sort by cell
+    std::vector<int> cellFill(_cellStart.begin(), _cellStart.end() - 1);
+    _itemIndexes.resize(itemsCount);
+    _x.resize(itemsCount);
+    _y.resize(itemsCount);
+    for(int i = 0; i < itemsCount; ++i)
+    {
+        const int slot = cellFill[itemCell[i]]++;
+        _itemIndexes[slot] = i;
+        _x[slot] = itemX[i];
+        _y[slot] = itemY[i];
+    }
+    _isValid = true;
+}
+
+void MVGPointCloudGrid::clear()
+{
+    _isValid = false;
+    _cameraPath = MDagPath();
+    _itemsCount = 0;
+    _cellStart.clear();
+    _itemIndexes.clear();
+    _x.clear();
+    _y.clear();
+}
+
+bool MVGPointCloudGrid::isUpToDate(const MVGProjectionSnapshot& projection,
+                                   const std::vector<MVGPointCloudItem>& items) const
+{
+    return _isValid && _itemsCount == items.size() &&
+           _cameraPath == projection.getCameraPath() && _zoom == projection.getZoom() &&
+           _horizontalPan == projection.getHorizontalPan() &&
+           _verticalPan == projection.getVerticalPan() &&
+           _horizontalFilmAperture == projection.getHorizontalFilmAperture() &&
+           _portWidth == std::max(projection.getPortWidth(), 1.0) &&
+           _portHeight == std::max(projection.getPortHeight(), 1.0);
+}
+
+void MVGPointCloudGrid::getCandidateRanges(const MPoint& minVSPoint, const MPoint& maxVSPoint,
+                                           std::vector<SlotRange>& ranges) const
+{
+    ranges.clear();
+    if(!_isValid || _itemIndexes.empty())
+        return;
+    const int firstColumn = getColumn(minVSPoint.x);
+    const int lastColumn = getColumn(maxVSPoint.x);
+    const int firstRow = getRow(minVSPoint.y);
+    const int lastRow = getRow(maxVSPoint.y);
+    // cells are stored row by row: the overlapped cells of one row are contiguous
+    for(int row = firstRow; row <= lastRow; ++row)
+    {
+        const int first = _cellStart[row * _columns + firstColumn];
+        const int last = _cellStart[row * _columns + lastColumn + 1];
+        if(first != last)
+            ranges.push_back(SlotRange(first, last));
+    }
+}
+
+int MVGPointCloudGrid::getColumn(const double x) const
+{
+    // items outside of the port fall into the border cells
+    const double column = std::floor(x / _cellWidth);
+    if(!(column > 0.0)) // also catches NaN
+        return 0;
+    if(column >= _columns)
+        return _columns - 1;
+    return static_cast<int>(column);
+}
+
+int MVGPointCloudGrid::getRow(const double y) const
+{
+    const double row = std::floor(y / _cellHeight);
+    if(!(row > 0.0))
+        return 0;
+    if(row >= _rows)
+        return _rows - 1;
+    return static_cast<int>(row);
+}
+
+} // namespace
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "meshroomMaya/core/MVGPointCloudItem.hpp"
+#include <maya/MDagPath.h>
+#include <utility>
+#include <vector>
+
+namespace meshroomMaya
+{
+
+class MVGProjectionSnapshot;
+
+/**
+ * @brief Uniform 2D grid over the view space projections of the visible point cloud items.
+ *
+ * Items are bucketed row by row over the port area (items projected outside of it fall into the
+ * border cells), so that enclosure queries only have to test the items lying in the cells
+ * overlapping the polygon bounding box.
+ * The grid only depends on the camera, its zoom/pan and the port size: it is rebuilt by update()
+ * when one of them changes, or after clear().
+ */
+class MVGPointCloudGrid
+{
+public:
+    typedef std::pair<int, int> SlotRange; ///< [first, last[ range of sorted slots
+
+public:
+    MVGPointCloudGrid();
+
+public:
+    /**
+     * @brief Rebuild the grid if the viewing parameters changed since the last build.
+     * @param[in] projection viewing parameters of the active view
+     * @param[in] items visible point cloud items, with world space positions
+     */
+    void update(const MVGProjectionSnapshot& projection,
+                const std::vector<MVGPointCloudItem>& items);
+    void build(const MVGProjectionSnapshot& projection,
+               const std::vector<MVGPointCloudItem>& items);
+    void clear();
+    bool isUpToDate(const MVGProjectionSnapshot& projection,
+                    const std::vector<MVGPointCloudItem>& items) const;
+
+public:
+    /**
+     * @brief Get the slot ranges of the cells overlapping a view space bounding box.
+     * @param[in] minVSPoint lower corner of the bounding box
+     * @param[in] maxVSPoint upper corner of the bounding box
+     * @param[out] ranges one range of sorted slots per overlapped row
+     */
+    void getCandidateRanges(const MPoint& minVSPoint, const MPoint& maxVSPoint,
+                            std::vector<SlotRange>& ranges) const;
+    /// View space x coordinate of the item stored in the given slot
+    double getX(const int slot) const { return _x[slot]; }
+    /// View space y coordinate of the item stored in the given slot
+    double getY(const int slot) const { return _y[slot]; }
+    /// View space x coordinates of all slots, contiguous within a range
+    const double* getXArray() const { return _x.empty() ? NULL : &_x[0]; }
+    /// View space y coordinates of all slots, contiguous within a range
+    const double* getYArray() const { return _y.empty() ? NULL : &_y[0]; }
+    /// Index, in the items vector, of the item stored in the given slot
+    int getItemIndex(const int slot) const { return _itemIndexes[slot]; }
+    /// Number of slots, cell after cell
+    int getSlotsCount() const { return (int)_itemIndexes.size(); }
+
+private:
+    int getColumn(const double x) const;
+    int getRow(const double y) const;
+
+private:
+    // viewing parameters the grid was built for
+    MDagPath _cameraPath;
+    double _zoom;
+    double _horizontalPan;
+    double _verticalPan;
+    double _horizontalFilmAperture;
+    double _portWidth;
+    double _portHeight;
+    size_t _itemsCount;
+    bool _isValid;
+    // grid
+    int _columns;
+    int _rows;
+    double _cellWidth;
+    double _cellHeight;
+    std::vector<int> _cellStart;   ///< first slot of each cell, plus the end slot
+    std::vector<int> _itemIndexes; ///< item indexes sorted by cell
+    std::vector<double> _x;        ///< view space x coordinates sorted by cell
+    std::vector<double> _y;        ///< view space y coordinates sorted by cell
+};
+
+} // namespace
@@ -2,6 +2,7 @@
 #include "meshroomMaya/core/MVGCamera.hpp"
 #include "meshroomMaya/core/MVGMesh.hpp"
 #include "meshroomMaya/core/MVGLog.hpp"
+#include "meshroomMaya/core/MVGSceneRegistry.hpp"
 #include "meshroomMaya/maya/context/MVGContextCmd.hpp"
 #include "meshroomMaya/maya/MVGMayaUtil.hpp"
 
@@ -111,13 +112,11 @@ bool MVGProject::isValid() const
 std::vector<MVGProject> MVGProject::list()
 {
     std::vector<MVGProject> list;
-    MDagPath path;
-    MItDependencyNodes it(MFn::kTransform);
-    for(; !it.isDone(); it.next())
+    std::vector<MDagPath> paths;
+    MVGSceneRegistry::getTransformPaths(paths);
+    for(std::vector<MDagPath>::const_iterator it = paths.begin(); it != paths.end(); ++it)
     {
-        MFnDependencyNode fn(it.thisNode());
-        MDagPath::getAPathTo(fn.object(), path);
-        MVGProject project(path);
+        MVGProject project(*it);
         if(project.isValid())
             list.push_back(project);
     }
@@ -126,15 +125,14 @@ std::vector<MVGProject> MVGProject::list()
 
 std::vector<MObject> MVGProject::getMVGCameraSets()
 {
+    std::vector<MObject> allSets;
+    MVGSceneRegistry::getSets(allSets);
     std::vector<MObject> sets;
-    MItDependencyNodes setsIt(MFn::kSet);
-    MObject node;
-    // Iterate over all sets and find the ones created by MeshroomMaya
-    for (; !setsIt.isDone(); setsIt.next())
+    // Find the sets created by MeshroomMaya
+    for(std::vector<MObject>::const_iterator it = allSets.begin(); it != allSets.end(); ++it)
     {
-        node = setsIt.thisNode();
-        if(isMVGCameraSet(node))
-            sets.push_back(node);
+        if(isMVGCameraSet(*it))
+            sets.push_back(*it);
     }
     return sets;
 }
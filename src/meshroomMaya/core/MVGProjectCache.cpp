@@ -0,0 +1,232 @@
+#include "meshroomMaya/core/MVGProjectCache.hpp"
+#include "meshroomMaya/core/MVGLog.hpp"
+#include <QByteArray>
+#include <QFile>
+#include <QSaveFile>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace meshroomMaya
+{
+
+namespace
+{ // empty namespace
+
+const char MAGIC[8] = {'M', 'V', 'G', 'C', 'A', 'C', 'H', 'E'};
+/// To increment on any change of the file layout
+const unsigned int VERSION = 3;
+/// Bytes hashed at the start and at the end of the SfM file, which hold its header and layout
+const qint64 SOURCE_SAMPLE_SIZE = 1 << 20;
+
+struct Header
+{
+    char magic[8];
+    unsigned int version;
+    int camerasCount;
+    int pointsCount;
+    int observationsCount;
+    /// SfM file the cache was written for: size and hash of its sampled content
+    long long sourceSize;
+    unsigned long long sourceHash;
+    /// FNV-1a hash of everything after the header
+    unsigned long long contentHash;
+};
+
+const unsigned long long HASH_SEED = 14695981039346656037ULL;
+
+unsigned long long hashBytes(const void* data, const size_t size, unsigned long long hash)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for(size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Hash the SfM file: all of it if small, its first and last bytes otherwise.
+ * The modification time is not used, so that the cache survives a copy of the project.
+ */
+bool hashSource(const QString& sourcePath, long long& size, unsigned long long& hash)
+{
+    QFile file(sourcePath);
+    if(!file.open(QIODevice::ReadOnly))
+        return false;
+    size = file.size();
+    hash = hashBytes(&size, sizeof(size), HASH_SEED);
+    const qint64 headSize = (size <= 2 * SOURCE_SAMPLE_SIZE) ? size : SOURCE_SAMPLE_SIZE;
+    QByteArray bytes = file.read(headSize);
+    if(bytes.size() != headSize)
+        return false;
+    hash = hashBytes(bytes.constData(), bytes.size(), hash);
+    if(size <= 2 * SOURCE_SAMPLE_SIZE)
+        return true;
+    if(!file.seek(size - SOURCE_SAMPLE_SIZE))
+        return false;
+    bytes = file.read(SOURCE_SAMPLE_SIZE);
+    if(bytes.size() != SOURCE_SAMPLE_SIZE)
+        return false;
+    hash = hashBytes(bytes.constData(), bytes.size(), hash);
+    return true;
+}
+
+/// Size of the visibility rows, in bytes
+long long getContentSize(const Header& header)
+{
+    const long long intsCount = 2LL * header.camerasCount + header.pointsCount +
+                                2LL * header.observationsCount + 2;
+    return intsCount * (long long)sizeof(int);
+}
+
+} // empty namespace
+
+MVGProjectCache::MVGProjectCache()
+    : _file(NULL)
+    , _data(NULL)
+{
+    close();
+}
+
+MVGProjectCache::~MVGProjectCache()
+{
+    close();
+}
+
+// static
+std::string MVGProjectCache::getPath(const std::string& projectPath)
+{
+    return projectPath + ".mvgcache";
+}
+
+bool MVGProjectCache::open(const std::string& projectPath, const std::vector<int>& viewIds,
+                           const int pointsCount)
+{
+    close();
+    long long sourceSize = 0;
+    unsigned long long sourceHash = 0;
+    if(!hashSource(QString::fromStdString(projectPath), sourceSize, sourceHash))
+        return false;
+    _file = new QFile(QString::fromStdString(getPath(projectPath)));
+    if(!_file->open(QIODevice::ReadOnly))
+    {
+        close();
+        return false;
+    }
+    const qint64 fileSize = _file->size();
+    if(fileSize >= (qint64)sizeof(Header))
+        _data = _file->map(0, fileSize);
+
+    // Check the cache against its header and the SfM file
+    const Header* header = reinterpret_cast<const Header*>(_data);
+    const char* error = NULL;
+    if(!header)
+        error = "unreadable file";
+    else if(std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION)
+        error = "unknown format";
+    else if(header->sourceSize != sourceSize || header->sourceHash != sourceHash)
+        error = "SfM file modified";
+    else if(header->camerasCount < 0 || header->pointsCount < 0 ||
+            header->observationsCount < 0 ||
+            fileSize != (qint64)sizeof(Header) + getContentSize(*header))
+        error = "truncated file";
+    else if(hashBytes(_data + sizeof(Header), fileSize - sizeof(Header), HASH_SEED) !=
+            header->contentHash)
+        error = "corrupted file";
+    // the scene may have been edited since the import: points and cameras must still exist
+    else if(header->pointsCount > pointsCount)
+        error = "points deleted from the scene";
+    else
+    {
+        const int* cameraViewIds = reinterpret_cast<const int*>(_data + sizeof(Header));
+        if(!std::includes(viewIds.begin(), viewIds.end(), cameraViewIds,
+                          cameraViewIds + header->camerasCount))
+            error = "cameras deleted from the scene";
+    }
+    if(error)
+    {
+        LOG_INFO("Ignore project cache " << getPath(projectPath) << ": " << error)
+        close();
+        return false;
+    }
+
+    // Sections
+    const int* ints = reinterpret_cast<const int*>(_data + sizeof(Header));
+    _rows.camerasCount = header->camerasCount;
+    _rows.pointsCount = header->pointsCount;
+    _rows.observationsCount = header->observationsCount;
+    _rows.cameraViewIds = ints;
+    _rows.pointOffsets = _rows.cameraViewIds + _rows.camerasCount;
+    _rows.pointCameras = _rows.pointOffsets + _rows.pointsCount + 1;
+    _rows.cameraOffsets = _rows.pointCameras + _rows.observationsCount;
+    _rows.cameraPoints = _rows.cameraOffsets + _rows.camerasCount + 1;
+    return true;
+}
+
+bool MVGProjectCache::write(const std::string& projectPath, const MVGVisibilityIndex& visibility)
+{
+    close();
+    long long sourceSize = 0;
+    unsigned long long sourceHash = 0;
+    if(!hashSource(QString::fromStdString(projectPath), sourceSize, sourceHash))
+        return false;
+    const MVGVisibilityIndex::Rows& rows = visibility.getRows();
+
+    Header header;
+    std::memset(&header, 0, sizeof(Header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.camerasCount = rows.camerasCount;
+    header.pointsCount = rows.pointsCount;
+    header.observationsCount = rows.observationsCount;
+    header.sourceSize = sourceSize;
+    header.sourceHash = sourceHash;
+
+    // Sections, in the order read by open()
+    std::vector<std::pair<const void*, size_t> > sections;
+    sections.push_back(std::make_pair(rows.cameraViewIds, rows.camerasCount * sizeof(int)));
+    sections.push_back(std::make_pair(rows.pointOffsets, (rows.pointsCount + 1) * sizeof(int)));
+    sections.push_back(std::make_pair(rows.pointCameras, rows.observationsCount * sizeof(int)));
+    sections.push_back(std::make_pair(rows.cameraOffsets, (rows.camerasCount + 1) * sizeof(int)));
+    sections.push_back(std::make_pair(rows.cameraPoints, rows.observationsCount * sizeof(int)));
+    header.contentHash = HASH_SEED;
+    for(size_t i = 0; i < sections.size(); ++i)
+        header.contentHash = hashBytes(sections[i].first, sections[i].second, header.contentHash);
+
+    // Replace the previous file only once the new one is complete
+    const std::string path = getPath(projectPath);
+    QSaveFile file(QString::fromStdString(path));
+    if(file.open(QIODevice::WriteOnly))
+    {
+        file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        for(size_t i = 0; i < sections.size(); ++i)
+        {
+            if(sections[i].second > 0)
+                file.write(static_cast<const char*>(sections[i].first), sections[i].second);
+        }
+    }
+    if(!file.commit())
+    {
+        LOG_WARNING("Unable to write project cache " << path)
+        return false;
+    }
+    return true;
+}
+
+void MVGProjectCache::close()
+{
+    if(_file)
+    {
+        if(_data)
+            _file->unmap(_data);
+        delete _file;
+    }
+    _file = NULL;
+    _data = NULL;
+    std::memset(&_rows, 0, sizeof(_rows));
+}
+
+} // namespace
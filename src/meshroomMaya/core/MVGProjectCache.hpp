@@ -0,0 +1,67 @@
+#pragma once
+
+#include "meshroomMaya/core/MVGVisibilityIndex.hpp"
+#include <string>
+#include <vector>
+
+class QFile;
+
+namespace meshroomMaya
+{
+
+/**
+ * @brief Versioned binary sidecar of a project, written next to its SfM file (mvgProjectPath).
+ *
+ * It stores what reopening a project would otherwise rebuild from the Maya scene: the rows of
+ * the visibility index, whose view ids are the camera table. The point cloud positions are not
+ * stored: the particles can be edited in the scene without touching the SfM file, and
+ * MVGPointCloudCache reads them lazily.
+ * The file starts with a header (magic, version, size and hash of the SfM file, counts, hash of
+ * the content), followed by the arrays in native byte order. The SfM file is hashed on its first
+ * and last megabyte, which hold the header and the layout of the SfM formats.
+ * On reopen, the file is memory-mapped and checked against its header, the SfM file and the
+ * cameras and points of the scene: the visibility index then uses the mapped rows directly.
+ */
+class MVGProjectCache
+{
+public:
+    MVGProjectCache();
+    ~MVGProjectCache();
+
+public:
+    static std::string getPath(const std::string& projectPath);
+
+public:
+    /**
+     * @brief Map the sidecar of the project if it is up to date.
+     * @param[in] projectPath SfM file of the project
+     * @param[in] viewIds view ids of the cameras of the scene, in increasing order
+     * @param[in] pointsCount number of particles of the point cloud
+     * @return false if there is no valid sidecar, nothing is mapped then
+     */
+    bool open(const std::string& projectPath, const std::vector<int>& viewIds,
+              const int pointsCount);
+    /**
+     * @brief Write the sidecar of the project, the current one is unmapped first.
+     * @param[in] visibility visibility index, must not use the rows of this cache
+     */
+    bool write(const std::string& projectPath, const MVGVisibilityIndex& visibility);
+    void close();
+
+public:
+    bool isOpen() const { return _data != NULL; }
+    /// Mapped rows of the visibility index, valid until close()
+    const MVGVisibilityIndex::Rows& getVisibilityRows() const { return _rows; }
+
+private:
+    /// Not copyable: owns the mapping
+    MVGProjectCache(const MVGProjectCache&);
+    MVGProjectCache& operator=(const MVGProjectCache&);
+
+private:
+    QFile* _file;
+    unsigned char* _data;
+    MVGVisibilityIndex::Rows _rows;
+};
+
+} // namespace
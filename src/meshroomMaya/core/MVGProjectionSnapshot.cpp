@@ -0,0 +1,86 @@
+#include "meshroomMaya/core/MVGProjectionSnapshot.hpp"
+#include "meshroomMaya/core/MVGLog.hpp"
+#include <maya/M3dView.h>
+#include <maya/MFnCamera.h>
+
+namespace meshroomMaya
+{
+
+MVGProjectionSnapshot::MVGProjectionSnapshot(M3dView& view)
+    : _viewportWidth(0.0)
+    , _viewportHeight(0.0)
+    , _portWidth((double)view.portWidth())
+    , _portHeight((double)view.portHeight())
+    , _zoom(1.0)
+    , _horizontalPan(0.0)
+    , _verticalPan(0.0)
+    , _horizontalFilmAperture(1.0)
+    , _cameraScale(1.0)
+{
+    MStatus status;
+    // matrices
+    MMatrix modelViewMatrix, projectionMatrix;
+    CHECK(view.modelViewMatrix(modelViewMatrix))
+    CHECK(view.projectionMatrix(projectionMatrix))
+    _projection = projectionMatrix;
+    _worldToClip = modelViewMatrix * projectionMatrix;
+    _clipToWorld = _worldToClip.inverse();
+    // viewport
+    unsigned int viewportX, viewportY, viewportWidth, viewportHeight;
+    view.viewport(viewportX, viewportY, viewportWidth, viewportHeight);
+    _viewportWidth = static_cast<double>(viewportWidth);
+    _viewportHeight = static_cast<double>(viewportHeight);
+    // camera
+    CHECK(view.getCamera(_cameraPath))
+    MFnCamera fnCamera(_cameraPath, &status);
+    CHECK_RETURN(status)
+    _cameraCenter = fnCamera.eyePoint(MSpace::kWorld);
+    _zoom = fnCamera.zoom();
+    _horizontalPan = fnCamera.horizontalPan();
+    _verticalPan = fnCamera.verticalPan();
+    _horizontalFilmAperture = fnCamera.horizontalFilmAperture();
+    _cameraScale = _horizontalFilmAperture * _zoom;
+}
+
+MVGProjectionSnapshot::MVGProjectionSnapshot(const MVGProjectionSnapshot& viewSnapshot,
+                                             const MDagPath& cameraPath)
+    : _cameraPath(cameraPath)
+    , _cameraCenter(viewSnapshot._cameraCenter)
+    , _projection(viewSnapshot._projection)
+    , _worldToClip(viewSnapshot._worldToClip)
+    , _clipToWorld(viewSnapshot._clipToWorld)
+    , _viewportWidth(viewSnapshot._viewportWidth)
+    , _viewportHeight(viewSnapshot._viewportHeight)
+    , _portWidth(viewSnapshot._portWidth)
+    , _portHeight(viewSnapshot._portHeight)
+    , _zoom(viewSnapshot._zoom)
+    , _horizontalPan(viewSnapshot._horizontalPan)
+    , _verticalPan(viewSnapshot._verticalPan)
+    , _horizontalFilmAperture(viewSnapshot._horizontalFilmAperture)
+    , _cameraScale(viewSnapshot._cameraScale)
+{
+    MStatus status;
+    MFnCamera fnCamera(cameraPath, &status);
+    CHECK_RETURN(status)
+    _cameraCenter = fnCamera.eyePoint(MSpace::kWorld);
+    // the model view matrix of a camera view is the inverse of the camera world matrix
+    _worldToClip = cameraPath.inclusiveMatrixInverse() * _projection;
+    _clipToWorld = _worldToClip.inverse();
+}
+
+bool MVGProjectionSnapshot::hasSameFilmProjection(const MDagPath& cameraPath) const
+{
+    MStatus status;
+    MFnCamera fnCamera(_cameraPath, &status);
+    CHECK_RETURN_VARIABLE(status, false)
+    MFnCamera fnOtherCamera(cameraPath, &status);
+    CHECK_RETURN_VARIABLE(status, false)
+    return fnCamera.focalLength() == fnOtherCamera.focalLength() &&
+           fnCamera.horizontalFilmAperture() == fnOtherCamera.horizontalFilmAperture() &&
+           fnCamera.verticalFilmAperture() == fnOtherCamera.verticalFilmAperture() &&
+           fnCamera.horizontalFilmOffset() == fnOtherCamera.horizontalFilmOffset() &&
+           fnCamera.verticalFilmOffset() == fnOtherCamera.verticalFilmOffset() &&
+           fnCamera.filmFit() == fnOtherCamera.filmFit();
+}
+
+} // namespace
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <maya/MDagPath.h>
+#include <maya/MMatrix.h>
+#include <maya/MPoint.h>
+
+#include <cmath>
+
+class M3dView;
+
+namespace meshroomMaya
+{
+
+/**
+ * @brief Immutable copy of the viewing parameters of a view.
+ *
+ * Captured once per mouse event (or draw call), it holds everything needed to convert points
+ * between view, camera and world spaces without querying Maya again: the camera, its center,
+ * zoom, pan and film aperture, the model-view-projection matrix and the viewport size.
+ * The conversions are inlined so that the array overloads of MVGGeometryUtil run as tight loops.
+ */
+class MVGProjectionSnapshot
+{
+public:
+    explicit MVGProjectionSnapshot(M3dView& view);
+    /**
+     * @brief Viewing parameters of the same view, looking through another camera.
+     * The projection, zoom and pan of the view are kept: the camera is expected to have the
+     * same film projection (see hasSameFilmProjection()) as the camera of the view.
+     */
+    MVGProjectionSnapshot(const MVGProjectionSnapshot& viewSnapshot, const MDagPath& cameraPath);
+
+public:
+    const MDagPath& getCameraPath() const { return _cameraPath; }
+    const MPoint& getCameraCenter() const { return _cameraCenter; }
+    double getPortWidth() const { return _portWidth; }
+    double getPortHeight() const { return _portHeight; }
+    double getZoom() const { return _zoom; }
+    double getHorizontalPan() const { return _horizontalPan; }
+    double getVerticalPan() const { return _verticalPan; }
+    double getHorizontalFilmAperture() const { return _horizontalFilmAperture; }
+
+public:
+    /// Whether the camera has the focal, film aperture, fit and offset of the snapshot camera
+    bool hasSameFilmProjection(const MDagPath& cameraPath) const;
+
+public:
+    inline void viewToCamera(const MPoint& viewPoint, MPoint& cameraPoint) const;
+    inline void cameraToView(const MPoint& cameraPoint, MPoint& viewPoint) const;
+    inline void worldToView(const MPoint& worldPoint, MPoint& viewPoint) const;
+    inline void viewToWorld(const MPoint& viewPoint, MPoint& worldPoint) const;
+    inline void worldToCamera(const MPoint& worldPoint, MPoint& cameraPoint) const;
+    inline void cameraToWorld(const MPoint& cameraPoint, MPoint& worldPoint) const;
+
+private:
+    MDagPath _cameraPath;
+    MPoint _cameraCenter;
+    MMatrix _projection;
+    /// model view * projection
+    MMatrix _worldToClip;
+    /// (model view * projection)^-1
+    MMatrix _clipToWorld;
+    double _viewportWidth;
+    double _viewportHeight;
+    double _portWidth;
+    double _portHeight;
+    double _zoom;
+    double _horizontalPan;
+    double _verticalPan;
+    double _horizontalFilmAperture;
+    /// horizontal film aperture * zoom
+    double _cameraScale;
+};
+
+void MVGProjectionSnapshot::viewToCamera(const MPoint& viewPoint, MPoint& cameraPoint) const
+{
+    // center
+    const double x = (viewPoint.x / _portWidth) - 0.5;
+    const double y = (viewPoint.y / _portWidth) - 0.5 - 0.5 * (_portHeight / _portWidth - 1.0);
+    // zoom & pan
+    cameraPoint.x = x * _cameraScale + _horizontalPan;
+    cameraPoint.y = y * _cameraScale + _verticalPan;
+    cameraPoint.z = 0.0;
+    cameraPoint.w = 1.0;
+}
+
+void MVGProjectionSnapshot::cameraToView(const MPoint& cameraPoint, MPoint& viewPoint) const
+{
+    // pan & zoom
+    const float x = (float)((float)cameraPoint.x - _horizontalPan) / _cameraScale;
+    const float y = (float)((float)cameraPoint.y - _verticalPan) / _cameraScale;
+    // center
+    viewPoint.x = round((x + 0.5) * _portWidth);
+    viewPoint.y = round((y + 0.5 + 0.5 * (_portHeight / _portWidth - 1.0)) * _portWidth);
+}
+
+void MVGProjectionSnapshot::worldToView(const MPoint& worldPoint, MPoint& viewPoint) const
+{
+    // don't use M3dView::worldToView() because of the cast to short values
+    const MPoint point = worldPoint * _worldToClip;
+    viewPoint.x = static_cast<int>(_viewportWidth * (point.x / point.w + 1.0) / 2.0);
+    viewPoint.y = static_cast<int>(_viewportHeight * (point.y / point.w + 1.0) / 2.0);
+    viewPoint.z = 0.0;
+    viewPoint.w = 1.0;
+}
+
+void MVGProjectionSnapshot::viewToWorld(const MPoint& viewPoint, MPoint& worldPoint) const
+{
+    // unproject on the near clipping plane, as M3dView::viewToWorld() does
+    const MPoint clipPoint(2.0 * viewPoint.x / _viewportWidth - 1.0,
+                           2.0 * viewPoint.y / _viewportHeight - 1.0, -1.0);
+    worldPoint = clipPoint * _clipToWorld;
+    worldPoint.cartesianize();
+}
+
+void MVGProjectionSnapshot::worldToCamera(const MPoint& worldPoint, MPoint& cameraPoint) const
+{
+    MPoint viewPoint;
+    worldToView(worldPoint, viewPoint);
+    viewToCamera(viewPoint, cameraPoint);
+}
+
+void MVGProjectionSnapshot::cameraToWorld(const MPoint& cameraPoint, MPoint& worldPoint) const
+{
+    MPoint viewPoint;
+    cameraToView(cameraPoint, viewPoint);
+    viewToWorld(viewPoint, worldPoint);
+}
+
+} // namespace
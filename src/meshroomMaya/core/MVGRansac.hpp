@@ -0,0 +1,179 @@
+#pragma once
+
+#include <maya/MTimer.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace meshroomMaya
+{
+
+/**
+ * @brief Parameters of the adaptive RANSAC estimator.
+ */
+struct MVGRansacOptions
+{
+    MVGRansacOptions()
+        : threshold(0.0)
+        , confidence(0.99)
+        , maxIterations(1000)
+        , maxMilliseconds(4.0)
+        , seed(42)
+    {
+    }
+    /// maximum distance between a sample and the model for the sample to be an inlier
+    double threshold;
+    /// probability of having drawn at least one outlier-free minimal sample when stopping
+    double confidence;
+    /// hard limit on the number of minimal samples drawn
+    unsigned int maxIterations;
+    /// hard limit on the time spent sampling, ignored if <= 0
+    double maxMilliseconds;
+    /// seed of the sampler, so that a given set of samples always gives the same model
+    unsigned int seed;
+};
+
+namespace ransac
+{
+
+/// Small xorshift generator: deterministic and independent from the global rand() state
+class Sampler
+{
+public:
+    explicit Sampler(unsigned int seed)
+        : _state(seed ? seed : 1u)
+    {
+    }
+    size_t operator()(size_t range)
+    {
+        _state ^= _state << 13;
+        _state ^= _state >> 17;
+        _state ^= _state << 5;
+        return static_cast<size_t>(_state % range);
+    }
+
+private:
+    unsigned int _state;
+};
+
+/**
+ * @brief Number of iterations needed to draw an outlier-free sample with the given confidence.
+ */
+inline unsigned int requiredIterations(double inlierRatio, unsigned int minimumSamples,
+                                       double confidence, unsigned int maxIterations)
+{
+    const double goodSampleProbability = std::pow(inlierRatio, (double)minimumSamples);
+    if(goodSampleProbability >= 1.0)
+        return 1;
+    if(goodSampleProbability <= std::numeric_limits<double>::epsilon())
+        return maxIterations;
+    const double iterations =
+        std::ceil(std::log(1.0 - confidence) / std::log(1.0 - goodSampleProbability));
+    return iterations < maxIterations ? static_cast<unsigned int>(iterations) : maxIterations;
+}
+
+} // namespace ransac
+
+/**
+ * @brief Adaptive RANSAC with MSAC scoring and a least squares refit on the inliers.
+ *
+ * The number of iterations is updated from the best inlier ratio found so far, so clean inputs
+ * stop after a few samples, and is bounded by an iteration and a time budget.
+ * The kernel must follow the aliceVision interface (MINIMUM_SAMPLES, NumSamples, Fit, Error)
+ * and provide Refit(samples, model) for the final least squares estimation.
+ *
+ * @param[in] kernel samples and model computation
+ * @param[in] options threshold, confidence and budgets
+ * @param[out] model best model, refitted on its inliers
+ * @param[out] inliers indexes of the inliers of the returned model (optional)
+ * @return false if no model could be estimated
+ */
+template <typename Kernel>
+bool adaptiveRansac(const Kernel& kernel, const MVGRansacOptions& options,
+                    typename Kernel::Model* model, std::vector<size_t>* inliers = NULL)
+{
+    const size_t samplesCount = kernel.NumSamples();
+    const unsigned int minimumSamples = Kernel::MINIMUM_SAMPLES;
+    if(samplesCount < minimumSamples)
+        return false;
+
+    MTimer timer;
+    timer.beginTimer();
+    ransac::Sampler sampler(options.seed);
+    std::vector<size_t> minimalSample(minimumSamples);
+    std::vector<typename Kernel::Model> models;
+    double bestScore = std::numeric_limits<double>::infinity();
+    size_t bestInliersCount = 0;
+    bool found = false;
+
+    unsigned int iterationsNeeded = options.maxIterations;
+    for(unsigned int iteration = 0; iteration < iterationsNeeded; ++iteration)
+    {
+        // check the time budget every few iterations
+        if(options.maxMilliseconds > 0.0 && found && (iteration % 16) == 15)
+        {
+            timer.endTimer();
+            if(timer.elapsedTime() * 1000.0 > options.maxMilliseconds)
+                break;
+        }
+        // draw a minimal sample of distinct indexes
+        for(unsigned int i = 0; i < minimumSamples; ++i)
+        {
+            bool isDuplicate = true;
+            while(isDuplicate)
+            {
+                minimalSample[i] = sampler(samplesCount);
+                isDuplicate = false;
+                for(unsigned int j = 0; j < i; ++j)
+                    isDuplicate |= (minimalSample[j] == minimalSample[i]);
+            }
+        }
+        kernel.Fit(minimalSample, &models);
+        for(size_t m = 0; m < models.size(); ++m)
+        {
+            // MSAC score: inliers cost their error, outliers the threshold
+            double score = 0.0;
+            size_t inliersCount = 0;
+            for(size_t s = 0; s < samplesCount && score < bestScore; ++s)
+            {
+                const double error = kernel.Error(s, models[m]);
+                if(error < options.threshold)
+                {
+                    score += error;
+                    ++inliersCount;
+                }
+                else
+                    score += options.threshold;
+            }
+            if(score >= bestScore)
+                continue;
+            bestScore = score;
+            bestInliersCount = inliersCount;
+            *model = models[m];
+            found = true;
+            const unsigned int iterations = ransac::requiredIterations(
+                (double)bestInliersCount / samplesCount, minimumSamples, options.confidence,
+                options.maxIterations);
+            if(iterations < iterationsNeeded)
+                iterationsNeeded = iterations;
+        }
+    }
+    if(!found)
+        return false;
+
+    // least squares refit on the inliers
+    std::vector<size_t> bestInliers;
+    bestInliers.reserve(bestInliersCount);
+    for(size_t s = 0; s < samplesCount; ++s)
+    {
+        if(kernel.Error(s, *model) < options.threshold)
+            bestInliers.push_back(s);
+    }
+    if(bestInliers.size() >= minimumSamples)
+        kernel.Refit(bestInliers, model);
+    if(inliers)
+        inliers->swap(bestInliers);
+    return true;
+}
+
+} // namespace
@@ -0,0 +1,270 @@
+#include "meshroomMaya/core/MVGSceneRegistry.hpp"
+#include "meshroomMaya/core/MVGCamera.hpp"
+#include <maya/MFnDagNode.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MItDependencyNodes.h>
+#include <maya/MPlug.h>
+
+namespace meshroomMaya
+{
+
+namespace
+{ // empty namespace
+
+/// Read the view id without logging errors for the cameras not created by MeshroomMaya
+bool getViewId(const MObject& node, int& viewId)
+{
+    MStatus status;
+    MFnDependencyNode fn(node);
+    MPlug plug = fn.findPlug(MVGCamera::_MVG_VIEW_ID, false, &status);
+    if(!status)
+        return false;
+    viewId = plug.asInt();
+    return true;
+}
+
+} // empty namespace
+
+MVGSceneRegistry::NodeList MVGSceneRegistry::_cameras;
+MVGSceneRegistry::NodeList MVGSceneRegistry::_meshes;
+MVGSceneRegistry::NodeList MVGSceneRegistry::_transforms;
+MVGSceneRegistry::NodeList MVGSceneRegistry::_sets;
+std::map<int, MObjectHandle> MVGSceneRegistry::_cameraByViewId;
+std::set<int> MVGSceneRegistry::_missingViewIds;
+MVGSceneRegistry::RemovedNodes MVGSceneRegistry::_removedNodes;
+bool MVGSceneRegistry::_isBuilt = false;
+bool MVGSceneRegistry::_isCameraIndexDirty = true;
+
+// static
+void MVGSceneRegistry::clear()
+{
+    _cameras.clear();
+    _meshes.clear();
+    _transforms.clear();
+    _sets.clear();
+    _cameraByViewId.clear();
+    _missingViewIds.clear();
+    _removedNodes.clear();
+    _isBuilt = false;
+    _isCameraIndexDirty = true;
+}
+
+// static
+void MVGSceneRegistry::nodeAdded(const MObject& node)
+{
+    // nodes will be collected by build()
+    if(!_isBuilt)
+        return;
+    NodeList* nodes = getNodeList(node);
+    if(!nodes)
+        return;
+    const MObjectHandle handle(node);
+    // a removal undone before the next query: the node is still listed
+    RemovedNodes::iterator removedIt = findRemovedNode(handle);
+    if(removedIt != _removedNodes.end())
+        _removedNodes.erase(removedIt);
+    else
+        nodes->push_back(handle);
+    if(nodes == &_cameras)
+        _isCameraIndexDirty = true;
+}
+
+// static
+void MVGSceneRegistry::nodeRemoved(const MObject& node)
+{
+    if(!_isBuilt)
+        return;
+    NodeList* nodes = getNodeList(node);
+    if(!nodes)
+        return;
+    const MObjectHandle handle(node);
+    if(findRemovedNode(handle) == _removedNodes.end())
+        _removedNodes.insert(std::make_pair(handle.hashCode(), handle));
+    if(nodes == &_cameras)
+        _isCameraIndexDirty = true;
+}
+
+// static
+bool MVGSceneRegistry::getCameraPath(const int viewId, MDagPath& path)
+{
+    build();
+    if(_isCameraIndexDirty)
+    {
+        buildCameraIndex();
+        _missingViewIds.clear();
+    }
+    // deleted cameras are still referenced by the blind data of the meshes
+    if(_missingViewIds.count(viewId) > 0)
+        return false;
+    for(int attempt = 0; attempt < 2; ++attempt)
+    {
+        std::map<int, MObjectHandle>::const_iterator it = _cameraByViewId.find(viewId);
+        if(it != _cameraByViewId.end() && it->second.isValid())
+        {
+            // view ids are attributes: check this one did not change since the index was built
+            int id = -1;
+            getViewId(it->second.object(), id);
+            if(id == viewId && MDagPath::getAPathTo(it->second.object(), path))
+                return true;
+        }
+        // the camera may have been configured after the index was built
+        if(attempt == 0)
+            buildCameraIndex();
+    }
+    _missingViewIds.insert(viewId);
+    return false;
+}
+
+// static
+void MVGSceneRegistry::getCameraPaths(std::vector<MDagPath>& paths)
+{
+    build();
+    getPaths(_cameras, paths);
+}
+
+// static
+void MVGSceneRegistry::getMeshPaths(std::vector<MDagPath>& paths)
+{
+    build();
+    paths.clear();
+    paths.reserve(_meshes.size());
+    MDagPath path;
+    for(NodeList::const_iterator it = _meshes.begin(); it != _meshes.end(); ++it)
+    {
+        if(!it->isValid())
+            continue;
+        MFnDagNode fn(it->object());
+        if(fn.isIntermediateObject())
+            continue;
+        fn.getPath(path);
+        paths.push_back(path);
+    }
+}
+
+// static
+void MVGSceneRegistry::getTransformPaths(std::vector<MDagPath>& paths)
+{
+    build();
+    getPaths(_transforms, paths);
+}
+
+// static
+void MVGSceneRegistry::getSets(std::vector<MObject>& sets)
+{
+    build();
+    sets.clear();
+    sets.reserve(_sets.size());
+    for(NodeList::const_iterator it = _sets.begin(); it != _sets.end(); ++it)
+    {
+        if(it->isValid())
+            sets.push_back(it->object());
+    }
+}
+
+/**
+ * @brief Collect the registered node types in a single dependency graph traversal.
+ */
+// static
+void MVGSceneRegistry::build()
+{
+    if(_isBuilt)
+    {
+        compact();
+        return;
+    }
+    clear();
+    MItDependencyNodes it;
+    for(; !it.isDone(); it.next())
+    {
+        MObject node = it.thisNode();
+        NodeList* nodes = getNodeList(node);
+        if(nodes)
+            nodes->push_back(MObjectHandle(node));
+    }
+    _isBuilt = true;
+}
+
+// static
+void MVGSceneRegistry::buildCameraIndex()
+{
+    _cameraByViewId.clear();
+    for(NodeList::const_iterator it = _cameras.begin(); it != _cameras.end(); ++it)
+    {
+        if(!it->isValid())
+            continue;
+        int id = -1;
+        if(!getViewId(it->object(), id))
+            continue;
+        _cameraByViewId[id] = *it;
+    }
+    _isCameraIndexDirty = false;
+}
+
+// static
+void MVGSceneRegistry::compact()
+{
+    if(_removedNodes.empty())
+        return;
+    NodeList* lists[] = {&_cameras, &_meshes, &_transforms, &_sets};
+    for(size_t l = 0; l < sizeof(lists) / sizeof(lists[0]); ++l)
+    {
+        // keep the registration order
+        NodeList& nodes = *lists[l];
+        size_t kept = 0;
+        for(size_t i = 0; i < nodes.size(); ++i)
+        {
+            if(nodes[i].isAlive() && findRemovedNode(nodes[i]) == _removedNodes.end())
+                nodes[kept++] = nodes[i];
+        }
+        nodes.resize(kept);
+    }
+    _removedNodes.clear();
+}
+
+// static
+MVGSceneRegistry::RemovedNodes::iterator MVGSceneRegistry::findRemovedNode(
+    const MObjectHandle& handle)
+{
+    std::pair<RemovedNodes::iterator, RemovedNodes::iterator> range =
+        _removedNodes.equal_range(handle.hashCode());
+    for(RemovedNodes::iterator it = range.first; it != range.second; ++it)
+    {
+        if(it->second.isAlive() && it->second.object() == handle.object())
+            return it;
+    }
+    return _removedNodes.end();
+}
+
+// static
+MVGSceneRegistry::NodeList* MVGSceneRegistry::getNodeList(const MObject& node)
+{
+    switch(node.apiType())
+    {
+        case MFn::kCamera:
+            return &_cameras;
+        case MFn::kMesh:
+            return &_meshes;
+        case MFn::kTransform:
+            return &_transforms;
+        case MFn::kSet:
+            return &_sets;
+        default:
+            break;
+    }
+    return NULL;
+}
+
+// static
+void MVGSceneRegistry::getPaths(const NodeList& nodes, std::vector<MDagPath>& paths)
+{
+    paths.clear();
+    paths.reserve(nodes.size());
+    MDagPath path;
+    for(NodeList::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+    {
+        if(it->isValid() && MDagPath::getAPathTo(it->object(), path))
+            paths.push_back(path);
+    }
+}
+
+} // namespace
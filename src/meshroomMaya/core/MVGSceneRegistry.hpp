@@ -0,0 +1,74 @@
+#pragma once
+
+#include <maya/MDagPath.h>
+#include <maya/MObjectHandle.h>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace meshroomMaya
+{
+
+/**
+ * @brief Process-wide index of the scene nodes MeshroomMaya looks for.
+ *
+ * Cameras, meshes, transforms and sets are collected by a single dependency graph traversal on
+ * the first query, then kept current by the node added/removed callbacks (see
+ * MVGMayaCallbacks.hpp), so that listing them does not traverse the whole scene anymore.
+ * Nodes are registered by type only: MeshroomMaya attributes are added after node creation, so
+ * the callers still validate the returned nodes. Cameras are also indexed by view id, and the
+ * view ids not found are remembered until a camera is added or removed.
+ * Removed nodes are dropped from the lists by the next query, so that deleting many nodes at
+ * once stays linear.
+ * The registry is cleared when a new scene is opened; it is then rebuilt lazily.
+ */
+class MVGSceneRegistry
+{
+public:
+    static void clear();
+    static void nodeAdded(const MObject& node);
+    static void nodeRemoved(const MObject& node);
+
+public:
+    /**
+     * @brief Get the camera shape with the given view id.
+     * @param[in] viewId MeshroomMaya view id
+     * @param[out] path dag path to the camera shape
+     * @return false if no camera has this view id, without logging
+     */
+    static bool getCameraPath(const int viewId, MDagPath& path);
+    static void getCameraPaths(std::vector<MDagPath>& paths);
+    /// Non intermediate mesh shapes
+    static void getMeshPaths(std::vector<MDagPath>& paths);
+    static void getTransformPaths(std::vector<MDagPath>& paths);
+    static void getSets(std::vector<MObject>& sets);
+
+private:
+    typedef std::vector<MObjectHandle> NodeList;
+    /// by hash code, which is not unique: the nodes are compared too
+    typedef std::multimap<unsigned int, MObjectHandle> RemovedNodes;
+
+private:
+    static void build();
+    static void buildCameraIndex();
+    /// Drop the removed nodes from the lists
+    static void compact();
+    static RemovedNodes::iterator findRemovedNode(const MObjectHandle& handle);
+    static NodeList* getNodeList(const MObject& node);
+    static void getPaths(const NodeList& nodes, std::vector<MDagPath>& paths);
+
+private:
+    static NodeList _cameras;
+    static NodeList _meshes;
+    static NodeList _transforms;
+    static NodeList _sets;
+    static std::map<int, MObjectHandle> _cameraByViewId;
+    /// view ids without camera, until the camera index is dirty
+    static std::set<int> _missingViewIds;
+    /// removed nodes still in the lists
+    static RemovedNodes _removedNodes;
+    static bool _isBuilt;
+    static bool _isCameraIndexDirty;
+};
+
+} // namespace
@@ -0,0 +1,380 @@
+#include "meshroomMaya/core/MVGVisibilityIndex.hpp"
+#include "meshroomMaya/core/MVGCamera.hpp"
+#include <maya/MIntArray.h>
+#include <maya/MThreadPool.h>
+#include <maya/MThreadUtils.h>
+#include <algorithm>
+#include <set>
+#include <utility>
+
+namespace meshroomMaya
+{
+
+namespace
+{ // empty namespace
+
+/// Minimum number of observations processed by a worker task
+const int MIN_OBSERVATIONS_PER_TASK = 65536;
+
+/// Contiguous range of rows processed by a worker task
+struct RangeTask
+{
+    void* data;
+    int taskIndex;
+    int begin;
+    int end;
+};
+
+struct ParallelRegion
+{
+    MThreadFunc function;
+    std::vector<RangeTask>* tasks;
+};
+
+void createRangeTasks(void* regionData, MThreadRootTask* root)
+{
+    ParallelRegion& region = *static_cast<ParallelRegion*>(regionData);
+    for(size_t i = 0; i < region.tasks->size(); ++i)
+        MThreadPool::createTask(region.function, &(*region.tasks)[i], root);
+    MThreadPool::executeAndJoin(root);
+}
+
+int getTasksCount(const int observationsCount)
+{
+    const int maxTasksCount = std::max(MThreadUtils::getNumThreads(), 1);
+    return std::max(1, std::min(maxTasksCount, observationsCount / MIN_OBSERVATIONS_PER_TASK));
+}
+
+/// Split [0, count) in tasksCount contiguous ranges
+void splitRange(void* data, const int count, const int tasksCount, std::vector<RangeTask>& tasks)
+{
+    tasks.resize(tasksCount);
+    for(int i = 0; i < tasksCount; ++i)
+    {
+        tasks[i].data = data;
+        tasks[i].taskIndex = i;
+        tasks[i].begin = (int)((long long)count * i / tasksCount);
+        tasks[i].end = (int)((long long)count * (i + 1) / tasksCount);
+    }
+}
+
+/// Run the function on every task, on the thread pool if there are several tasks
+void runTasks(MThreadFunc function, std::vector<RangeTask>& tasks)
+{
+    if(tasks.size() > 1 && MThreadPool::init())
+    {
+        ParallelRegion region = {function, &tasks};
+        MThreadPool::newParallelRegion(createRangeTasks, &region);
+        MThreadPool::release();
+        return;
+    }
+    for(size_t i = 0; i < tasks.size(); ++i)
+        function(&tasks[i]);
+}
+
+const int* getData(const std::vector<int>& v)
+{
+    return v.empty() ? NULL : &v[0];
+}
+
+struct ViewIdsData
+{
+    const MIntArray* viewIds;
+    int step;
+    /// distinct view ids found by each task
+    std::vector<std::vector<int> > taskViewIds;
+    /// sorted view ids of all the cameras
+    const std::vector<int>* cameraViewIds;
+    /// camera index of each observation
+    std::vector<int>* observationCameras;
+};
+
+MThreadRetVal collectViewIdsTask(void* taskData)
+{
+    const RangeTask* task = static_cast<const RangeTask*>(taskData);
+    ViewIdsData& data = *static_cast<ViewIdsData*>(task->data);
+    std::set<int> viewIds;
+    int lastViewId = 0;
+    for(int o = task->begin; o < task->end; ++o)
+    {
+        // consecutive observations are often from the same view
+        const int viewId = (*data.viewIds)[o * data.step];
+        if(viewIds.empty() || viewId != lastViewId)
+            viewIds.insert(viewId);
+        lastViewId = viewId;
+    }
+    data.taskViewIds[task->taskIndex].assign(viewIds.begin(), viewIds.end());
+    return 0;
+}
+
+MThreadRetVal mapViewIdsTask(void* taskData)
+{
+    const RangeTask* task = static_cast<const RangeTask*>(taskData);
+    ViewIdsData& data = *static_cast<ViewIdsData*>(task->data);
+    const std::vector<int>& cameraViewIds = *data.cameraViewIds;
+    std::vector<int>& observationCameras = *data.observationCameras;
+    for(int o = task->begin; o < task->end; ++o)
+    {
+        const int viewId = (*data.viewIds)[o * data.step];
+        observationCameras[o] = (int)(
+            std::lower_bound(cameraViewIds.begin(), cameraViewIds.end(), viewId) -
+            cameraViewIds.begin());
+    }
+    return 0;
+}
+
+struct TransposeData
+{
+    const std::vector<int>* rowOffsets;
+    const std::vector<int>* rowColumns;
+    int columnsCount;
+    /// per task and column: entries count, then next write position
+    std::vector<std::vector<int> > cursors;
+    std::vector<int>* columnRows;
+};
+
+MThreadRetVal countColumnsTask(void* taskData)
+{
+    const RangeTask* task = static_cast<const RangeTask*>(taskData);
+    TransposeData& data = *static_cast<TransposeData*>(task->data);
+    const std::vector<int>& rowOffsets = *data.rowOffsets;
+    const std::vector<int>& rowColumns = *data.rowColumns;
+    std::vector<int>& counts = data.cursors[task->taskIndex];
+    counts.assign(data.columnsCount, 0);
+    for(int e = rowOffsets[task->begin]; e < rowOffsets[task->end]; ++e)
+        ++counts[rowColumns[e]];
+    return 0;
+}
+
+MThreadRetVal fillColumnsTask(void* taskData)
+{
+    const RangeTask* task = static_cast<const RangeTask*>(taskData);
+    TransposeData& data = *static_cast<TransposeData*>(task->data);
+    const std::vector<int>& rowOffsets = *data.rowOffsets;
+    const std::vector<int>& rowColumns = *data.rowColumns;
+    std::vector<int>& columnRows = *data.columnRows;
+    std::vector<int>& cursors = data.cursors[task->taskIndex];
+    for(int r = task->begin; r < task->end; ++r)
+    {
+        for(int e = rowOffsets[r]; e < rowOffsets[r + 1]; ++e)
+            columnRows[cursors[rowColumns[e]]++] = r;
+    }
+    return 0;
+}
+
+/**
+ * @brief Build the column-major rows of a compressed sparse row matrix.
+ *
+ * Each task counts the columns of its rows, then writes its rows at the positions reserved for
+ * it in each column: tasks are ordered by rows, so the rows of a column stay sorted.
+ */
+void transpose(const std::vector<int>& rowOffsets, const std::vector<int>& rowColumns,
+               const int columnsCount, std::vector<int>& columnOffsets,
+               std::vector<int>& columnRows)
+{
+    const int rowsCount = (int)rowOffsets.size() - 1;
+    const int entriesCount = (int)rowColumns.size();
+    // every task counts all the columns: keep the counters smaller than the entries
+    int tasksCount = getTasksCount(entriesCount);
+    if(columnsCount > 0)
+        tasksCount = std::max(1, std::min(tasksCount, entriesCount / columnsCount));
+    tasksCount = std::max(1, std::min(tasksCount, rowsCount));
+
+    TransposeData data;
+    data.rowOffsets = &rowOffsets;
+    data.rowColumns = &rowColumns;
+    data.columnsCount = columnsCount;
+    data.cursors.resize(tasksCount);
+    data.columnRows = &columnRows;
+    std::vector<RangeTask> tasks;
+    splitRange(&data, rowsCount, tasksCount, tasks);
+    runTasks(countColumnsTask, tasks);
+
+    columnOffsets.assign(columnsCount + 1, 0);
+    int position = 0;
+    for(int c = 0; c < columnsCount; ++c)
+    {
+        columnOffsets[c] = position;
+        for(int t = 0; t < tasksCount; ++t)
+        {
+            const int count = data.cursors[t][c];
+            data.cursors[t][c] = position;
+            position += count;
+        }
+    }
+    columnOffsets[columnsCount] = position;
+    columnRows.resize(position);
+    runTasks(fillColumnsTask, tasks);
+}
+
+} // empty namespace
+
+MVGVisibilityIndex::MVGVisibilityIndex()
+{
+    clear();
+}
+
+bool MVGVisibilityIndex::build(const MIntArray& visibilitySizes, const MIntArray& viewIds,
+                               const int step)
+{
+    clear();
+    const int pointsCount = visibilitySizes.length();
+    _pointOffsets.resize(pointsCount + 1);
+    long long observationsCount = 0;
+    bool isValid = step > 0;
+    for(int p = 0; p < pointsCount && isValid; ++p)
+    {
+        _pointOffsets[p] = (int)observationsCount;
+        isValid = visibilitySizes[p] >= 0;
+        observationsCount += visibilitySizes[p];
+    }
+    _pointOffsets[pointsCount] = (int)observationsCount;
+    if(!isValid || observationsCount * step != viewIds.length())
+    {
+        clear();
+        return false;
+    }
+
+    // Cameras
+    ViewIdsData data;
+    data.viewIds = &viewIds;
+    data.step = step;
+    data.cameraViewIds = &_cameraViewIds;
+    data.observationCameras = &_pointCameras;
+    const int tasksCount = getTasksCount((int)observationsCount);
+    data.taskViewIds.resize(tasksCount);
+    std::vector<RangeTask> tasks;
+    splitRange(&data, (int)observationsCount, tasksCount, tasks);
+    runTasks(collectViewIdsTask, tasks);
+    for(int t = 0; t < tasksCount; ++t)
+        _cameraViewIds.insert(_cameraViewIds.end(), data.taskViewIds[t].begin(),
+                              data.taskViewIds[t].end());
+    std::sort(_cameraViewIds.begin(), _cameraViewIds.end());
+    _cameraViewIds.erase(std::unique(_cameraViewIds.begin(), _cameraViewIds.end()),
+                         _cameraViewIds.end());
+
+    // Point to camera rows, then camera to point rows
+    _pointCameras.resize(observationsCount);
+    runTasks(mapViewIdsTask, tasks);
+    transpose(_pointOffsets, _pointCameras, (int)_cameraViewIds.size(), _cameraOffsets,
+              _cameraPoints);
+    useOwnRows();
+    return true;
+}
+
+void MVGVisibilityIndex::build(const std::vector<MVGCamera>& cameras)
+{
+    clear();
+    std::vector<std::pair<int, size_t> > viewIds;
+    viewIds.reserve(cameras.size());
+    for(size_t i = 0; i < cameras.size(); ++i)
+        viewIds.push_back(std::make_pair(cameras[i].getId(), i));
+    std::sort(viewIds.begin(), viewIds.end());
+
+    // Camera to point rows
+    MIntArray pointIds;
+    int pointsCount = 0;
+    _cameraOffsets.push_back(0);
+    for(size_t i = 0; i < viewIds.size(); ++i)
+    {
+        if(!_cameraViewIds.empty() && _cameraViewIds.back() == viewIds[i].first)
+            continue;
+        _cameraViewIds.push_back(viewIds[i].first);
+        cameras[viewIds[i].second].getVisibleIndexes(pointIds);
+        const size_t first = _cameraPoints.size();
+        for(unsigned int j = 0; j < pointIds.length(); ++j)
+        {
+            if(pointIds[j] < 0)
+                continue;
+            _cameraPoints.push_back(pointIds[j]);
+            pointsCount = std::max(pointsCount, pointIds[j] + 1);
+        }
+        std::sort(_cameraPoints.begin() + first, _cameraPoints.end());
+        _cameraOffsets.push_back((int)_cameraPoints.size());
+    }
+
+    // Point to camera rows
+    transpose(_cameraOffsets, _cameraPoints, pointsCount, _pointOffsets, _pointCameras);
+    useOwnRows();
+}
+
+void MVGVisibilityIndex::assign(const Rows& rows)
+{
+    clear();
+    _rows = rows;
+}
+
+void MVGVisibilityIndex::swap(MVGVisibilityIndex& other)
+{
+    // the vectors keep their buffers: the rows stay valid
+    std::swap(_rows, other._rows);
+    _cameraViewIds.swap(other._cameraViewIds);
+    _pointOffsets.swap(other._pointOffsets);
+    _pointCameras.swap(other._pointCameras);
+    _cameraOffsets.swap(other._cameraOffsets);
+    _cameraPoints.swap(other._cameraPoints);
+}
+
+void MVGVisibilityIndex::clear()
+{
+    _cameraViewIds.clear();
+    _pointOffsets.assign(1, 0);
+    _pointCameras.clear();
+    _cameraOffsets.assign(1, 0);
+    _cameraPoints.clear();
+    useOwnRows();
+}
+
+int MVGVisibilityIndex::findCamera(const int viewId) const
+{
+    const int* first = _rows.cameraViewIds;
+    const int* last = first + _rows.camerasCount;
+    const int* it = std::lower_bound(first, last, viewId);
+    if(it == last || *it != viewId)
+        return -1;
+    return (int)(it - first);
+}
+
+void MVGVisibilityIndex::getPointCameras(const int pointId, const int*& first,
+                                         const int*& last) const
+{
+    first = last = _rows.pointCameras;
+    if(pointId < 0 || pointId >= getPointsCount())
+        return;
+    first += _rows.pointOffsets[pointId];
+    last += _rows.pointOffsets[pointId + 1];
+}
+
+void MVGVisibilityIndex::getCameraPoints(const int cameraIndex, const int*& first,
+                                         const int*& last) const
+{
+    first = last = _rows.cameraPoints;
+    if(cameraIndex < 0 || cameraIndex >= getCamerasCount())
+        return;
+    first += _rows.cameraOffsets[cameraIndex];
+    last += _rows.cameraOffsets[cameraIndex + 1];
+}
+
+void MVGVisibilityIndex::getCameraPoints(const int cameraIndex, MIntArray& pointIds) const
+{
+    const int* first;
+    const int* last;
+    getCameraPoints(cameraIndex, first, last);
+    pointIds.clear();
+    if(first != last)
+        pointIds = MIntArray(first, (unsigned int)(last - first));
+}
+
+void MVGVisibilityIndex::useOwnRows()
+{
+    _rows.camerasCount = (int)_cameraViewIds.size();
+    _rows.pointsCount = (int)_pointOffsets.size() - 1;
+    _rows.observationsCount = (int)_pointCameras.size();
+    _rows.cameraViewIds = getData(_cameraViewIds);
+    _rows.pointOffsets = getData(_pointOffsets);
+    _rows.pointCameras = getData(_pointCameras);
+    _rows.cameraOffsets = getData(_cameraOffsets);
+    _rows.cameraPoints = getData(_cameraPoints);
+}
+
+} // namespace
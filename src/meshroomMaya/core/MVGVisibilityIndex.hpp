@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vector>
+
+class MIntArray;
+
+namespace meshroomMaya
+{
+
+class MVGCamera;
+
+/**
+ * @brief Compressed sparse row visibility of the point cloud, in both directions.
+ *
+ * Cameras are addressed by a dense index, in increasing view id order. The cameras observing
+ * point p are in [_pointOffsets[p], _pointOffsets[p + 1]) of _pointCameras, and the points
+ * observed by camera c are in [_cameraOffsets[c], _cameraOffsets[c + 1]) of _cameraPoints, in
+ * increasing point id order.
+ * The index is built once per project: a counting pass sizes the rows, then the rows are filled
+ * in parallel, each task writing to the positions reserved by the counting pass. It can also use
+ * rows stored outside of it, such as the ones mapped from the project cache (see
+ * MVGProjectCache).
+ */
+class MVGVisibilityIndex
+{
+public:
+    /// Raw rows of the index, see the class description
+    struct Rows
+    {
+        int camerasCount;
+        int pointsCount;
+        int observationsCount;
+        const int* cameraViewIds;
+        const int* pointOffsets;
+        const int* pointCameras;
+        const int* cameraOffsets;
+        const int* cameraPoints;
+    };
+
+public:
+    MVGVisibilityIndex();
+
+public:
+    /**
+     * @brief Build from the point cloud visibility attributes.
+     * @param[in] visibilitySizes number of observing views of each point
+     * @param[in] viewIds observing view ids, point after point
+     * @param[in] step distance between two view ids (2 for the legacy mvg_visibilityIds)
+     * @return false if the sizes are not coherent with the view ids
+     */
+    bool build(const MIntArray& visibilitySizes, const MIntArray& viewIds, const int step);
+    /// Build from the items of the cameras (see MVGCamera::getVisibleIndexes)
+    void build(const std::vector<MVGCamera>& cameras);
+    /**
+     * @brief Use rows owned by someone else, without copying them.
+     * The rows must stay valid until the next build() or clear().
+     */
+    void assign(const Rows& rows);
+    /// Exchange the contents of two indexes, without copying the rows
+    void swap(MVGVisibilityIndex& other);
+    void clear();
+
+public:
+    const Rows& getRows() const { return _rows; }
+    int getPointsCount() const { return _rows.pointsCount; }
+    int getCamerasCount() const { return _rows.camerasCount; }
+    int getObservationsCount() const { return _rows.observationsCount; }
+    int getCameraViewId(const int cameraIndex) const { return _rows.cameraViewIds[cameraIndex]; }
+    /// Index of the camera with the given view id, -1 if it does not observe any point
+    int findCamera(const int viewId) const;
+    /// Indexes of the cameras observing the point, in [first, last)
+    void getPointCameras(const int pointId, const int*& first, const int*& last) const;
+    /// Ids of the points observed by the camera, in [first, last)
+    void getCameraPoints(const int cameraIndex, const int*& first, const int*& last) const;
+    void getCameraPoints(const int cameraIndex, MIntArray& pointIds) const;
+
+private:
+    /// Not copyable: the rows may point to the vectors
+    MVGVisibilityIndex(const MVGVisibilityIndex&);
+    MVGVisibilityIndex& operator=(const MVGVisibilityIndex&);
+    /// Point the rows to the vectors
+    void useOwnRows();
+
+private:
+    Rows _rows;
+    std::vector<int> _cameraViewIds;
+    std::vector<int> _pointOffsets;
+    std::vector<int> _pointCameras;
+    std::vector<int> _cameraOffsets;
+    std::vector<int> _cameraPoints;
+};
+
+} // namespace
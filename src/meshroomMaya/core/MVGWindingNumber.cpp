@@ -0,0 +1,96 @@
+#include "meshroomMaya/core/MVGWindingNumber.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace meshroomMaya
+{
+
+namespace windingNumber
+{
+
+namespace
+{ // empty namespace
+
+bool detectAVX2()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    // the OS must save the AVX registers
+    const bool hasOSXSAVE = (info[2] & (1 << 27)) != 0;
+    const bool hasAVX = (info[2] & (1 << 28)) != 0;
+    if(!hasOSXSAVE || !hasAVX || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+/// > 0 when P is left of the edge i, < 0 when right of it
+inline double isLeft(const double* polygonX, const double* polygonY, const int i,
+                     const double px, const double py)
+{
+    return (polygonX[i + 1] - polygonX[i]) * (py - polygonY[i]) -
+           (px - polygonX[i]) * (polygonY[i + 1] - polygonY[i]);
+}
+
+} // empty namespace
+
+void computeScalar(const double* polygonX, const double* polygonY, const int edgesCount,
+                   const double* x, const double* y, int first, const int count,
+                   int* windingNumbers)
+{
+    for(; first < count; ++first)
+    {
+        const double px = x[first];
+        const double py = y[first];
+        int wn = 0;
+        for(int i = 0; i < edgesCount; ++i)
+        {
+            // the side test is only computed for the edges crossing the horizontal line of P
+            if(polygonY[i] <= py)
+            {
+                // upward crossing with P left of the edge
+                if(polygonY[i + 1] > py && isLeft(polygonX, polygonY, i, px, py) > 0)
+                    ++wn;
+            }
+            else
+            {
+                // downward crossing with P right of the edge
+                if(polygonY[i + 1] <= py && isLeft(polygonX, polygonY, i, px, py) < 0)
+                    --wn;
+            }
+        }
+        windingNumbers[first] = wn;
+    }
+}
+
+bool hasAVX2()
+{
+    static const bool isSupported = detectAVX2();
+    return isSupported;
+}
+
+void compute(const double* polygonX, const double* polygonY, const int edgesCount,
+             const double* x, const double* y, const int count, int* windingNumbers)
+{
+    int first = 0;
+    if(hasAVX2())
+        first = computeAVX2(polygonX, polygonY, edgesCount, x, y, count, windingNumbers);
+    computeScalar(polygonX, polygonY, edgesCount, x, y, first, count, windingNumbers);
+}
+
+} // namespace windingNumber
+
+} // namespace
@@ -0,0 +1,40 @@
+#pragma once
+
+namespace meshroomMaya
+{
+
+/**
+ * @brief Winding number kernels of MVGGeometryUtil::computeWindingNumbers.
+ *
+ * They do not depend on Maya, so that they can be checked and benchmarked outside of it
+ * (see src/tests). The closed polygon is given as separate x and y arrays of edgesCount + 1
+ * vertices, the last one being equal to the first one.
+ * The AVX2 kernel is compiled for AVX2 on its own (MVGWindingNumberAVX2.cpp) and only called
+ * when the CPU supports it: the plugin still runs on CPUs without AVX2.
+ * See: Algorithm 1 "Area of Triangles and Polygons".
+ */
+namespace windingNumber
+{
+
+/// Winding numbers of the points [first, count), one point at a time
+void computeScalar(const double* polygonX, const double* polygonY, const int edgesCount,
+                   const double* x, const double* y, int first, const int count,
+                   int* windingNumbers);
+
+/**
+ * @brief Winding numbers of the points [0, count), 4 points at a time. Requires AVX2.
+ * @return the number of points processed, the remaining ones are left to computeScalar
+ */
+int computeAVX2(const double* polygonX, const double* polygonY, const int edgesCount,
+                const double* x, const double* y, const int count, int* windingNumbers);
+
+/// Whether the CPU and the compiler support the AVX2 kernel, checked once
+bool hasAVX2();
+
+/// Winding numbers of the points [0, count), with AVX2 when the CPU supports it
+void compute(const double* polygonX, const double* polygonY, const int edgesCount,
+             const double* x, const double* y, const int count, int* windingNumbers);
+
+} // namespace windingNumber
+
+} // namespace
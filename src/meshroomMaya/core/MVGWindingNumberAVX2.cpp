@@ -0,0 +1,76 @@
+#include "meshroomMaya/core/MVGWindingNumber.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define MESHROOMMAYA_HAS_X86_INTRINSICS
+#include <immintrin.h>
+#endif
+
+// Only this kernel is compiled for AVX2, the plugin is not
+#if defined(__GNUC__) && !defined(__AVX2__)
+#define MESHROOMMAYA_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MESHROOMMAYA_TARGET_AVX2
+#endif
+
+namespace meshroomMaya
+{
+
+namespace windingNumber
+{
+
+#if defined(MESHROOMMAYA_HAS_X86_INTRINSICS)
+MESHROOMMAYA_TARGET_AVX2
+int computeAVX2(const double* polygonX, const double* polygonY, const int edgesCount,
+                const double* x, const double* y, const int count, int* windingNumbers)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    int first = 0;
+    for(; first + 4 <= count; first += 4)
+    {
+        const __m256d px = _mm256_loadu_pd(x + first);
+        const __m256d py = _mm256_loadu_pd(y + first);
+        __m256d wn = zero;
+        for(int i = 0; i < edgesCount; ++i)
+        {
+            const double x0 = polygonX[i];
+            const double y0 = polygonY[i];
+            const double x1 = polygonX[i + 1];
+            const double y1 = polygonY[i + 1];
+            const __m256d vy0 = _mm256_set1_pd(y0);
+            const __m256d vy1 = _mm256_set1_pd(y1);
+            // > 0 when P is left of the edge, < 0 when right of it
+            const __m256d left =
+                _mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(x1 - x0), _mm256_sub_pd(py, vy0)),
+                              _mm256_mul_pd(_mm256_sub_pd(px, _mm256_set1_pd(x0)),
+                                            _mm256_set1_pd(y1 - y0)));
+            // upward crossing with P left of the edge
+            const __m256d up = _mm256_and_pd(
+                _mm256_and_pd(_mm256_cmp_pd(vy0, py, _CMP_LE_OQ),
+                              _mm256_cmp_pd(vy1, py, _CMP_GT_OQ)),
+                _mm256_cmp_pd(left, zero, _CMP_GT_OQ));
+            // downward crossing with P right of the edge
+            const __m256d down = _mm256_and_pd(
+                _mm256_and_pd(_mm256_cmp_pd(vy0, py, _CMP_GT_OQ),
+                              _mm256_cmp_pd(vy1, py, _CMP_LE_OQ)),
+                _mm256_cmp_pd(left, zero, _CMP_LT_OQ));
+            wn = _mm256_add_pd(wn, _mm256_and_pd(up, one));
+            wn = _mm256_sub_pd(wn, _mm256_and_pd(down, one));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(windingNumbers + first),
+                         _mm256_cvtpd_epi32(wn));
+    }
+    return first;
+}
+#else
+int computeAVX2(const double*, const double*, const int, const double*, const double*,
+                const int, int*)
+{
+    // never called: hasAVX2() is false
+    return 0;
+}
+#endif
+
+} // namespace windingNumber
+
+} // namespace
@@ -1,12 +1,17 @@
 #include "MVGMayaUtil.hpp"
 #include "meshroomMaya/core/MVGCamera.hpp"
+#include "meshroomMaya/core/MVGCameraProjectionCache.hpp"
 #include "meshroomMaya/core/MVGLog.hpp"
 #include "meshroomMaya/core/MVGMesh.hpp"
+#include "meshroomMaya/core/MVGPointCloudCache.hpp"
+#include "meshroomMaya/core/MVGSceneRegistry.hpp"
 #include "meshroomMaya/qt/MVGPanelWrapper.hpp"
 #include "meshroomMaya/qt/MVGMainWidget.hpp"
 #include "meshroomMaya/maya/context/MVGMoveManipulator.hpp"
 #include "meshroomMaya/maya/context/MVGContext.hpp"
 #include "meshroomMaya/maya/context/MVGContextCmd.hpp"
+#include "meshroomMaya/maya/cmd/MVGEditCmd.hpp"
+#include "meshroomMaya/maya/cmd/MVGRetriangulateCmd.hpp"
 #include <maya/MGlobal.h>
 #include <maya/MFnDependencyNode.h>
 #include <maya/MFnDagNode.h>
@@ -120,6 +125,9 @@ static void currentContextChangedCB(void*)
 
 static void sceneChangedCB(void*)
 {
+    MVGSceneRegistry::clear();
+    MVGCameraProjectionCache::clear();
+    MVGCamera::clearImagePlanes();
     MVGProjectWrapper* project = getProjectWrapper();
     if(!project)
         return;
@@ -133,46 +141,54 @@ static void sceneChangedCB(void*)
 
 static void newSceneCB(void*)
 {
+    MVGPointCloudCache::clear();
+    MVGSceneRegistry::clear();
+    MVGCameraProjectionCache::clear();
+    MVGCamera::clearImagePlanes();
     MVGMayaUtil::deleteMVGWindow();
 }
 
+/**
+ * @brief Patch the meshes modified by the MeshroomMaya edit commands, rebuild all meshes after
+ * the other commands but the selection.
+ * @param[in] commandLine undone or redone command
+ */
+static void updateCacheAfterUndoRedo(const MString& commandLine)
+{
+    const int spaceIndex = commandLine.index(' ');
+    const MString cmdName =
+        (spaceIndex < 0) ? commandLine : commandLine.substring(0, spaceIndex - 1);
+    const bool isEditCmd = (cmdName == MVGEditCmd::_name || cmdName == MVGRetriangulateCmd::_name);
+    MString cmd;
+    if(isEditCmd && MVGManipulatorCache::hasDirtyMeshes())
+        cmd.format("^1s -e -update ^2s", MVGContextCmd::name, MVGContextCmd::instanceName);
+    else if(cmdName != "select" && cmdName != "miCreateDefaultPresets")
+        cmd.format("^1s -e -rebuild ^2s", MVGContextCmd::name, MVGContextCmd::instanceName);
+    else
+        return;
+    MGlobal::executeCommand(cmd);
+}
+
 static void undoCB(void*)
 {
-    // TODO : rebuild only the modified mesh
-    // TODO : don't rebuild on action that don't modify any mesh
     MString redoName;
     MVGMayaUtil::getRedoName(redoName);
-    // Don't rebuild on selection
-    int spaceIndex = redoName.index(' ');
-    MString cmdName = redoName.substring(0, spaceIndex - 1);
-    if(cmdName != "select" && cmdName != "miCreateDefaultPresets")
-    {
-        MString cmd;
-        cmd.format("^1s -e -rebuild ^2s", MVGContextCmd::name, MVGContextCmd::instanceName);
-        MGlobal::executeCommand(cmd);
-    }
+    updateCacheAfterUndoRedo(redoName);
 }
 
 static void redoCB(void*)
 {
     MString undoName;
     MVGMayaUtil::getUndoName(undoName);
-    // Don't rebuild if selection action
-    int spaceIndex = undoName.index(' ');
-    MString cmdName = undoName.substring(0, spaceIndex - 1);
-    if(cmdName != "select" && cmdName != "miCreateDefaultPresets")
-    {
-        MString cmd;
-        cmd.format("^1s -e -rebuild ^2s", MVGContextCmd::name, MVGContextCmd::instanceName);
-        MGlobal::executeCommand(cmd);
-    }
+    updateCacheAfterUndoRedo(undoName);
 }
 
 /**
- * @brief Listen to the Maya nodes creation to update the list of Meshes.
+ * @brief Listen to the Maya nodes creation to update the scene registry and the list of Meshes.
 **/
 static void nodeAddedCB(MObject& node, void*)
 {
+    MVGSceneRegistry::nodeAdded(node);
     MVGProjectWrapper* project = getProjectWrapper();
     if(!project)
         return;
@@ -201,6 +217,7 @@ static void nodeAddedCB(MObject& node, void*)
 
 static void nodeRemovedCB(MObject& node, void*)
 {
+    MVGSceneRegistry::nodeRemoved(node);
     MVGProjectWrapper* project = getProjectWrapper();
     if(!project)
         return;
@@ -126,6 +126,15 @@ MStatus MVGMayaUtil::deleteMVGContext()
                                          "context.mvgDeleteContext()");
 }
 
+bool MVGMayaUtil::mvgContextExists()
+{
+    MString cmd;
+    cmd.format("contextInfo -exists ^1s", MVGContextCmd::instanceName);
+    int exists = 0;
+    MStatus status = MGlobal::executeCommand(cmd, exists);
+    return status && exists;
+}
+
 MStatus MVGMayaUtil::activeContext()
 {
     MString cmd;
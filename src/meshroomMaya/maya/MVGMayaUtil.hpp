@@ -41,6 +41,7 @@ struct MVGMayaUtil
     // context
     static MStatus createMVGContext();
     static MStatus deleteMVGContext();
+    static bool mvgContextExists();
     static MStatus activeContext();
     static MStatus activeMayaContext();
     static MStatus getCurrentContext(MString& context);
@@ -1,5 +1,6 @@
 #include "meshroomMaya/maya/cmd/MVGEditCmd.hpp"
 #include "meshroomMaya/maya/mesh/MVGMeshEditNode.hpp"
+#include "meshroomMaya/maya/context/MVGManipulatorCache.hpp"
 #include "meshroomMaya/core/MVGMesh.hpp"
 #include "meshroomMaya/core/MVGProject.hpp"
 #include "meshroomMaya/core/MVGLog.hpp"
@@ -40,17 +41,26 @@ MStatus MVGEditCmd::doIt(const MArgList& args)
 {
     setMeshNode(_meshPath);
     setModifierNodeType(MVGMeshEditNode::_id);
-    return doModifyPoly();
+    MStatus status = doModifyPoly();
+    if(status)
+        setMeshDirty();
+    return status;
 }
 
 MStatus MVGEditCmd::redoIt()
 {
-    return redoModifyPoly();
+    MStatus status = redoModifyPoly();
+    if(status)
+        setMeshDirty();
+    return status;
 }
 
 MStatus MVGEditCmd::undoIt()
 {
-    return undoModifyPoly();
+    MStatus status = undoModifyPoly();
+    if(status)
+        setMeshDirty();
+    return status;
 }
 
 bool MVGEditCmd::isUndoable() const
@@ -95,6 +105,18 @@ MStatus MVGEditCmd::initModifierNode(MObject node)
     return status;
 }
 
+/**
+ * @brief Record the modified vertices, for the manipulator cache to patch them only.
+ */
+void MVGEditCmd::setMeshDirty() const
+{
+    // new faces change the mesh topology
+    if(_editType == MVGMeshEditFactory::kAddFace)
+        MVGManipulatorCache::setMeshDirty(_meshPath, MIntArray());
+    else
+        MVGManipulatorCache::setMeshDirty(_meshPath, _componentIDs);
+}
+
 void MVGEditCmd::addFace(const MDagPath& meshPath, const MPointArray& worldSpacePositions,
                          const MPointArray& cameraSpacePositions, int cameraID)
 {
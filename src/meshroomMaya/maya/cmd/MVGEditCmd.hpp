@@ -37,6 +37,9 @@ public:
               const int cameraID, const bool clearBD = false);
     void clearBD(const MDagPath& meshPath, const MIntArray& componentIDs);
 
+private:
+    void setMeshDirty() const;
+
 public:
     static MString _name;
 
@@ -69,20 +69,13 @@ MStatus MVGImagePlaneCmd::doIt(const MArgList& args)
         dagPath.extendToShape();
 
         MFnDagNode fnCamera(dagPath, &status);
-        MPlug imagePlanePlug = fnCamera.findPlug("imagePlane", status);
         CHECK_RETURN_STATUS(status)
-        MPlug imagePlug = imagePlanePlug.elementByLogicalIndex(0, &status);
-        MPlugArray connectedPlugs;
-        imagePlug.connectedTo(connectedPlugs, true, true, &status);
-        CHECK_RETURN_STATUS(status)
-        if(connectedPlugs.length() == 0)
+        const MDagPath imagePlaneShapeDagPath = MVGCamera(dagPath).acquireImagePlane();
+        if(!imagePlaneShapeDagPath.isValid())
         {
-            LOG_ERROR("No plug connected to the plug")
+            LOG_ERROR("No image plane for camera " << dagPath.fullPathName())
             return MS::kFailure;
         }
-        MDagPath imagePlaneShapeDagPath;
-        status = MDagPath::getAPathTo(connectedPlugs[0].node(), imagePlaneShapeDagPath);
-        CHECK(status)
 
         MFnDagNode fnImagePlane(imagePlaneShapeDagPath, &status);
         MPlug imageNamePlug = fnImagePlane.findPlug("imageName", &status);
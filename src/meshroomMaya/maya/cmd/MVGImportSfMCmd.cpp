@@ -0,0 +1,462 @@
+#include "MVGImportSfMCmd.hpp"
+#include "meshroomMaya/core/MVGCamera.hpp"
+#include "meshroomMaya/core/MVGLog.hpp"
+#include "meshroomMaya/core/MVGProject.hpp"
+#include "meshroomMaya/core/MVGVisibilityIndex.hpp"
+#include "meshroomMaya/maya/MVGMayaUtil.hpp"
+#include <aliceVision/config.hpp>
+#include <aliceVision/sfmData/SfMData.hpp>
+#include <aliceVision/sfmDataIO/sfmDataIO.hpp>
+#include <maya/MArgDatabase.h>
+#include <maya/MDagModifier.h>
+#include <maya/MDoubleArray.h>
+#include <maya/MFnCamera.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnParticleSystem.h>
+#include <maya/MFnTransform.h>
+#include <maya/MFnTypedAttribute.h>
+#include <maya/MGlobal.h>
+#include <maya/MIntArray.h>
+#include <maya/MMatrix.h>
+#include <maya/MPointArray.h>
+#include <maya/MProgressWindow.h>
+#include <maya/MSyntax.h>
+#include <maya/MTimer.h>
+#include <maya/MTransformationMatrix.h>
+#include <maya/MVectorArray.h>
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+namespace meshroomMaya
+{
+
+namespace
+{ // empty namespace
+
+/// Sensor width of the Maya cameras, the focal length is converted accordingly
+const double SENSOR_WIDTH_MM = 36.0;
+const double MM_PER_INCH = 25.4;
+/// Number of particles emitted between two progress updates
+const int POINTS_PER_STEP = 100000;
+
+struct ImportedCamera
+{
+    const aliceVision::sfmData::View* view;
+    MObject transform;
+    MObject shape;
+};
+
+/**
+ * @brief Maya progress window, shown in interactive mode only.
+ */
+class Progress
+{
+public:
+    Progress(const int stepsCount)
+        : _step(0)
+        , _isShown(false)
+    {
+        if(MGlobal::mayaState() != MGlobal::kInteractive || !MProgressWindow::reserve())
+            return;
+        _isShown = true;
+        MProgressWindow::setTitle("Import SfM");
+        MProgressWindow::setInterruptable(true);
+        MProgressWindow::setProgressRange(0, std::max(stepsCount, 1));
+        MProgressWindow::setProgress(0);
+        MProgressWindow::startProgress();
+    }
+    ~Progress()
+    {
+        if(_isShown)
+            MProgressWindow::endProgress();
+    }
+
+public:
+    void setStatus(const MString& status)
+    {
+        if(_isShown)
+            MProgressWindow::setProgressStatus(status);
+    }
+    /// @return true if the import has been cancelled
+    bool advance(const int steps = 1)
+    {
+        _step += steps;
+        if(!_isShown)
+            return false;
+        MProgressWindow::setProgress(_step);
+        return MProgressWindow::isCancelled();
+    }
+
+private:
+    int _step;
+    bool _isShown;
+};
+
+double endTimer(MTimer& timer)
+{
+    timer.endTimer();
+    const double seconds = timer.elapsedTime();
+    timer.beginTimer();
+    return seconds;
+}
+
+std::string getExtension(const std::string& filePath)
+{
+    const size_t dot = filePath.find_last_of('.');
+    if(dot == std::string::npos || filePath.find_first_of("/\\", dot) != std::string::npos)
+        return std::string();
+    std::string extension = filePath.substr(dot);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return extension;
+}
+
+std::string getDirectory(const std::string& filePath)
+{
+    const size_t separator = filePath.find_last_of("/\\");
+    return (separator == std::string::npos) ? std::string(".") : filePath.substr(0, separator);
+}
+
+void addTypedAttribute(MDagModifier& dagModifier, const MObject& node, const MString& name,
+                       const MString& shortName, const MFnData::Type type)
+{
+    MFnTypedAttribute tAttr;
+    dagModifier.addAttribute(node, tAttr.create(name, shortName, type));
+}
+
+void addCameraAttributes(MDagModifier& dagModifier, const MObject& shape)
+{
+    MFnNumericAttribute nAttr;
+    dagModifier.addAttribute(
+        shape, nAttr.create(MVGCamera::_MVG_VIEW_ID, "mvgvi", MFnNumericData::kInt, -1));
+    dagModifier.addAttribute(
+        shape, nAttr.create(MVGCamera::_MVG_INTRINSIC_ID, "mvgii", MFnNumericData::kInt, -1));
+    addTypedAttribute(dagModifier, shape, MVGCamera::_MVG_INTRINSIC_TYPE, "mvgit",
+                      MFnData::kString);
+    addTypedAttribute(dagModifier, shape, MVGCamera::_MVG_INTRINSICS_PARAMS, "mvgipa",
+                      MFnData::kDoubleArray);
+    addTypedAttribute(dagModifier, shape, MVGCamera::_MVG_SENSOR_SIZE, "mvgss",
+                      MFnData::kIntArray);
+    addTypedAttribute(dagModifier, shape, MVGCamera::_MVG_IMAGE_PATH, "mvgimp",
+                      MFnData::kString);
+    addTypedAttribute(dagModifier, shape, MVGCamera::_MVG_IMAGE_SOURCE_PATH, "misp",
+                      MFnData::kString);
+    addTypedAttribute(dagModifier, shape, MVGCamera::_MVG_THUMBNAIL_PATH, "mtp",
+                      MFnData::kString);
+    addTypedAttribute(dagModifier, shape, MVGCamera::_MVG_ITEMS, "itm", MFnData::kIntArray);
+}
+
+/**
+ * @brief Same transformation as the AliceVision Alembic export: the rows of the rotation, with
+ * the Y and Z axes of the camera inverted, and the camera center.
+ */
+MMatrix getCameraMatrix(const aliceVision::geometry::Pose3& pose)
+{
+    const aliceVision::Mat3& R = pose.rotation();
+    const aliceVision::Vec3& C = pose.center();
+    MMatrix matrix;
+    for(int j = 0; j < 3; ++j)
+    {
+        matrix[0][j] = R(0, j);
+        matrix[1][j] = -R(1, j);
+        matrix[2][j] = -R(2, j);
+        matrix[3][j] = C(j);
+    }
+    return matrix;
+}
+
+/**
+ * @brief Set the transformation, the film and the MVG attributes of an imported camera.
+ */
+void setCamera(const aliceVision::sfmData::SfMData& sfmData, const ImportedCamera& camera,
+               const MVGVisibilityIndex& visibility, const std::string& projectDirectory)
+{
+    const aliceVision::sfmData::View& view = *camera.view;
+    const aliceVision::camera::IntrinsicBase* intrinsic =
+        sfmData.getIntrinsicPtr(view.getIntrinsicId());
+    const MMatrix matrix = getCameraMatrix(sfmData.getPose(view).getTransform());
+    MFnTransform fnTransform(camera.transform);
+    fnTransform.set(MTransformationMatrix(matrix));
+
+    const std::vector<double> params = intrinsic->getParams();
+    const double width = intrinsic->w();
+    const double height = intrinsic->h();
+    const double aperture = SENSOR_WIDTH_MM / MM_PER_INCH;
+    MFnCamera fnCamera(camera.shape);
+    fnCamera.setHorizontalFilmAperture(aperture);
+    fnCamera.setVerticalFilmAperture(aperture * height / width);
+    if(!params.empty())
+        fnCamera.setFocalLength(params[0] * SENSOR_WIDTH_MM / width);
+    fnCamera.setPanZoomEnabled(true);
+    fnCamera.setHorizontalFilmOffset(0.0);
+    fnCamera.setVerticalFilmOffset(0.0);
+
+    const MObject& node = camera.shape;
+    const int viewId = view.getViewId();
+    MVGMayaUtil::setIntAttribute(node, MVGCamera::_MVG_VIEW_ID, viewId);
+    MVGMayaUtil::setIntAttribute(node, MVGCamera::_MVG_INTRINSIC_ID, view.getIntrinsicId());
+    MVGMayaUtil::setStringAttribute(
+        node, MVGCamera::_MVG_INTRINSIC_TYPE,
+        aliceVision::camera::EINTRINSIC_enumToString(intrinsic->getType()).c_str());
+    MDoubleArray intrinsicParams;
+    for(size_t i = 0; i < params.size(); ++i)
+        intrinsicParams.append(params[i]);
+    MVGMayaUtil::setDoubleArrayAttribute(node, MVGCamera::_MVG_INTRINSICS_PARAMS,
+                                         intrinsicParams);
+    MIntArray sensorSize;
+    sensorSize.append(intrinsic->w());
+    sensorSize.append(intrinsic->h());
+    MVGMayaUtil::setIntArrayAttribute(node, MVGCamera::_MVG_SENSOR_SIZE, sensorSize);
+
+    const std::string& imagePath = view.getImagePath();
+    std::string proxyPath;
+    std::string thumbnailPath;
+    MVGCamera::getUndistortedImagePaths(projectDirectory, imagePath, viewId, proxyPath,
+                                        thumbnailPath);
+    MVGMayaUtil::setStringAttribute(node, MVGCamera::_MVG_IMAGE_SOURCE_PATH, imagePath.c_str());
+    MVGMayaUtil::setStringAttribute(node, MVGCamera::_MVG_IMAGE_PATH, proxyPath.c_str());
+    MVGMayaUtil::setStringAttribute(node, MVGCamera::_MVG_THUMBNAIL_PATH, thumbnailPath.c_str());
+
+    MIntArray items;
+    visibility.getCameraPoints(visibility.findCamera(viewId), items);
+    MVGMayaUtil::setIntArrayAttribute(node, MVGCamera::_MVG_ITEMS, items);
+}
+
+} // empty namespace
+
+MString MVGImportSfMCmd::_name("MVGImportSfMCmd");
+// static
+MVGVisibilityIndex MVGImportSfMCmd::_visibility;
+// static
+bool MVGImportSfMCmd::_hasVisibility = false;
+// static
+MObjectHandle MVGImportSfMCmd::_root;
+
+void* MVGImportSfMCmd::creator()
+{
+    return new MVGImportSfMCmd();
+}
+
+MSyntax MVGImportSfMCmd::newSyntax()
+{
+    MSyntax s;
+    s.addArg(MSyntax::kString);
+    s.enableEdit(false);
+    s.enableQuery(false);
+    return s;
+}
+
+MStatus MVGImportSfMCmd::doIt(const MArgList& args)
+{
+    MStatus status;
+    MArgDatabase argData(syntax(), args, &status);
+    CHECK_RETURN_STATUS(status)
+    MString filePath;
+    status = argData.getCommandArgument(0, filePath);
+    CHECK_RETURN_STATUS(status)
+
+    MDoubleArray timings;
+    MTimer timer;
+    timer.beginTimer();
+    _visibility.clear();
+    _hasVisibility = false;
+    _root = MObjectHandle();
+
+    // Read
+    aliceVision::sfmData::SfMData sfmData;
+    if(!aliceVision::sfmDataIO::Load(
+           sfmData, filePath.asChar(),
+           aliceVision::sfmDataIO::ESfMData(
+               aliceVision::sfmDataIO::VIEWS | aliceVision::sfmDataIO::INTRINSICS |
+               aliceVision::sfmDataIO::EXTRINSICS | aliceVision::sfmDataIO::STRUCTURE)))
+    {
+        LOG_ERROR("Unable to read SfM data from " << filePath)
+        return MS::kFailure;
+    }
+    std::vector<ImportedCamera> cameras;
+    for(aliceVision::sfmData::Views::const_iterator it = sfmData.getViews().begin();
+        it != sfmData.getViews().end(); ++it)
+    {
+        const aliceVision::sfmData::View* view = it->second.get();
+        if(!sfmData.isPoseAndIntrinsicDefined(view))
+            continue;
+        ImportedCamera camera;
+        camera.view = view;
+        cameras.push_back(camera);
+    }
+    if(cameras.empty())
+    {
+        LOG_ERROR("No reconstructed camera in " << filePath)
+        return MS::kFailure;
+    }
+    const aliceVision::sfmData::Landmarks& landmarks = sfmData.getLandmarks();
+    const int pointsCount = (int)landmarks.size();
+    timings.append(endTimer(timer));
+
+    const int pointsStepsCount = (pointsCount + POINTS_PER_STEP - 1) / POINTS_PER_STEP;
+    Progress progress(1 + (int)cameras.size() + pointsStepsCount);
+    progress.setStatus("Visibility");
+    if(progress.advance())
+        return MS::kSuccess;
+
+    // Visibility, stored in the point cloud attributes as written by the Alembic export
+    MPointArray positions(pointsCount);
+    MVectorArray colors(pointsCount);
+    MIntArray visibilitySizes(pointsCount);
+    int observationsCount = 0;
+    int p = 0;
+    for(aliceVision::sfmData::Landmarks::const_iterator it = landmarks.begin();
+        it != landmarks.end(); ++it, ++p)
+    {
+        const aliceVision::sfmData::Landmark& landmark = it->second;
+        positions[p] = MPoint(landmark.X(0), landmark.X(1), landmark.X(2));
+        colors[p] = MVector(landmark.rgb.r(), landmark.rgb.g(), landmark.rgb.b()) / 255.0;
+        visibilitySizes[p] = (int)landmark.observations.size();
+        observationsCount += visibilitySizes[p];
+    }
+    MIntArray visibilityViewIds(observationsCount);
+    int o = 0;
+    for(aliceVision::sfmData::Landmarks::const_iterator it = landmarks.begin();
+        it != landmarks.end(); ++it)
+    {
+        const aliceVision::sfmData::Observations& observations = it->second.observations;
+        for(aliceVision::sfmData::Observations::const_iterator obsIt = observations.begin();
+            obsIt != observations.end(); ++obsIt, ++o)
+            visibilityViewIds[o] = obsIt->first;
+    }
+    MVGVisibilityIndex visibility;
+    visibility.build(visibilitySizes, visibilityViewIds, 1);
+    timings.append(endTimer(timer));
+
+    // Nodes and dynamic attributes, in one batch
+    progress.setStatus("Nodes");
+    MObject root = _dagModifier.createNode("transform", MObject::kNullObj);
+    _dagModifier.renameNode(root, MVGProject::_PROJECT.c_str());
+    MObject camerasGroup = _dagModifier.createNode("transform", root);
+    _dagModifier.renameNode(camerasGroup, MVGProject::_CAMERAS_GROUP.c_str());
+    MObject cloudGroup = _dagModifier.createNode("transform", root);
+    _dagModifier.renameNode(cloudGroup, MVGProject::_CLOUD_GROUP.c_str());
+    for(size_t i = 0; i < cameras.size(); ++i)
+    {
+        const std::string name = "mvgCamera_" + std::to_string(cameras[i].view->getViewId());
+        cameras[i].transform = _dagModifier.createNode("transform", camerasGroup);
+        _dagModifier.renameNode(cameras[i].transform, name.c_str());
+        cameras[i].shape = _dagModifier.createNode("camera", cameras[i].transform);
+        _dagModifier.renameNode(cameras[i].shape, (name + "Shape").c_str());
+        addCameraAttributes(_dagModifier, cameras[i].shape);
+    }
+    MObject cloud = _dagModifier.createNode("transform", cloudGroup);
+    _dagModifier.renameNode(cloud, MVGProject::_CLOUD.c_str());
+    MObject cloudShape = _dagModifier.createNode("particle", cloud);
+    _dagModifier.renameNode(cloudShape, (MVGProject::_CLOUD + "Shape").c_str());
+    addTypedAttribute(_dagModifier, cloudShape, "rgbPP", "rgbPP", MFnData::kVectorArray);
+    addTypedAttribute(_dagModifier, cloudShape, "rgbPP0", "rgbPP0", MFnData::kVectorArray);
+    addTypedAttribute(_dagModifier, cloudShape, "mvg_visibilitySize", "mvgvs",
+                      MFnData::kIntArray);
+    addTypedAttribute(_dagModifier, cloudShape, "mvg_visibilityViewId", "mvgvv",
+                      MFnData::kIntArray);
+    status = _dagModifier.doIt();
+    CHECK_RETURN_STATUS(status)
+    _isUndoable = true;
+    timings.append(endTimer(timer));
+
+    // Cameras
+    progress.setStatus("Cameras");
+    const std::string projectDirectory = getDirectory(filePath.asChar());
+    for(size_t i = 0; i < cameras.size(); ++i)
+    {
+        setCamera(sfmData, cameras[i], visibility, projectDirectory);
+        if(progress.advance())
+        {
+            _dagModifier.undoIt();
+            _isUndoable = false;
+            LOG_WARNING("SfM import cancelled")
+            return MS::kSuccess;
+        }
+    }
+    timings.append(endTimer(timer));
+
+    // Point cloud
+    progress.setStatus("Point cloud");
+    MFnParticleSystem fnParticles(cloudShape);
+    for(int first = 0; first < pointsCount; first += POINTS_PER_STEP)
+    {
+        const int count = std::min(POINTS_PER_STEP, pointsCount - first);
+        MPointArray chunk(count);
+        for(int i = 0; i < count; ++i)
+            chunk[i] = positions[first + i];
+        fnParticles.emit(chunk);
+        if(progress.advance())
+        {
+            _dagModifier.undoIt();
+            _isUndoable = false;
+            LOG_WARNING("SfM import cancelled")
+            return MS::kSuccess;
+        }
+    }
+    fnParticles.setPerParticleAttribute("rgbPP", colors);
+    fnParticles.saveInitialState();
+    MVGMayaUtil::setIntArrayAttribute(cloudShape, "mvg_visibilitySize", visibilitySizes);
+    MVGMayaUtil::setIntArrayAttribute(cloudShape, "mvg_visibilityViewId", visibilityViewIds);
+    timings.append(endTimer(timer));
+
+    double totalTime = 0.0;
+    for(unsigned int i = 0; i < timings.length(); ++i)
+        totalTime += timings[i];
+    LOG_INFO("Imported " << cameras.size() << " cameras and " << pointsCount << " points ("
+                         << observationsCount << " observations) in " << totalTime
+                         << " s: read " << timings[0] << " s, visibility " << timings[1]
+                         << " s, nodes " << timings[2] << " s, cameras " << timings[3]
+                         << " s, point cloud " << timings[4] << " s")
+    _visibility.swap(visibility);
+    _hasVisibility = true;
+    _root = MObjectHandle(root);
+    setResult(timings);
+    return MS::kSuccess;
+}
+
+MStatus MVGImportSfMCmd::redoIt()
+{
+    return _dagModifier.doIt();
+}
+
+MStatus MVGImportSfMCmd::undoIt()
+{
+    return _dagModifier.undoIt();
+}
+
+// static
+bool MVGImportSfMCmd::canRead(const MString& filePath)
+{
+    const std::string extension = getExtension(filePath.asChar());
+    if(extension == ".sfm" || extension == ".json")
+        return true;
+#if ALICEVISION_IS_DEFINED(ALICEVISION_HAVE_ALEMBIC)
+    return extension == ".abc";
+#else
+    return false;
+#endif
+}
+
+// static
+bool MVGImportSfMCmd::takeVisibility(MVGVisibilityIndex& visibility)
+{
+    if(!_hasVisibility)
+        return false;
+    visibility.swap(_visibility);
+    // release the previous index of the caller
+    MVGVisibilityIndex previous;
+    _visibility.swap(previous);
+    _hasVisibility = false;
+    return true;
+}
+
+// static
+bool MVGImportSfMCmd::getRoot(MDagPath& root)
+{
+    if(!_root.isAlive() || !_root.isValid())
+        return false;
+    return MDagPath::getAPathTo(_root.object(), root);
+}
+
+} // namespace
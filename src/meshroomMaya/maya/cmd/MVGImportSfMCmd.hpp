@@ -0,0 +1,79 @@
+#pragma once
+
+#include "meshroomMaya/core/MVGVisibilityIndex.hpp"
+#include <maya/MDagModifier.h>
+#include <maya/MDagPath.h>
+#include <maya/MObjectHandle.h>
+#include <maya/MPxCommand.h>
+
+namespace meshroomMaya
+{
+
+/**
+ * @brief Import an SfM result (.abc, .sfm or .json) read with the AliceVision sfmDataIO.
+ *
+ * Creates the project hierarchy, one camera per reconstructed view with its MVG attributes and
+ * the point cloud with its visibility: all the nodes and dynamic attributes are added by a
+ * single MDagModifier, then filled directly. The progress is shown in the Maya progress window
+ * in interactive mode, where the import can be cancelled: the created nodes are then deleted
+ * and the result is empty. Otherwise the command returns the duration of each phase (read,
+ * visibility, nodes, cameras, point cloud), in seconds.
+ * The import is undoable: undo deletes the created nodes and redo restores them with their
+ * values. The project loaded in the MeshroomMaya window is not updated.
+ * The visibility index built by the import is kept for the caller (see takeVisibility), so that
+ * it does not have to be rebuilt from the point cloud attributes, as well as the created root
+ * node, which Maya renames if its name is already used.
+ * The image planes are created when the cameras are shown (see MVGCamera::acquireImagePlane).
+ */
+class MVGImportSfMCmd : public MPxCommand
+{
+
+public:
+    MVGImportSfMCmd()
+        : _isUndoable(false)
+    {
+    }
+    virtual ~MVGImportSfMCmd(){};
+
+    static void* creator();
+    static MSyntax newSyntax();
+    virtual bool hasSyntax() const { return true; }
+
+    virtual MStatus doIt(const MArgList& args);
+    virtual MStatus redoIt();
+    virtual MStatus undoIt();
+    virtual bool isUndoable() const { return _isUndoable; }
+
+    /**
+     * @return true if the extension of filePath is read by this command (.sfm, .json, and .abc
+     * if AliceVision is built with Alembic); the other Alembic files are left to AbcImport
+     */
+    static bool canRead(const MString& filePath);
+
+    /**
+     * @brief Move the visibility index of the last successful import to visibility.
+     * @return false if there is none, visibility is left unchanged then
+     */
+    static bool takeVisibility(MVGVisibilityIndex& visibility);
+    /**
+     * @brief Get the root node created by the last successful import.
+     * @return false if there is none or if it has been deleted
+     */
+    static bool getRoot(MDagPath& root);
+
+public:
+    static MString _name;
+
+private:
+    /// Creates all the nodes of the import, for undo and redo
+    MDagModifier _dagModifier;
+    /// false until the nodes are created, and for a cancelled import
+    bool _isUndoable;
+    /// Built by the last successful import, until it is taken
+    static MVGVisibilityIndex _visibility;
+    static bool _hasVisibility;
+    /// Root node of the last successful import
+    static MObjectHandle _root;
+};
+
+} // namespace
@@ -0,0 +1,325 @@
+#include "MVGRetriangulateCmd.hpp"
+#include "meshroomMaya/core/MVGCameraProjectionCache.hpp"
+#include "meshroomMaya/core/MVGGeometryUtil.hpp"
+#include "meshroomMaya/core/MVGMesh.hpp"
+#include "meshroomMaya/core/MVGLog.hpp"
+#include "meshroomMaya/maya/MVGMayaUtil.hpp"
+#include "meshroomMaya/maya/cmd/MVGEditCmd.hpp"
+#include "meshroomMaya/maya/context/MVGContextCmd.hpp"
+#include <maya/MArgList.h>
+#include <maya/MDoubleArray.h>
+#include <maya/MGlobal.h>
+#include <maya/MIntArray.h>
+#include <maya/MItSelectionList.h>
+#include <maya/MPointArray.h>
+#include <maya/MSelectionList.h>
+#include <maya/MSyntax.h>
+#include <maya/MThreadPool.h>
+#include <maya/MThreadUtils.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace meshroomMaya
+{
+
+namespace
+{ // empty namespace
+
+/// Minimum number of vertices triangulated by a worker task
+const size_t MIN_VERTICES_PER_TASK = 64;
+
+/**
+ * @brief Observations of the vertices to re-triangulate, flattened so that the worker threads
+ * do not access the Maya scene.
+ */
+struct TriangulationData
+{
+    /// one projection per observing camera
+    std::vector<aliceVision::Mat34> projections;
+    /// observations of vertex v are in [observationOffsets[v], observationOffsets[v + 1])
+    std::vector<size_t> observationOffsets;
+    std::vector<int> observationProjections;
+    std::vector<double> observationX;
+    std::vector<double> observationY;
+    // results, written by the tasks on disjoint vertex ranges
+    std::vector<MPoint> positions;
+    std::vector<double> errors;
+    std::vector<char> isTriangulated;
+};
+
+struct TriangulationTask
+{
+    TriangulationData* data;
+    size_t begin;
+    size_t end;
+};
+
+MThreadRetVal triangulateTask(void* taskData)
+{
+    const TriangulationTask* task = static_cast<const TriangulationTask*>(taskData);
+    TriangulationData& data = *task->data;
+    std::vector<aliceVision::Mat34> projections;
+    for(size_t v = task->begin; v < task->end; ++v)
+    {
+        const size_t firstObservation = data.observationOffsets[v];
+        const size_t count = data.observationOffsets[v + 1] - firstObservation;
+        aliceVision::Mat2X imagePoints(2, count);
+        projections.clear();
+        for(size_t i = 0; i < count; ++i)
+        {
+            const size_t o = firstObservation + i;
+            imagePoints.col(i) = aliceVision::Vec2(data.observationX[o], data.observationY[o]);
+            projections.push_back(data.projections[data.observationProjections[o]]);
+        }
+        MPoint position;
+        if(!MVGGeometryUtil::triangulatePoint(imagePoints, projections, position))
+            continue;
+        // RMS reprojection error, in pixels
+        const aliceVision::Vec4 X(position.x, position.y, position.z, 1.0);
+        double squaredError = 0.0;
+        for(size_t i = 0; i < count; ++i)
+        {
+            const aliceVision::Vec3 x = projections[i] * X;
+            squaredError += (x.head<2>() / x(2) - imagePoints.col(i)).squaredNorm();
+        }
+        data.positions[v] = position;
+        data.errors[v] = std::sqrt(squaredError / count);
+        data.isTriangulated[v] = 1;
+    }
+    return 0;
+}
+
+void createTriangulationTasks(void* tasksData, MThreadRootTask* root)
+{
+    std::vector<TriangulationTask>& tasks =
+        *static_cast<std::vector<TriangulationTask>*>(tasksData);
+    for(size_t i = 0; i < tasks.size(); ++i)
+        MThreadPool::createTask(triangulateTask, &tasks[i], root);
+    MThreadPool::executeAndJoin(root);
+}
+
+/// Selected meshes, or active meshes if no mesh is selected
+void getMeshesToTriangulate(std::vector<MDagPath>& meshPaths)
+{
+    MSelectionList list;
+    MGlobal::getActiveSelectionList(list);
+    MDagPath path;
+    for(MItSelectionList it(list); !it.isDone(); it.next())
+    {
+        if(!it.getDagPath(path) || !path.extendToShape() || path.apiType() != MFn::kMesh)
+            continue;
+        if(!MVGMesh(path).isValid())
+            continue;
+        if(std::find(meshPaths.begin(), meshPaths.end(), path) == meshPaths.end())
+            meshPaths.push_back(path);
+    }
+    if(!meshPaths.empty())
+        return;
+    const std::vector<MVGMesh> meshes = MVGMesh::listActiveMeshes();
+    for(std::vector<MVGMesh>::const_iterator it = meshes.begin(); it != meshes.end(); ++it)
+        meshPaths.push_back(it->getDagPath());
+}
+
+/// Patch the manipulator cache of the MeshroomMaya context, if it has been created
+void updateContextCache()
+{
+    if(!MVGMayaUtil::mvgContextExists())
+        return;
+    MString cmd;
+    cmd.format("^1s -e -update ^2s", MVGContextCmd::name, MVGContextCmd::instanceName);
+    MGlobal::executeCommand(cmd);
+}
+
+} // empty namespace
+
+MString MVGRetriangulateCmd::_name("MVGRetriangulateCmd");
+
+MVGRetriangulateCmd::~MVGRetriangulateCmd()
+{
+    for(size_t i = 0; i < _editCmds.size(); ++i)
+        delete _editCmds[i];
+}
+
+void* MVGRetriangulateCmd::creator()
+{
+    return new MVGRetriangulateCmd();
+}
+
+MSyntax MVGRetriangulateCmd::newSyntax()
+{
+    MSyntax s;
+    s.enableEdit(false);
+    s.enableQuery(false);
+    return s;
+}
+
+MStatus MVGRetriangulateCmd::doIt(const MArgList& args)
+{
+    std::vector<MDagPath> meshPaths;
+    getMeshesToTriangulate(meshPaths);
+
+    // Gather the observations of the vertices seen by at least two cameras
+    TriangulationData data;
+    std::vector<MIntArray> vertexIds(meshPaths.size());
+    std::map<int, int> cameraIdToProjection;
+    std::vector<const MVGCameraProjectionCache::Projection*> cameraProjections;
+    std::vector<int> blindDataOffsets;
+    std::vector<MVGMesh::ClickedCSPosition> blindData;
+    data.observationOffsets.push_back(0);
+    for(size_t m = 0; m < meshPaths.size(); ++m)
+    {
+        const MVGMesh mesh(meshPaths[m]);
+        if(!mesh.getAllBlindData(blindDataOffsets, blindData))
+            continue;
+        const int verticesCount = static_cast<int>(blindDataOffsets.size()) - 1;
+        for(int vertexId = 0; vertexId < verticesCount; ++vertexId)
+        {
+            if(blindDataOffsets[vertexId + 1] - blindDataOffsets[vertexId] < 2)
+                continue;
+            const size_t firstObservation = data.observationProjections.size();
+            for(int b = blindDataOffsets[vertexId]; b < blindDataOffsets[vertexId + 1]; ++b)
+            {
+                const MVGMesh::ClickedCSPosition& clickedCSPosition = blindData[b];
+                const int cameraId = clickedCSPosition.cameraId;
+                // projections are retrieved once per camera, -1 if the camera is not valid
+                std::map<int, int>::iterator projectionIt = cameraIdToProjection.find(cameraId);
+                if(projectionIt == cameraIdToProjection.end())
+                {
+                    const MVGCameraProjectionCache::Projection* projection =
+                        MVGCameraProjectionCache::get(cameraId);
+                    const int index = projection ? (int)cameraProjections.size() : -1;
+                    if(projection)
+                    {
+                        cameraProjections.push_back(projection);
+                        data.projections.push_back(projection->P);
+                    }
+                    projectionIt =
+                        cameraIdToProjection.insert(std::make_pair(cameraId, index)).first;
+                }
+                if(projectionIt->second < 0)
+                    continue;
+                const MVGCameraProjectionCache::Projection* projection =
+                    cameraProjections[projectionIt->second];
+                MPoint clickedISPosition;
+                projection->cameraToImageSpace(MPoint(clickedCSPosition.x, clickedCSPosition.y),
+                                               clickedISPosition);
+                data.observationProjections.push_back(projectionIt->second);
+                data.observationX.push_back(clickedISPosition.x);
+                data.observationY.push_back(clickedISPosition.y);
+            }
+            // cameras may have been removed since the vertex was placed
+            if(data.observationProjections.size() - firstObservation < 2)
+            {
+                data.observationProjections.resize(firstObservation);
+                data.observationX.resize(firstObservation);
+                data.observationY.resize(firstObservation);
+                continue;
+            }
+            data.observationOffsets.push_back(data.observationProjections.size());
+            vertexIds[m].append(vertexId);
+        }
+    }
+    const size_t verticesCount = data.observationOffsets.size() - 1;
+    if(verticesCount == 0)
+    {
+        LOG_WARNING("No vertex observed by at least two cameras")
+        return MS::kSuccess;
+    }
+    data.positions.resize(verticesCount);
+    data.errors.assign(verticesCount, 0.0);
+    data.isTriangulated.assign(verticesCount, 0);
+
+    // Triangulate in parallel
+    const size_t maxTasksCount = 4 * std::max(MThreadUtils::getNumThreads(), 1);
+    const size_t tasksCount = std::max<size_t>(
+        1, std::min(maxTasksCount, verticesCount / MIN_VERTICES_PER_TASK));
+    std::vector<TriangulationTask> tasks(tasksCount);
+    for(size_t i = 0; i < tasksCount; ++i)
+    {
+        tasks[i].data = &data;
+        tasks[i].begin = verticesCount * i / tasksCount;
+        tasks[i].end = verticesCount * (i + 1) / tasksCount;
+    }
+    MStatus status = MThreadPool::init();
+    CHECK_RETURN_STATUS(status)
+    MThreadPool::newParallelRegion(createTriangulationTasks, &tasks);
+    MThreadPool::release();
+
+    // Apply the new positions, one move per mesh
+    MDoubleArray errors;
+    double maxError = 0.0;
+    size_t v = 0;
+    for(size_t m = 0; m < meshPaths.size(); ++m)
+    {
+        MIntArray movedIds;
+        MPointArray movedPositions;
+        for(unsigned int i = 0; i < vertexIds[m].length(); ++i, ++v)
+        {
+            if(!data.isTriangulated[v])
+                continue;
+            movedIds.append(vertexIds[m][i]);
+            movedPositions.append(data.positions[v]);
+            errors.append(data.errors[v]);
+            maxError = std::max(maxError, data.errors[v]);
+        }
+        if(movedIds.length() == 0)
+            continue;
+        // The edit commands are owned by this command, which undoes, redoes and deletes them:
+        // they are not registered in the undo queue themselves (no finalize)
+        MVGEditCmd* cmd = new MVGEditCmd();
+        // no camera positions: the blind data are kept
+        cmd->move(meshPaths[m], movedIds, movedPositions, MPointArray(), -1);
+        MArgList editArgs;
+        if(!cmd->doIt(editArgs))
+        {
+            LOG_ERROR("Unable to move vertices of " << meshPaths[m].fullPathName())
+            delete cmd;
+            continue;
+        }
+        _editCmds.push_back(cmd);
+    }
+
+    double meanError = 0.0;
+    for(unsigned int i = 0; i < errors.length(); ++i)
+        meanError += errors[i];
+    if(errors.length() > 0)
+        meanError /= errors.length();
+    LOG_INFO("Re-triangulated " << errors.length() << " vertices on " << _editCmds.size()
+                                << " mesh(es): mean reprojection error " << meanError
+                                << " px, max " << maxError << " px")
+    setResult(errors);
+    updateContextCache();
+    return MS::kSuccess;
+}
+
+MStatus MVGRetriangulateCmd::redoIt()
+{
+    MStatus status;
+    for(size_t i = 0; i < _editCmds.size(); ++i)
+    {
+        status = _editCmds[i]->redoIt();
+        CHECK_RETURN_STATUS(status)
+    }
+    updateContextCache();
+    return status;
+}
+
+MStatus MVGRetriangulateCmd::undoIt()
+{
+    MStatus status;
+    for(size_t i = _editCmds.size(); i > 0; --i)
+    {
+        status = _editCmds[i - 1]->undoIt();
+        CHECK_RETURN_STATUS(status)
+    }
+    updateContextCache();
+    return status;
+}
+
+bool MVGRetriangulateCmd::isUndoable() const
+{
+    return !_editCmds.empty();
+}
+
+} // namespace
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <maya/MPxCommand.h>
+#include <vector>
+
+namespace meshroomMaya
+{
+
+class MVGEditCmd;
+
+/**
+ * @brief Re-triangulate all the observed vertices of the selected meshes (or of the active
+ * meshes if no mesh is selected).
+ *
+ * Every vertex with at least two clicked positions in its blind data is triangulated again from
+ * the current cameras, e.g. after a new SfM has been loaded. The triangulations are spread over
+ * the Maya thread pool; the new positions are applied with one MVGEditCmd move per mesh,
+ * undone and redone as a whole. The command returns the RMS reprojection error, in pixels, of
+ * each moved vertex.
+ */
+class MVGRetriangulateCmd : public MPxCommand
+{
+
+public:
+    MVGRetriangulateCmd(){};
+    virtual ~MVGRetriangulateCmd();
+
+    static void* creator();
+    static MSyntax newSyntax();
+    virtual bool hasSyntax() const { return true; }
+
+    virtual MStatus doIt(const MArgList& args);
+    virtual MStatus redoIt();
+    virtual MStatus undoIt();
+    virtual bool isUndoable() const;
+
+public:
+    static MString _name;
+
+private:
+    std::vector<MVGEditCmd*> _editCmds;
+};
+
+} // namespace
@@ -0,0 +1,370 @@
+#include "meshroomMaya/maya/context/MVGAsyncPreview.hpp"
+#include "meshroomMaya/core/MVGCamera.hpp"
+#include "meshroomMaya/core/MVGPointCloud.hpp"
+#include "meshroomMaya/core/MVGProject.hpp"
+#include "meshroomMaya/core/MVGRansac.hpp"
+#include "meshroomMaya/qt/MVGQt.hpp"
+#include <maya/MSpinLock.h>
+#include <maya/MTimer.h>
+#include <QThread>
+#include <algorithm>
+
+namespace meshroomMaya
+{
+
+namespace
+{ // empty namespace
+
+/// Weight of the last job in the rolling average of the computation time
+const double LATENCY_SMOOTHING = 0.2;
+/// Enough items for the plane fits of small polygons
+const size_t MIN_SAMPLED_ITEMS = 2000;
+
+bool isSamePointArray(const MPointArray& a, const MPointArray& b)
+{
+    if(a.length() != b.length())
+        return false;
+    for(unsigned int i = 0; i < a.length(); ++i)
+    {
+        if(a[i] != b[i])
+            return false;
+    }
+    return true;
+}
+
+/// Tag the result with the component of its request; it is not pending anymore
+void setComponent(const MVGAsyncPreview::Request& request, MVGAsyncPreview::Result& result)
+{
+    result.isPending = false;
+    result.meshPath = request.meshPath;
+    result.componentType = request.componentType;
+    result.componentIndex = request.componentIndex;
+    result.faceIndex = request.faceIndex;
+}
+
+bool isSameComponent(const MVGAsyncPreview::Request& request,
+                     const MVGAsyncPreview::Result& result)
+{
+    return request.meshPath == result.meshPath && request.componentType == result.componentType &&
+           request.componentIndex == result.componentIndex &&
+           request.faceIndex == result.faceIndex;
+}
+
+/// Enclosure and projection are invariant to the view zoom and pan: only the camera matters
+bool isSameRequest(const MVGAsyncPreview::Request& a, const MVGAsyncPreview::Request& b)
+{
+    return a.projection.getCameraPath() == b.projection.getCameraPath() &&
+           a.meshPath == b.meshPath && a.componentType == b.componentType &&
+           a.componentIndex == b.componentIndex && a.faceIndex == b.faceIndex &&
+           a.mouseCSPoint == b.mouseCSPoint && isSamePointArray(a.faceCSPoints, b.faceCSPoints) &&
+           isSamePointArray(a.constraintWSPoints, b.constraintWSPoints);
+}
+
+} // empty namespace
+
+struct MVGAsyncPreview::Job
+{
+    Job(MVGAsyncPreview* preview, const Request& request)
+        : preview(preview)
+        , request(request)
+        , isSampled(false)
+        , itemsCount(0)
+        , milliseconds(0.0)
+        , isDone(false)
+    {
+    }
+    MVGAsyncPreview* preview;
+    const Request request;
+    bool isSampled;
+    /// items processed by the worker, all the visible ones too if the sampled ones were not enough
+    size_t itemsCount;
+    Result result;
+    /// computation time, measured by the worker
+    double milliseconds;
+    /// protects isDone
+    MSpinLock lock;
+    bool isDone;
+};
+
+// static
+double MVGAsyncPreview::_latencyBudget = 8.0;
+
+MVGAsyncPreview::MVGAsyncPreview()
+    : _isSampling(false)
+    , _averageItemLatency(0.0)
+    , _pendingJob(NULL)
+    , _runningJob(NULL)
+    , _lastRequest(NULL)
+{
+}
+
+MVGAsyncPreview::~MVGAsyncPreview()
+{
+    // the running job uses the items, the grid and the plane estimator
+    cancelPendingJob();
+    wait();
+}
+
+void MVGAsyncPreview::setVisibleItems(const MVGCamera& camera)
+{
+    cancelPendingJob();
+    wait();
+    camera.getVisibleItems(_visibleItems);
+    _visibleItemsGrid.clear();
+    _sampledItems.clear();
+    _sampledItemsGrid.clear();
+    _isSampling = false;
+}
+
+void MVGAsyncPreview::reset()
+{
+    cancelPendingJob();
+    wait();
+    _planeEstimator.reset();
+    _result = Result();
+}
+
+void MVGAsyncPreview::submit(const Request& request)
+{
+    if(_lastRequest && isSameRequest(*_lastRequest, request))
+    {
+        update();
+        return;
+    }
+    cancelPendingJob();
+    _lastRequest = new Request(request);
+    _pendingJob = new Job(this, request);
+    update();
+}
+
+MVGAsyncPreview::Result MVGAsyncPreview::getResult(const Request& request)
+{
+    update();
+    if(_result.isPending || !isSameComponent(request, _result))
+        return Result();
+    return _result;
+}
+
+bool MVGAsyncPreview::isBusy()
+{
+    update();
+    return _runningJob || _pendingJob;
+}
+
+bool MVGAsyncPreview::compute(const Request& request, Result& result)
+{
+    cancelPendingJob();
+    wait();
+    result = Result();
+    setComponent(request, result);
+    if(MVGPointCloud(MVGProject::_CLOUD).isValid())
+        run(request, result, false);
+    _result = result;
+    return result.isValid;
+}
+
+/**
+ * @brief Collect the running job if it is finished, then start the pending one. Main thread only.
+ */
+void MVGAsyncPreview::update()
+{
+    if(collectRunningJob())
+        startPendingJob();
+}
+
+/**
+ * @return true if no job is running anymore
+ */
+bool MVGAsyncPreview::collectRunningJob()
+{
+    if(!_runningJob)
+        return true;
+    _runningJob->lock.lock();
+    const bool isDone = _runningJob->isDone;
+    _runningJob->lock.unlock();
+    if(!isDone)
+        return false;
+    updateLatency(*_runningJob);
+    _result = _runningJob->result;
+    delete _runningJob;
+    _runningJob = NULL;
+    MThreadAsync::release();
+    return true;
+}
+
+void MVGAsyncPreview::startPendingJob()
+{
+    if(!_pendingJob)
+        return;
+    Job* job = _pendingJob;
+    _pendingJob = NULL;
+    // the point cloud node is read in the main thread only
+    if(!MVGPointCloud(MVGProject::_CLOUD).isValid())
+    {
+        _result = Result();
+        setComponent(job->request, _result);
+        delete job;
+        return;
+    }
+    updateSampling(job->request.projection);
+    job->isSampled = _isSampling;
+    MStatus status = MThreadAsync::init();
+    if(status)
+    {
+        _runningJob = job;
+        status = MThreadAsync::createTask(previewTask, job, previewTaskDone, job);
+        if(status)
+            return;
+        _runningJob = NULL;
+        MThreadAsync::release();
+    }
+    // no worker: compute in the main thread
+    run(job->request, job->result, job->isSampled);
+    _result = job->result;
+    delete job;
+}
+
+/// The pending request is outdated: it is dropped without being computed
+void MVGAsyncPreview::cancelPendingJob()
+{
+    delete _pendingJob;
+    _pendingJob = NULL;
+    delete _lastRequest;
+    _lastRequest = NULL;
+}
+
+void MVGAsyncPreview::wait()
+{
+    while(!collectRunningJob())
+        QThread::yieldCurrentThread();
+}
+
+/**
+ * @return the number of items processed, including the fallback to all the visible items
+ */
+size_t MVGAsyncPreview::run(const Request& request, Result& result, const bool isSampled)
+{
+    setComponent(request, result);
+    const std::vector<MVGPointCloudItem>& items = isSampled ? _sampledItems : _visibleItems;
+    MVGPointCloudGrid& grid = isSampled ? _sampledItemsGrid : _visibleItemsGrid;
+    // never the static members: they may be changed in the main thread
+    _planeEstimator.setSettings(request.planeEstimation);
+    if(request.constraintWSPoints.length() == 0)
+    {
+        result.isValid = MVGPointCloud::projectPointsOnItems(request.projection, items, grid,
+                                                             _planeEstimator, request.faceCSPoints,
+                                                             result.faceWSPoints);
+    }
+    else
+    {
+        result.isValid = MVGPointCloud::projectPointOnItemsWithLineConstraint(
+            request.projection, items, grid, _planeEstimator, request.faceCSPoints,
+            request.constraintWSPoints, request.mouseCSPoint, result.mouseWSPoint);
+    }
+    // small polygons may not enclose enough sampled items
+    if(isSampled && !result.isValid)
+        return items.size() + run(request, result, false);
+    return items.size();
+}
+
+/**
+ * @brief Add the computation time of a finished job to the rolling average. Main thread only.
+ */
+void MVGAsyncPreview::updateLatency(const Job& job)
+{
+    if(job.itemsCount == 0)
+        return;
+    const double itemLatency = job.milliseconds / job.itemsCount;
+    if(_averageItemLatency <= 0.0)
+        _averageItemLatency = itemLatency;
+    else
+        _averageItemLatency += LATENCY_SMOOTHING * (itemLatency - _averageItemLatency);
+}
+
+/**
+ * @brief Choose the items of the next job from the average computation time. Main thread only.
+ * The plane estimator is reset when the items change, its state referring to item indexes.
+ */
+void MVGAsyncPreview::updateSampling(const MVGProjectionSnapshot& projection)
+{
+    size_t targetCount = _visibleItems.size();
+    if(_latencyBudget > 0.0 && _averageItemLatency > 0.0)
+        targetCount = std::min(targetCount, (size_t)(_latencyBudget / _averageItemLatency));
+    size_t slotsCount = 0;
+    if(targetCount < _visibleItems.size() && _visibleItems.size() > MIN_SAMPLED_ITEMS)
+    {
+        _visibleItemsGrid.update(projection, _visibleItems);
+        slotsCount = static_cast<size_t>(_visibleItemsGrid.getSlotsCount());
+    }
+    // within the budget, or no item in the view to sample from
+    if(slotsCount == 0)
+    {
+        if(!_isSampling)
+            return;
+        _isSampling = false;
+        _planeEstimator.reset();
+        return;
+    }
+    // at most one item per slot, so that the subset below is kept
+    targetCount = std::min(std::max(targetCount, MIN_SAMPLED_ITEMS), slotsCount);
+    // keep the current subset while its size stays within 25% of the target
+    const size_t sampledCount = _sampledItems.size();
+    if(_isSampling && 4 * targetCount >= 3 * sampledCount && 4 * targetCount <= 5 * sampledCount)
+        return;
+    sampleItems(projection, targetCount);
+    _isSampling = true;
+    _planeEstimator.reset();
+}
+
+/**
+ * @brief Stratified random sampling of the visible items.
+ *
+ * The slots of the view space grid are ordered cell after cell: one item is drawn at random in
+ * each run of consecutive slots, so that every region of the view keeps the same proportion of
+ * its items and the plane fits see the same distribution as with all the items. All the slots
+ * are taken when there are fewer than count.
+ */
+void MVGAsyncPreview::sampleItems(const MVGProjectionSnapshot& projection, const size_t count)
+{
+    _visibleItemsGrid.update(projection, _visibleItems);
+    const size_t slotsCount = static_cast<size_t>(_visibleItemsGrid.getSlotsCount());
+    _sampledItems.clear();
+    _sampledItemsGrid.clear();
+    const size_t sampledCount = std::min(count, slotsCount);
+    if(sampledCount == 0)
+        return;
+    _sampledItems.reserve(sampledCount);
+    // deterministic, so that a given subset size always gives the same items
+    ransac::Sampler sampler(static_cast<unsigned int>(sampledCount));
+    for(size_t i = 0; i < sampledCount; ++i)
+    {
+        // sampledCount <= slotsCount: every run has at least one slot
+        const size_t firstSlot = i * slotsCount / sampledCount;
+        const size_t lastSlot = (i + 1) * slotsCount / sampledCount;
+        const size_t slot = firstSlot + sampler(lastSlot - firstSlot);
+        _sampledItems.push_back(_visibleItems[_visibleItemsGrid.getItemIndex(slot)]);
+    }
+}
+
+// static
+MThreadRetVal MVGAsyncPreview::previewTask(void* data)
+{
+    Job* job = static_cast<Job*>(data);
+    MTimer timer;
+    timer.beginTimer();
+    job->itemsCount = job->preview->run(job->request, job->result, job->isSampled);
+    timer.endTimer();
+    job->milliseconds = timer.elapsedTime() * 1000.0;
+    return 0;
+}
+
+// static
+void MVGAsyncPreview::previewTaskDone(void* data)
+{
+    Job* job = static_cast<Job*>(data);
+    job->lock.lock();
+    job->isDone = true;
+    job->lock.unlock();
+}
+
+} // namespace
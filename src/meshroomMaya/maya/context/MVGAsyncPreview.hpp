@@ -0,0 +1,146 @@
+#pragma once
+
+#include "meshroomMaya/core/MVGGeometryUtil.hpp"
+#include "meshroomMaya/core/MVGIncrementalPlaneEstimator.hpp"
+#include "meshroomMaya/core/MVGPointCloudGrid.hpp"
+#include "meshroomMaya/core/MVGPointCloudItem.hpp"
+#include "meshroomMaya/core/MVGProjectionSnapshot.hpp"
+#include <maya/MDagPath.h>
+#include <maya/MPointArray.h>
+#include <maya/MThreadAsync.h>
+#include <vector>
+
+namespace meshroomMaya
+{
+
+class MVGCamera;
+
+/**
+ * @brief Point cloud projections of the manipulators preview, computed on a worker thread.
+ *
+ * Requests only hold data read from the Maya scene in the main thread, including the plane
+ * estimation settings. A single job slot is kept (latest wins): a request submitted while the
+ * worker is busy replaces the pending one, which is cancelled, and the manipulators draw the
+ * most recent finished result of the component they move.
+ * The visible items, their view space grid and the incremental plane estimator belong to the
+ * worker while a job is running: every other access waits for the running job first.
+ *
+ * The computation time of the jobs is measured: when the previews would exceed the latency
+ * budget, they are computed on a stratified random subset of the visible items, sized to fit
+ * in the budget. compute(), used before committing an edit, always uses all the visible items.
+ */
+class MVGAsyncPreview
+{
+public:
+    struct Request
+    {
+        explicit Request(const MVGProjectionSnapshot& projection)
+            : projection(projection)
+            , componentType(MFn::kInvalid)
+            , componentIndex(-1)
+            , faceIndex(-1)
+        {
+        }
+        MVGProjectionSnapshot projection;
+        /// taken when the request is created, in the main thread
+        MVGGeometryUtil::PlaneEstimationSettings planeEstimation;
+        /// moved component: the results of the requests of other components are not returned
+        MDagPath meshPath;
+        MFn::Type componentType;
+        int componentIndex;
+        /// face projected on the point cloud
+        int faceIndex;
+        /// polygon to project on the point cloud, in camera space
+        MPointArray faceCSPoints;
+        /// two world space points of a line contained by the plane, empty if not constrained
+        MPointArray constraintWSPoints;
+        /// camera space point projected on the line constrained plane
+        MPoint mouseCSPoint;
+    };
+
+    struct Result
+    {
+        Result()
+            : isValid(false)
+            , isPending(true)
+            , componentType(MFn::kInvalid)
+            , componentIndex(-1)
+            , faceIndex(-1)
+        {
+        }
+        bool isValid;
+        /// no result of the requested component is finished yet: the previous preview can be
+        /// kept on screen
+        bool isPending;
+        /// component of the request, see Request
+        MDagPath meshPath;
+        MFn::Type componentType;
+        int componentIndex;
+        int faceIndex;
+        /// projected polygon, if not line constrained
+        MPointArray faceWSPoints;
+        /// projected mouse point, if line constrained
+        MPoint mouseWSPoint;
+    };
+
+public:
+    MVGAsyncPreview();
+    ~MVGAsyncPreview();
+
+public:
+    /// Items of the camera the next requests are projected on
+    void setVisibleItems(const MVGCamera& camera);
+    /// Forget the pending request, the last result and the previous plane; called on press
+    void reset();
+    /// Queue the request on the worker, unless it is the last submitted one
+    void submit(const Request& request);
+    /// Most recent finished result of the component of the request, pending if there is none
+    Result getResult(const Request& request);
+    /// Whether a submitted request is not finished yet
+    bool isBusy();
+    /**
+     * @brief Compute the request in the calling thread, after the running job.
+     * @return false if the points could not be projected
+     */
+    bool compute(const Request& request, Result& result);
+
+private:
+    struct Job;
+
+private:
+    void update();
+    bool collectRunningJob();
+    void startPendingJob();
+    void cancelPendingJob();
+    void wait();
+    size_t run(const Request& request, Result& result, const bool isSampled);
+    void updateLatency(const Job& job);
+    void updateSampling(const MVGProjectionSnapshot& projection);
+    void sampleItems(const MVGProjectionSnapshot& projection, const size_t count);
+
+private:
+    static MThreadRetVal previewTask(void* data);
+    static void previewTaskDone(void* data);
+
+public:
+    /// preview computation time budget, in milliseconds; the subsampling is disabled if <= 0
+    static double _latencyBudget;
+
+private:
+    std::vector<MVGPointCloudItem> _visibleItems;
+    MVGPointCloudGrid _visibleItemsGrid;
+    MVGIncrementalPlaneEstimator _planeEstimator;
+    /// subset of the visible items used by the previews when over the latency budget
+    std::vector<MVGPointCloudItem> _sampledItems;
+    MVGPointCloudGrid _sampledItemsGrid;
+    bool _isSampling;
+    /// rolling average of the preview computation time per item, in milliseconds
+    double _averageItemLatency;
+    Job* _pendingJob;
+    Job* _runningJob;
+    /// last submitted request, to avoid computing it again while polling for its result
+    Request* _lastRequest;
+    Result _result;
+};
+
+} // namespace
@@ -9,6 +9,7 @@
 #include <maya/MArgList.h>
 #include <maya/MGlobal.h>
 #include <QWidget>
+#include <cmath>
 
 namespace meshroomMaya
 {
@@ -20,6 +21,8 @@ MVGContext::MVGContext()
     , _filterLV((QObject*)MVGMayaUtil::getMVGViewportLayout("mvgLPanel"), this)
     , _filterRV((QObject*)MVGMayaUtil::getMVGViewportLayout("mvgRPanel"), this)
     , _editMode(eEditModeMove)
+    , _inputCoalescer(this)
+    , _pendingManipulator(NULL)
 {
     setTitleString("MVG tool");
 }
@@ -31,6 +34,7 @@ void MVGContext::toolOnSetup(MEvent& event)
 
 void MVGContext::toolOffCleanup()
 {
+    _inputCoalescer.flush();
     deleteManipulators();
     MPxContext::toolOffCleanup();
 }
@@ -113,7 +117,7 @@ bool MVGContext::eventFilter(QObject* obj, QEvent* e)
                     if(cmd)
                     {
                         MIntArray componentId;
-                        componentId.append(selectedComponent.vertex->index);
+                        componentId.append(selectedComponent.vertex.index);
                         MDagPath meshPath = selectedComponent.meshPath;
 
                         cmd->clearBD(meshPath, componentId);
@@ -121,7 +125,7 @@ bool MVGContext::eventFilter(QObject* obj, QEvent* e)
                         if(cmd->doIt(args))
                         {
                             cmd->finalize();
-                            _manipulatorCache.rebuildMeshesCache();
+                            _manipulatorCache.updateDirtyMeshes();
                             _manipulatorCache.clearSelectedComponent();
                         }
                         break;
@@ -174,23 +178,21 @@ bool MVGContext::eventFilter(QObject* obj, QEvent* e)
     {
         if(widget && _eventData.isDragging && _eventData.cameraPath.isValid())
         {
-            MVGCamera camera(_eventData.cameraPath);
-            // compute pan offset
+            // the pan is applied on the next input processing
             QMouseEvent* mouseevent = static_cast<QMouseEvent*>(e);
             if(!mouseevent)
                 return false;
-            QPointF offset_screen = _eventData.onPressMousePos - mouseevent->localPos();
-            const double viewport_width = widget->width();
-            QPointF offset = (offset_screen / viewport_width) * camera.getHorizontalFilmAperture() *
-                             camera.getZoom();
-            camera.setPan(_eventData.onPressCameraHPan + offset.x(),
-                          _eventData.onPressCameraVPan - offset.y());
+            _eventData.panMousePos = mouseevent->localPos();
+            _eventData.viewportWidth = widget->width();
+            _eventData.isPanPending = true;
+            _inputCoalescer.request();
             return true;
         }
     }
     // mouse button released
     else if(e->type() == QEvent::MouseButtonRelease)
     {
+        _inputCoalescer.flush();
         _eventData.isDragging = false;
     }
     // mouse wheel rolled
@@ -198,32 +200,19 @@ bool MVGContext::eventFilter(QObject* obj, QEvent* e)
     {
         if(widget && _eventData.cameraPath.isValid())
         {
-            // compute & set zoom value
-            QMouseEvent* mouseevent = static_cast<QMouseEvent*>(e);
+            // the zoom steps are accumulated until the next input processing
             QWheelEvent* wheelevent = static_cast<QWheelEvent*>(e);
-            MVGCamera camera(_eventData.cameraPath);
-            const double viewportWidth = widget->width();
-            const double viewportHeight = widget->height();
-            static const double wheelStep = 1.15;
-            const double previousZoom = camera.getZoom();
-            double newZoom =
-                wheelevent->delta() > 0 ? previousZoom / wheelStep : previousZoom * wheelStep;
-            camera.setZoom(std::max(newZoom, 0.0001));
-            const double scaleRatio = newZoom / previousZoom;
-            // compute & set pan offset
-            QPointF center_ratio(0.5, 0.5 * viewportHeight / viewportWidth);
-            QPointF mouse_ratio_center = (center_ratio - (mouseevent->localPos() / viewportWidth));
-            QPointF mouse_maya_center =
-                mouse_ratio_center * camera.getHorizontalFilmAperture() * previousZoom;
-            QPointF mouseAfterZoo_maya_center = mouse_maya_center * scaleRatio;
-            QPointF offset = mouse_maya_center - mouseAfterZoo_maya_center;
-            camera.setPan(camera.getHorizontalPan() - offset.x(),
-                          camera.getVerticalPan() + offset.y());
+            _eventData.wheelSteps += wheelevent->delta() > 0 ? 1 : -1;
+            _eventData.wheelMousePos = wheelevent->posF();
+            _eventData.viewportWidth = widget->width();
+            _eventData.viewportHeight = widget->height();
+            _inputCoalescer.request();
             return true;
         }
     }
     else if(e->type() == QEvent::Leave)
     {
+        _inputCoalescer.flush();
         _eventData.cameraPath = MDagPath();
 
         // Update and retrieve last manipulator
@@ -262,6 +251,9 @@ bool MVGContext::setFocusOnView(QObject* obj)
     if(!panelName.isValid())
         return false;
 
+    // the pending input applies to the previous camera
+    _inputCoalescer.flush();
+
     // find & register the associated camera path
     MVGMayaUtil::getCameraInView(_eventData.cameraPath, MQtUtil::toMString(panelName.toString()));
     if(!_eventData.cameraPath.isValid())
@@ -278,4 +270,74 @@ MVGEditCmd* MVGContext::newCmd()
     return (MVGEditCmd*)newToolCommand();
 }
 
+void MVGContext::requestManipulatorInput(MVGManipulator* manipulator)
+{
+    if(_pendingManipulator && _pendingManipulator != manipulator)
+        _inputCoalescer.flush();
+    _pendingManipulator = manipulator;
+    _inputCoalescer.request();
+}
+
+void MVGContext::cancelManipulatorInput(MVGManipulator* manipulator)
+{
+    if(_pendingManipulator == manipulator)
+        _pendingManipulator = NULL;
+}
+
+/**
+ * @brief Apply the latest pointer and wheel state: camera pan, camera zoom and the pending
+ * manipulator computation, then redraw the active view once.
+ */
+void MVGContext::processInput()
+{
+    if(_eventData.cameraPath.isValid() && (_eventData.isPanPending || _eventData.wheelSteps))
+    {
+        MVGCamera camera(_eventData.cameraPath);
+        if(_eventData.isPanPending)
+            applyPan(camera);
+        if(_eventData.wheelSteps != 0)
+            applyZoom(camera);
+    }
+    _eventData.isPanPending = false;
+    _eventData.wheelSteps = 0;
+
+    if(!_pendingManipulator)
+        return;
+    MVGManipulator* manipulator = _pendingManipulator;
+    _pendingManipulator = NULL;
+    manipulator->processInput();
+    _manipulatorCache.getActiveView().refresh(false, true);
+}
+
+void MVGContext::applyPan(MVGCamera& camera)
+{
+    // compute pan offset
+    QPointF offset_screen = _eventData.onPressMousePos - _eventData.panMousePos;
+    QPointF offset = (offset_screen / _eventData.viewportWidth) *
+                     camera.getHorizontalFilmAperture() * camera.getZoom();
+    camera.setPan(_eventData.onPressCameraHPan + offset.x(),
+                  _eventData.onPressCameraVPan - offset.y());
+}
+
+void MVGContext::applyZoom(MVGCamera& camera)
+{
+    // compute & set zoom value, one wheel step at a time
+    static const double wheelStep = 1.15;
+    const double viewportWidth = _eventData.viewportWidth;
+    const double viewportHeight = _eventData.viewportHeight;
+    const double previousZoom = camera.getZoom();
+    const double newZoom =
+        std::max(previousZoom * std::pow(wheelStep, -_eventData.wheelSteps), 0.0001);
+    camera.setZoom(newZoom);
+    const double scaleRatio = newZoom / previousZoom;
+    // compute & set pan offset, keeping the point under the mouse in place
+    QPointF center_ratio(0.5, 0.5 * viewportHeight / viewportWidth);
+    QPointF mouse_ratio_center = (center_ratio - (_eventData.wheelMousePos / viewportWidth));
+    QPointF mouse_maya_center =
+        mouse_ratio_center * camera.getHorizontalFilmAperture() * previousZoom;
+    QPointF mouseAfterZoo_maya_center = mouse_maya_center * scaleRatio;
+    QPointF offset = mouse_maya_center - mouseAfterZoo_maya_center;
+    camera.setPan(camera.getHorizontalPan() - offset.x(), camera.getVerticalPan() + offset.y());
+}
+
 } // namespace
@@ -2,6 +2,7 @@
 
 #include "meshroomMaya/maya/context/MVGManipulatorCache.hpp"
 #include "meshroomMaya/qt/MVGEventFilter.hpp"
+#include "meshroomMaya/qt/MVGInputCoalescer.hpp"
 #include <maya/MPxContext.h>
 #include <maya/MDagPath.h>
 
@@ -14,6 +15,10 @@ struct EventData
         : onPressCameraHPan(0)
         , onPressCameraVPan(0)
         , isDragging(false)
+        , isPanPending(false)
+        , viewportWidth(0.0)
+        , viewportHeight(0.0)
+        , wheelSteps(0)
     {
     }
     MDagPath cameraPath;
@@ -21,12 +26,20 @@ struct EventData
     double onPressCameraHPan;
     double onPressCameraVPan;
     bool isDragging;
+    // latest input state, applied once per display refresh
+    bool isPanPending;
+    QPointF panMousePos;
+    double viewportWidth;
+    double viewportHeight;
+    int wheelSteps; // zoom in steps minus zoom out steps
+    QPointF wheelMousePos;
 };
 
 namespace meshroomMaya
 {
 
 class MVGEditCmd;
+class MVGManipulator;
 
 class MVGContext : public MPxContext
 {
@@ -50,6 +63,15 @@ public:
     bool eventFilter(QObject* obj, QEvent* e);
     MVGEditCmd* newCmd();
 
+public:
+    /// Run processInput() of the manipulator on the next input processing
+    void requestManipulatorInput(MVGManipulator* manipulator);
+    void cancelManipulatorInput(MVGManipulator* manipulator);
+    /// Apply the pending input now
+    void flushInput() { _inputCoalescer.flush(); }
+    void processInput();
+    int getDroppedEventsCount() const { return _inputCoalescer.getDroppedEventsCount(); }
+
 public:
     MVGManipulatorCache& getCache() { return _manipulatorCache; }
     const EEditMode& getEditMode() const { return _editMode; }
@@ -57,6 +79,8 @@ public:
 
 private:
     bool setFocusOnView(QObject* obj);
+    void applyPan(MVGCamera& camera);
+    void applyZoom(MVGCamera& camera);
 
 public:
     static MString _lastMVGManipulator;
@@ -69,6 +93,8 @@ private:
     MVGEventFilter<MVGContext> _filterRV;
     EEditMode _editMode;
     MVGManipulatorCache _manipulatorCache;
+    MVGInputCoalescer<MVGContext> _inputCoalescer;
+    MVGManipulator* _pendingManipulator;
 };
 
 } // namespace
@@ -2,6 +2,8 @@
 #include "MVGContext.hpp"
 
 #include "meshroomMaya/core/MVGMesh.hpp"
+#include "meshroomMaya/core/MVGGeometryUtil.hpp"
+#include "meshroomMaya/maya/context/MVGAsyncPreview.hpp"
 #include "meshroomMaya/maya/context/MVGCreateManipulator.hpp"
 #include "meshroomMaya/maya/context/MVGMoveManipulator.hpp"
 #include "meshroomMaya/maya/context/MVGLocatorManipulator.hpp"
@@ -9,7 +11,9 @@
 #include "meshroomMaya/core/MVGLog.hpp"
 
 #include <maya/MPxManipulatorNode.h>
+#include <maya/MStringArray.h>
 #include <maya/MUserEventMessage.h>
+#include <algorithm>
 
 
 namespace
@@ -17,12 +21,26 @@ namespace
 
 static const char* rebuildFlag = "-r";
 static const char* rebuildFlagLong = "-rebuild";
+static const char* updateFlag = "-u";
+static const char* updateFlagLong = "-update";
+static const char* prefetchFlag = "-pf";
+static const char* prefetchFlagLong = "-prefetch";
+static const char* memoryBudgetFlag = "-mb";
+static const char* memoryBudgetFlagLong = "-memoryBudget";
+static const char* evictionsFlag = "-ev";
+static const char* evictionsFlagLong = "-evictions";
+static const char* droppedEventsFlag = "-de";
+static const char* droppedEventsFlagLong = "-droppedEvents";
 static const char* meshFlag = "-m";
 static const char* meshFlagLong = "-mesh";
 static const char* editModeFlag = "-em";
 static const char* editModeFlagLong = "-editMode";
 static const char* moveModeFlag = "-mv";
 static const char* moveModeFlagLong = "-moveMode";
+static const char* planeEstimatorFlag = "-pe";
+static const char* planeEstimatorFlagLong = "-planeEstimator";
+static const char* previewBudgetFlag = "-pb";
+static const char* previewBudgetFlagLong = "-previewBudget";
 
 } // empty namespace
 
@@ -51,6 +69,8 @@ void* MVGContextCmd::creator()
 MStatus MVGContextCmd::doEditFlags()
 {
     MArgParser argData = parser();
+    const MVGContext::EEditMode previousEditMode = _context->getEditMode();
+    const MVGMoveManipulator::EMoveMode previousMoveMode = MVGMoveManipulator::_mode;
     // -rebuild: rebuild cache
     if(argData.isFlagSet(rebuildFlag))
     {
@@ -65,6 +85,33 @@ MStatus MVGContextCmd::doEditFlags()
         }
         cache.rebuildMeshesCache();
     }
+    // -update: patch the meshes modified by the MeshroomMaya edit commands
+    if(argData.isFlagSet(updateFlag))
+        _context->getCache().updateDirtyMeshes();
+    // -prefetch panel "camera1 camera2": precompute camera space positions
+    if(argData.isFlagSet(prefetchFlag))
+    {
+        MString panelName, camerasString;
+        argData.getFlagArgument(prefetchFlag, 0, panelName);
+        argData.getFlagArgument(prefetchFlag, 1, camerasString);
+        MStringArray cameraNames;
+        camerasString.split(' ', cameraNames);
+        std::vector<MDagPath> neighbourCameras;
+        MDagPath cameraPath;
+        for(unsigned int i = 0; i < cameraNames.length(); ++i)
+        {
+            if(MVGMayaUtil::getDagPathByName(cameraNames[i], cameraPath))
+                neighbourCameras.push_back(cameraPath);
+        }
+        _context->getCache().prefetchCameraSpacePositions(panelName, neighbourCameras);
+    }
+    // -memoryBudget: camera space positions memory budget, in MB
+    if(argData.isFlagSet(memoryBudgetFlag))
+    {
+        int memoryBudget = 0;
+        argData.getFlagArgument(memoryBudgetFlag, 0, memoryBudget);
+        MVGManipulatorCache::_memoryBudget = (size_t)std::max(memoryBudget, 0) * 1024 * 1024;
+    }
     if(argData.isFlagSet(editModeFlag))
     {
         MString editModeString;
@@ -148,7 +195,28 @@ MStatus MVGContextCmd::doEditFlags()
            MVGMoveManipulator::_mode == MVGMoveManipulator::eMoveModePointCloudProjection)
             _context->getCache().clearSelectedComponent();
     }
-    MUserEventMessage::postUserEvent("modeChangedEvent");
+    if(argData.isFlagSet(planeEstimatorFlag))
+    {
+        MString planeEstimatorString;
+        argData.getFlagArgument(planeEstimatorFlag, 0, planeEstimatorString);
+        const int planeEstimator = planeEstimatorString.asInt();
+        if(!planeEstimatorString.isInt() ||
+           planeEstimator < MVGGeometryUtil::ePlaneEstimatorLeastMedianOfSquares ||
+           planeEstimator > MVGGeometryUtil::ePlaneEstimatorAngularSweep)
+        {
+            LOG_ERROR("Unknown planeEstimator " << planeEstimatorString.asChar())
+            return MS::kFailure;
+        }
+        MVGGeometryUtil::_planeEstimator =
+            static_cast<MVGGeometryUtil::EPlaneEstimator>(planeEstimator);
+    }
+    // -previewBudget: preview computation time budget, in milliseconds (0 to disable)
+    if(argData.isFlagSet(previewBudgetFlag))
+        argData.getFlagArgument(previewBudgetFlag, 0, MVGAsyncPreview::_latencyBudget);
+    // the UI only follows the edit and move modes
+    if(_context->getEditMode() != previousEditMode ||
+       MVGMoveManipulator::_mode != previousMoveMode)
+        MUserEventMessage::postUserEvent("modeChangedEvent");
     return MS::kSuccess;
 }
 
@@ -160,6 +228,16 @@ MStatus MVGContextCmd::doQueryFlags()
         setResult((int)_context->getEditMode());
     if(argData.isFlagSet(moveModeFlag))
         setResult((int)MVGMoveManipulator::_mode);
+    if(argData.isFlagSet(planeEstimatorFlag))
+        setResult((int)MVGGeometryUtil::_planeEstimator);
+    if(argData.isFlagSet(previewBudgetFlag))
+        setResult(MVGAsyncPreview::_latencyBudget);
+    if(argData.isFlagSet(memoryBudgetFlag))
+        setResult((int)(MVGManipulatorCache::_memoryBudget / (1024 * 1024)));
+    if(argData.isFlagSet(evictionsFlag))
+        setResult(_context->getCache().getEvictionsCount());
+    if(argData.isFlagSet(droppedEventsFlag))
+        setResult(_context->getDroppedEventsCount());
     return MS::kSuccess;
 }
 
@@ -168,12 +246,28 @@ MStatus MVGContextCmd::appendSyntax()
     MSyntax mySyntax = syntax();
     if(MS::kSuccess != mySyntax.addFlag(rebuildFlag, rebuildFlagLong))
         return MS::kFailure;
+    if(MS::kSuccess != mySyntax.addFlag(updateFlag, updateFlagLong))
+        return MS::kFailure;
+    if(MS::kSuccess !=
+       mySyntax.addFlag(prefetchFlag, prefetchFlagLong, MSyntax::kString, MSyntax::kString))
+        return MS::kFailure;
+    if(MS::kSuccess != mySyntax.addFlag(memoryBudgetFlag, memoryBudgetFlagLong, MSyntax::kLong))
+        return MS::kFailure;
+    if(MS::kSuccess != mySyntax.addFlag(evictionsFlag, evictionsFlagLong))
+        return MS::kFailure;
+    if(MS::kSuccess != mySyntax.addFlag(droppedEventsFlag, droppedEventsFlagLong))
+        return MS::kFailure;
     if(MS::kSuccess != mySyntax.addFlag(meshFlag, meshFlagLong, MSyntax::kString))
         return MS::kFailure;
     if(MS::kSuccess != mySyntax.addFlag(editModeFlag, editModeFlagLong, MSyntax::kString))
         return MS::kFailure;
     if(MS::kSuccess != mySyntax.addFlag(moveModeFlag, moveModeFlagLong, MSyntax::kString))
         return MS::kFailure;
+    if(MS::kSuccess !=
+       mySyntax.addFlag(planeEstimatorFlag, planeEstimatorFlagLong, MSyntax::kString))
+        return MS::kFailure;
+    if(MS::kSuccess != mySyntax.addFlag(previewBudgetFlag, previewBudgetFlagLong, MSyntax::kDouble))
+        return MS::kFailure;
     return MS::kSuccess;
 }
 
@@ -72,6 +72,7 @@ void MVGCreateManipulator::draw(M3dView& view, const MDagPath& path, M3dView::Di
     }
 
     { // 2D drawing
+        const MVGProjectionSnapshot projection(view);
         MPoint mouseVSPositions = getMousePosition(view, kView);
         MVGDrawUtil::begin2DDrawing(view.portWidth(), view.portHeight());
         // draw clicked points
@@ -82,7 +83,7 @@ void MVGCreateManipulator::draw(M3dView& view, const MDagPath& path, M3dView::Di
         {
             MColor drawColor = MVGDrawUtil::_errorColor;
             MPointArray _clickedVSPoints =
-                MVGGeometryUtil::cameraToViewSpace(view, _cameraIDToClickedCSPoints.second);
+                MVGGeometryUtil::cameraToViewSpace(projection, _cameraIDToClickedCSPoints.second);
             const MVGCamera& activeCamera = _cache->getActiveCamera();
             if(activeCamera.isValid() && _cameraIDToClickedCSPoints.first == activeCamera.getId())
             {
@@ -112,7 +113,7 @@ void MVGCreateManipulator::draw(M3dView& view, const MDagPath& path, M3dView::Di
         if(!_doDrag && !_doSnap)
         {
             MPointArray intersectedVSPoints;
-            getIntersectedPoints(view, intersectedVSPoints, MVGManipulator::kView);
+            getIntersectedPoints(projection, intersectedVSPoints, MVGManipulator::kView);
             MVGManipulator::drawIntersection2D(intersectedVSPoints, _cache->getIntersectionType());
         }
 
@@ -121,12 +122,12 @@ void MVGCreateManipulator::draw(M3dView& view, const MDagPath& path, M3dView::Di
         {
             if(_snapedPoints.length() == 1)
                 MVGDrawUtil::drawCircle2D(
-                    MVGGeometryUtil::worldToViewSpace(view, _finalWSPoints[_snapedPoints[0]]),
+                    MVGGeometryUtil::worldToViewSpace(projection, _finalWSPoints[_snapedPoints[0]]),
                     MVGDrawUtil::_intersectionColor, 5, 30);
             else if(_snapedPoints.length() == 2)
                 MVGDrawUtil::drawLine2D(
-                    MVGGeometryUtil::worldToViewSpace(view, _finalWSPoints[_snapedPoints[0]]),
-                    MVGGeometryUtil::worldToViewSpace(view, _finalWSPoints[_snapedPoints[1]]),
+                    MVGGeometryUtil::worldToViewSpace(projection, _finalWSPoints[_snapedPoints[0]]),
+                    MVGGeometryUtil::worldToViewSpace(projection, _finalWSPoints[_snapedPoints[1]]),
                     MVGDrawUtil::_intersectionColor, 3.0);
         }
         MVGDrawUtil::end2DDrawing();
@@ -137,6 +138,7 @@ void MVGCreateManipulator::draw(M3dView& view, const MDagPath& path, M3dView::Di
 
 MStatus MVGCreateManipulator::doPress(M3dView& view)
 {
+    flushInput();
     if(!MVGMayaUtil::isActiveView(view) || !MVGMayaUtil::isMVGView(view))
         return MPxManipulatorNode::doPress(view);
     // use only the left mouse button
@@ -155,10 +157,11 @@ MStatus MVGCreateManipulator::doPress(M3dView& view)
     if(_cache->getActiveCamera().getId() != _cameraID)
     {
         _cameraID = _cache->getActiveCamera().getId();
-        _cache->getActiveCamera().getVisibleItems(_visiblePointCloudItems);
+        _preview.setVisibleItems(_cache->getActiveCamera());
     }
     // set this view as the active view
     _cache->setActiveView(view);
+    _preview.reset();
 
     // TODO clear the other views?
 
@@ -172,6 +175,7 @@ MStatus MVGCreateManipulator::doPress(M3dView& view)
 
 MStatus MVGCreateManipulator::doRelease(M3dView& view)
 {
+    flushInput();
     _doDrag = false;
     if(!MVGMayaUtil::isActiveView(view) || !MVGMayaUtil::isMVGView(view))
         return MPxManipulatorNode::doRelease(view);
@@ -180,14 +184,15 @@ MStatus MVGCreateManipulator::doRelease(M3dView& view)
     if(!camera.isValid())
         return MPxManipulatorNode::doRelease(view);
 
-    computeFinalWSPoints(view);
+    const MVGProjectionSnapshot projection(view);
+    computeFinalWSPoints(projection);
 
     // we are intersecting w/ a mesh component: retrieve the component properties and add its
     // coordinates to the clicked CS points array
     if(_onPressIntersectedComponent.type == MFn::kInvalid)
-        _cameraIDToClickedCSPoints.second.append(getMousePosition(view));
+        _cameraIDToClickedCSPoints.second.append(getMousePosition(projection));
     else
-        getIntersectedPoints(view, _cameraIDToClickedCSPoints.second);
+        getIntersectedPoints(projection, _cameraIDToClickedCSPoints.second);
 
     // FIXME remove potential extra points
 
@@ -223,8 +228,8 @@ MStatus MVGCreateManipulator::doRelease(M3dView& view)
     if(!cmd)
         return MS::kFailure;
     MPointArray edgeCSPositions;
-    edgeCSPositions.append(MVGGeometryUtil::worldToCameraSpace(view, _finalWSPoints[2]));
-    edgeCSPositions.append(MVGGeometryUtil::worldToCameraSpace(view, _finalWSPoints[3]));
+    edgeCSPositions.append(MVGGeometryUtil::worldToCameraSpace(projection, _finalWSPoints[2]));
+    edgeCSPositions.append(MVGGeometryUtil::worldToCameraSpace(projection, _finalWSPoints[3]));
     cmd->addFace(_onPressIntersectedComponent.meshPath, _finalWSPoints, edgeCSPositions,
                  _cache->getActiveCamera().getId());
 
@@ -232,7 +237,7 @@ MStatus MVGCreateManipulator::doRelease(M3dView& view)
     if(cmd->doIt(args))
     {
         cmd->finalize();
-        _cache->rebuildMeshCache(_onPressIntersectedComponent.meshPath);
+        _cache->updateDirtyMeshes();
     }
 
     // Clear data
@@ -245,25 +250,26 @@ MStatus MVGCreateManipulator::doRelease(M3dView& view)
 
 MStatus MVGCreateManipulator::doMove(M3dView& view, bool& refresh)
 {
-    const MVGCamera& camera = _cache->getActiveCamera();
-    if(!camera.isValid())
-        return MPxManipulatorNode::doMove(view, refresh);
-
-    _cache->checkIntersection(10.0, getMousePosition(view));
-    computeFinalWSPoints(view);
+    requestProcessInput();
     return MPxManipulatorNode::doMove(view, refresh);
 }
 
 MStatus MVGCreateManipulator::doDrag(M3dView& view)
+{
+    requestProcessInput();
+    return MPxManipulatorNode::doDrag(view);
+}
+
+void MVGCreateManipulator::computePreview()
 {
     const MVGCamera& camera = _cache->getActiveCamera();
     if(!camera.isValid())
-        return MPxManipulatorNode::doDrag(view);
+        return;
 
     // TODO : snap w/ current intersection
-    _cache->checkIntersection(10.0, getMousePosition(view));
-    computeFinalWSPoints(view);
-    return MPxManipulatorNode::doDrag(view);
+    const MVGProjectionSnapshot projection(_cache->getActiveView());
+    _cache->checkIntersection(10.0, getMousePosition(projection));
+    computeFinalWSPoints(projection);
 }
 
 MPointArray MVGCreateManipulator::getClickedVSPoints() const
@@ -272,7 +278,7 @@ MPointArray MVGCreateManipulator::getClickedVSPoints() const
                                               _cameraIDToClickedCSPoints.second);
 }
 
-void MVGCreateManipulator::computeFinalWSPoints(M3dView& view)
+void MVGCreateManipulator::computeFinalWSPoints(const MVGProjectionSnapshot& projection)
 {
     _snapedPoints.clear();
 
@@ -282,10 +288,13 @@ void MVGCreateManipulator::computeFinalWSPoints(M3dView& view)
         _finalWSPoints.clear();
         // add mouse point to the clicked points
         MPointArray previewCSPoints = _cameraIDToClickedCSPoints.second;
-        previewCSPoints.append(getMousePosition(view));
+        previewCSPoints.append(getMousePosition(projection));
         // project clicked points on point cloud
-        MVGPointCloud cloud(MVGProject::_CLOUD);
-        cloud.projectPoints(view, _visiblePointCloudItems, previewCSPoints, _finalWSPoints);
+        MVGAsyncPreview::Request request(projection);
+        request.faceCSPoints = previewCSPoints;
+        MVGAsyncPreview::Result result;
+        if(projectOnPointCloud(request, result))
+            _finalWSPoints = result.faceWSPoints;
         return;
     }
     if(_cameraIDToClickedCSPoints.second.length() > 0)
@@ -295,13 +304,13 @@ void MVGCreateManipulator::computeFinalWSPoints(M3dView& view)
     if(_onPressIntersectedComponent.type != MFn::kMeshEdgeComponent)
         return;
 
-    _cache->checkIntersection(10.0, getMousePosition(view, kCamera));
+    _cache->checkIntersection(10.0, getMousePosition(projection, kCamera));
     const MVGManipulatorCache::MVGComponent& mouseIntersectedComponent =
         _cache->getIntersectedComponent();
 
     // Retrieve edge points preserving on press edge length
     MPointArray intermediateCSEdgePoints;
-    getIntermediateCSEdgePoints(view, _onPressIntersectedComponent.edge, _onPressCSPoint,
+    getIntermediateCSEdgePoints(projection, _onPressIntersectedComponent.edge, _onPressCSPoint,
                                 intermediateCSEdgePoints);
     assert(intermediateCSEdgePoints.length() == 2);
     if(_doSnap &&
@@ -309,63 +318,66 @@ void MVGCreateManipulator::computeFinalWSPoints(M3dView& view)
            _onPressIntersectedComponent.meshPath.fullPathName())
     {
         // Snap to intersected edge
-        if(snapToIntersectedEdge(view, _finalWSPoints, mouseIntersectedComponent))
+        if(snapToIntersectedEdge(projection, _finalWSPoints, mouseIntersectedComponent))
             return;
         // Snap to intersected vertex
-        if(snapToIntersectedVertex(view, _finalWSPoints, intermediateCSEdgePoints))
+        if(snapToIntersectedVertex(projection, _finalWSPoints, intermediateCSEdgePoints))
             return;
     }
     // try to extend face in a plane computed w/ pointcloud
-    if(computePCPoints(view, _finalWSPoints, intermediateCSEdgePoints))
+    if(computePCPoints(projection, _finalWSPoints, intermediateCSEdgePoints))
         return;
 
     // extrude face in the plane of the adjacent polygon
-    computeAdjacentPoints(view, _finalWSPoints, intermediateCSEdgePoints);
+    computeAdjacentPoints(projection, _finalWSPoints, intermediateCSEdgePoints);
 }
 
-bool MVGCreateManipulator::computePCPoints(M3dView& view, MPointArray& finalWSPoints,
+bool MVGCreateManipulator::computePCPoints(const MVGProjectionSnapshot& projection,
+                                           MPointArray& finalWSPoints,
                                            const MPointArray& intermediateCSEdgePoints)
 {
     finalWSPoints.clear();
     // Get camera space points to project
     MPointArray cameraSpacePoints;
     cameraSpacePoints.append(MVGGeometryUtil::worldToCameraSpace(
-        view, _onPressIntersectedComponent.edge->vertex1->worldPosition));
+        projection, _onPressIntersectedComponent.edge.getVertex1().getWorldPosition()));
     cameraSpacePoints.append(MVGGeometryUtil::worldToCameraSpace(
-        view, _onPressIntersectedComponent.edge->vertex2->worldPosition));
+        projection, _onPressIntersectedComponent.edge.getVertex2().getWorldPosition()));
     cameraSpacePoints.append(intermediateCSEdgePoints[1]);
     cameraSpacePoints.append(intermediateCSEdgePoints[0]);
 
     // Project mouse on point cloud
-    MPoint projectedMouseWS;
-    MVGPointCloud cloud(MVGProject::_CLOUD);
-    MPointArray constraintedPoints;
-    constraintedPoints.append(_onPressIntersectedComponent.edge->vertex1->worldPosition);
-    constraintedPoints.append(_onPressIntersectedComponent.edge->vertex2->worldPosition);
-    if(!cloud.projectPointsWithLineConstraint(view, _visiblePointCloudItems, cameraSpacePoints,
-                                              constraintedPoints, getMousePosition(view),
-                                              projectedMouseWS))
+    MVGAsyncPreview::Request request(projection);
+    request.faceCSPoints = cameraSpacePoints;
+    request.constraintWSPoints.append(
+        _onPressIntersectedComponent.edge.getVertex1().getWorldPosition());
+    request.constraintWSPoints.append(
+        _onPressIntersectedComponent.edge.getVertex2().getWorldPosition());
+    request.mouseCSPoint = getMousePosition(projection);
+    MVGAsyncPreview::Result result;
+    if(!projectOnPointCloud(request, result))
         return false;
     MPointArray translatedWSEdgePoints;
-    getTranslatedWSEdgePoints(view, _onPressIntersectedComponent.edge, _onPressCSPoint,
-                              projectedMouseWS, translatedWSEdgePoints);
+    getTranslatedWSEdgePoints(projection, _onPressIntersectedComponent.edge, _onPressCSPoint,
+                              result.mouseWSPoint, translatedWSEdgePoints);
     // Begin with second edge's vertex to keep normal
-    finalWSPoints.append(_onPressIntersectedComponent.edge->vertex2->worldPosition);
-    finalWSPoints.append(_onPressIntersectedComponent.edge->vertex1->worldPosition);
+    finalWSPoints.append(_onPressIntersectedComponent.edge.getVertex2().getWorldPosition());
+    finalWSPoints.append(_onPressIntersectedComponent.edge.getVertex1().getWorldPosition());
     finalWSPoints.append(translatedWSEdgePoints[0]);
     finalWSPoints.append(translatedWSEdgePoints[1]);
 
     return true;
 }
 
-bool MVGCreateManipulator::computeAdjacentPoints(M3dView& view, MPointArray& finalWSPoints,
+bool MVGCreateManipulator::computeAdjacentPoints(const MVGProjectionSnapshot& projection,
+                                                 MPointArray& finalWSPoints,
                                                  const MPointArray& intermediateCSEdgePoints)
 {
     finalWSPoints.clear();
     MVGMesh mesh(_onPressIntersectedComponent.meshPath);
-    assert(_onPressIntersectedComponent.edge->index != -1);
+    assert(_onPressIntersectedComponent.edge.index != -1);
     MIntArray connectedFacesIDs =
-        mesh.getConnectedFacesToEdge(_onPressIntersectedComponent.edge->index);
+        mesh.getConnectedFacesToEdge(_onPressIntersectedComponent.edge.index);
     if(connectedFacesIDs.length() < 1)
         return false;
     // TODO select the face
@@ -383,13 +395,13 @@ bool MVGCreateManipulator::computeAdjacentPoints(M3dView& view, MPointArray& fin
         return false;
     // Project moves points on plane
     MPointArray projectedWSPoints;
-    if(!MVGGeometryUtil::projectPointsOnPlane(view, intermediateCSEdgePoints, planeModel,
+    if(!MVGGeometryUtil::projectPointsOnPlane(projection, intermediateCSEdgePoints, planeModel,
                                               projectedWSPoints))
         return false;
     assert(projectedWSPoints.length() == 2);
     // Begin with second edge's vertex to keep normal
-    finalWSPoints.append(_onPressIntersectedComponent.edge->vertex2->worldPosition);
-    finalWSPoints.append(_onPressIntersectedComponent.edge->vertex1->worldPosition);
+    finalWSPoints.append(_onPressIntersectedComponent.edge.getVertex2().getWorldPosition());
+    finalWSPoints.append(_onPressIntersectedComponent.edge.getVertex1().getWorldPosition());
     finalWSPoints.append(projectedWSPoints[0]);
     finalWSPoints.append(projectedWSPoints[1]);
 
@@ -397,7 +409,7 @@ bool MVGCreateManipulator::computeAdjacentPoints(M3dView& view, MPointArray& fin
 }
 
 bool MVGCreateManipulator::snapToIntersectedEdge(
-    M3dView& view, MPointArray& finalWSPoints,
+    const MVGProjectionSnapshot& projection, MPointArray& finalWSPoints,
     const MVGManipulatorCache::MVGComponent& intersectedEdge)
 {
     if(intersectedEdge.type != MFn::kMeshEdgeComponent)
@@ -405,10 +417,11 @@ bool MVGCreateManipulator::snapToIntersectedEdge(
     if(_onPressIntersectedComponent.type != MFn::kMeshEdgeComponent)
         return false;
     finalWSPoints.clear();
-    const MPoint& pressedVertex1 = _onPressIntersectedComponent.edge->vertex1->worldPosition;
-    const MPoint& pressedVertex2 = _onPressIntersectedComponent.edge->vertex2->worldPosition;
-    const MPoint& intersectedVertex1 = intersectedEdge.edge->vertex1->worldPosition;
-    const MPoint& intersectedVertex2 = intersectedEdge.edge->vertex2->worldPosition;
+    const MVGManipulatorCache::EdgeData& pressedEdge = _onPressIntersectedComponent.edge;
+    const MPoint& pressedVertex1 = pressedEdge.getVertex1().getWorldPosition();
+    const MPoint& pressedVertex2 = pressedEdge.getVertex2().getWorldPosition();
+    const MPoint& intersectedVertex1 = intersectedEdge.edge.getVertex1().getWorldPosition();
+    const MPoint& intersectedVertex2 = intersectedEdge.edge.getVertex2().getWorldPosition();
 
     // Don't snap on adjacent edge
     if(pressedVertex1 == intersectedVertex1 || pressedVertex1 == intersectedVertex2 ||
@@ -425,10 +438,12 @@ bool MVGCreateManipulator::snapToIntersectedEdge(
     _snapedPoints.append(finalWSPoints.length() - 1);
 
     // Check points order
-    MPoint A = MVGGeometryUtil::worldToCameraSpace(view, finalWSPoints[0]);
-    MPoint B = MVGGeometryUtil::worldToCameraSpace(view, finalWSPoints[1]);
-    MVector AD = MVGGeometryUtil::worldToCameraSpace(view, finalWSPoints[3]) - A;
-    MVector BC = MVGGeometryUtil::worldToCameraSpace(view, finalWSPoints[2]) - B;
+    MPointArray finalCSPoints;
+    MVGGeometryUtil::worldToCameraSpace(projection, finalWSPoints, finalCSPoints);
+    MPoint A = finalCSPoints[0];
+    MPoint B = finalCSPoints[1];
+    MVector AD = finalCSPoints[3] - A;
+    MVector BC = finalCSPoints[2] - B;
     if(MVGGeometryUtil::doEdgesIntersect(A, B, AD, BC))
     {
         MPointArray tmp = finalWSPoints;
@@ -441,15 +456,16 @@ bool MVGCreateManipulator::snapToIntersectedEdge(
     return true;
 }
 
-bool MVGCreateManipulator::snapToIntersectedVertex(M3dView& view, MPointArray& finalWSPoints,
+bool MVGCreateManipulator::snapToIntersectedVertex(const MVGProjectionSnapshot& projection,
+                                                   MPointArray& finalWSPoints,
                                                    const MPointArray& intermediateCSEdgePoints)
 {
     if(_onPressIntersectedComponent.type != MFn::kMeshEdgeComponent)
         return false;
     finalWSPoints.setLength(4);
     // Begin with second edge's vertex to keep normal
-    finalWSPoints[0] = _onPressIntersectedComponent.edge->vertex2->worldPosition;
-    finalWSPoints[1] = _onPressIntersectedComponent.edge->vertex1->worldPosition;
+    finalWSPoints[0] = _onPressIntersectedComponent.edge.getVertex2().getWorldPosition();
+    finalWSPoints[1] = _onPressIntersectedComponent.edge.getVertex1().getWorldPosition();
 
     // Get intersection with "intermediateCSEdgePoints"
     MVGManipulatorCache::MVGComponent edgeIntersectedComponent;
@@ -460,7 +476,7 @@ bool MVGCreateManipulator::snapToIntersectedVertex(M3dView& view, MPointArray& f
             edgeIntersectedComponent = _cache->getIntersectedComponent();
             if(edgeIntersectedComponent.type == MFn::kMeshVertComponent)
             {
-                _finalWSPoints[i + 2] = edgeIntersectedComponent.vertex->worldPosition;
+                _finalWSPoints[i + 2] = edgeIntersectedComponent.vertex.getWorldPosition();
                 _snapedPoints.append(i + 2);
             }
         }
@@ -473,8 +489,9 @@ bool MVGCreateManipulator::snapToIntersectedVertex(M3dView& view, MPointArray& f
     // extended egde to compute the last point.
     if(_snapedPoints.length() == 1)
     {
-        MVector onPressEdgeVector = _onPressIntersectedComponent.edge->vertex2->worldPosition -
-                                    _onPressIntersectedComponent.edge->vertex1->worldPosition;
+        const MVGManipulatorCache::EdgeData& onPressEdge = _onPressIntersectedComponent.edge;
+        MVector onPressEdgeVector = onPressEdge.getVertex2().getWorldPosition() -
+                                    onPressEdge.getVertex1().getWorldPosition();
         if(_snapedPoints[0] == 2)
             _finalWSPoints[3] = _finalWSPoints[2] + onPressEdgeVector;
         if(_snapedPoints[0] == 3)
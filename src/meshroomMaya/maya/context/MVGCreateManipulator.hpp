@@ -26,18 +26,22 @@ public:
     virtual MStatus doMove(M3dView& view, bool& refresh);
     virtual MStatus doDrag(M3dView& view);
 
+protected:
+    virtual void computePreview();
+
 public:
     MPointArray getClickedVSPoints() const;
 
 private:
-    void computeFinalWSPoints(M3dView& view);
-    bool computePCPoints(M3dView& view, MPointArray& finalWSPoints,
+    void computeFinalWSPoints(const MVGProjectionSnapshot& projection);
+    bool computePCPoints(const MVGProjectionSnapshot& projection, MPointArray& finalWSPoints,
                          const MPointArray& intermediateCSEdgePoints);
-    bool computeAdjacentPoints(M3dView& view, MPointArray& finalWSPoints,
+    bool computeAdjacentPoints(const MVGProjectionSnapshot& projection, MPointArray& finalWSPoints,
                                const MPointArray& intermediateCSEdgePoints);
-    bool snapToIntersectedEdge(M3dView& view, MPointArray& finalWSPoints,
+    bool snapToIntersectedEdge(const MVGProjectionSnapshot& projection, MPointArray& finalWSPoints,
                                const MVGManipulatorCache::MVGComponent& intersectedEdge);
-    bool snapToIntersectedVertex(M3dView& view, MPointArray& finalWSPoints,
+    bool snapToIntersectedVertex(const MVGProjectionSnapshot& projection,
+                                 MPointArray& finalWSPoints,
                                  const MPointArray& intermediateCSEdgePoints);
 
 public:
@@ -140,7 +140,7 @@ MStatus MVGLocatorManipulator::doDrag(M3dView& view)
     return MPxManipulatorNode::doDrag(view);
 }
 
-void MVGLocatorManipulator::computeFinalWSPoints(M3dView& view)
+void MVGLocatorManipulator::computeFinalWSPoints(const MVGProjectionSnapshot& projection)
 {
     return;
 }
@@ -27,7 +27,7 @@ public:
     virtual MStatus doDrag(M3dView& view);
 
 public:
-    void computeFinalWSPoints(M3dView& view);
+    void computeFinalWSPoints(const MVGProjectionSnapshot& projection);
     const std::map<int, MPoint>& getCameraIDToClickedCSPoint() { return _cameraIDToClickedCSPoint; }
     void clearCameraIDToClickedCSPoint() { _cameraIDToClickedCSPoint.clear(); }
 
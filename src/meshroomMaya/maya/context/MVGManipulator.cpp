@@ -6,10 +6,18 @@ namespace meshroomMaya
 
 MVGManipulator::MVGManipulator()
     : _doDrag(false)
+    , _context(NULL)
+    , _isComputingPreview(false)
 {
     _cameraID = -1;
 }
 
+MVGManipulator::~MVGManipulator()
+{
+    if(_context)
+        _context->cancelManipulatorInput(this);
+}
+
 void MVGManipulator::getMousePosition(M3dView& view, MPoint& point, MVGManipulator::Space space)
 {
     short x, y;
@@ -35,6 +43,33 @@ MPoint MVGManipulator::getMousePosition(M3dView& view, MVGManipulator::Space spa
     return position;
 }
 
+void MVGManipulator::getMousePosition(const MVGProjectionSnapshot& projection, MPoint& point,
+                                      MVGManipulator::Space space)
+{
+    short x, y;
+    mousePosition(x, y);
+    switch(space)
+    {
+        case kWorld:
+            projection.viewToWorld(MPoint(x, y), point);
+            break;
+        case kCamera:
+            projection.viewToCamera(MPoint(x, y), point);
+            break;
+        case kView:
+            point = MPoint(x, y);
+            break;
+    }
+}
+
+MPoint MVGManipulator::getMousePosition(const MVGProjectionSnapshot& projection,
+                                        MVGManipulator::Space space)
+{
+    MPoint position;
+    getMousePosition(projection, position, space);
+    return position;
+}
+
 const MPointArray& MVGManipulator::getFinalWSPoints() const
 {
     return _finalWSPoints;
@@ -42,6 +77,13 @@ const MPointArray& MVGManipulator::getFinalWSPoints() const
 
 void MVGManipulator::getIntersectedPoints(M3dView& view, MPointArray& positions,
                                           MVGManipulator::Space space) const
+{
+    getIntersectedPoints(MVGProjectionSnapshot(view), positions, space);
+}
+
+void MVGManipulator::getIntersectedPoints(const MVGProjectionSnapshot& projection,
+                                          MPointArray& positions,
+                                          MVGManipulator::Space space) const
 {
     MPointArray intersectedPositions;
     MVGManipulatorCache::MVGComponent intersectedComponent = _cache->getIntersectedComponent();
@@ -49,17 +91,19 @@ void MVGManipulator::getIntersectedPoints(M3dView& view, MPointArray& positions,
     {
         case MFn::kBlindData:
         {
-            MPoint pointCSPosition =
-                intersectedComponent.vertex->blindData[_cache->getActiveCamera().getId()];
-            intersectedPositions.append(MVGGeometryUtil::cameraToWorldSpace(view, pointCSPosition));
+            MPoint pointCSPosition;
+            intersectedComponent.vertex.getBlindData(_cache->getActiveCamera().getId(),
+                                                     pointCSPosition);
+            intersectedPositions.append(
+                MVGGeometryUtil::cameraToWorldSpace(projection, pointCSPosition));
             break;
         }
         case MFn::kMeshVertComponent:
-            intersectedPositions.append(intersectedComponent.vertex->worldPosition);
+            intersectedPositions.append(intersectedComponent.vertex.getWorldPosition());
             break;
         case MFn::kMeshEdgeComponent:
-            intersectedPositions.append(intersectedComponent.edge->vertex1->worldPosition);
-            intersectedPositions.append(intersectedComponent.edge->vertex2->worldPosition);
+            intersectedPositions.append(intersectedComponent.edge.getVertex1().getWorldPosition());
+            intersectedPositions.append(intersectedComponent.edge.getVertex2().getWorldPosition());
             break;
         default:
             break;
@@ -69,10 +113,12 @@ void MVGManipulator::getIntersectedPoints(M3dView& view, MPointArray& positions,
     switch(space)
     {
         case kCamera:
-            intersectedPositions = MVGGeometryUtil::worldToCameraSpace(view, intersectedPositions);
+            intersectedPositions =
+                MVGGeometryUtil::worldToCameraSpace(projection, intersectedPositions);
             break;
         case kView:
-            intersectedPositions = MVGGeometryUtil::worldToViewSpace(view, intersectedPositions);
+            intersectedPositions =
+                MVGGeometryUtil::worldToViewSpace(projection, intersectedPositions);
             break;
         case kWorld:
             break;
@@ -105,56 +151,59 @@ const MPointArray MVGManipulator::getIntersectedPoints(M3dView& view,
  *
  * This computation is in 2D Camera Space.
  *
- * @param[in] view Viewort
+ * @param[in] projection viewing parameters of the active view
  * @param[in] onPressEdgeData clicked edge information
  * @param[in] onPressCSMousePos clicked mouse position in Camera Space coordinates
  * @param[out] intermediateCSEdgePoints the 2 new points (D and C) of the parallelogram
  */
 void MVGManipulator::getIntermediateCSEdgePoints(
-    M3dView& view, const MVGManipulatorCache::EdgeData* onPressEdgeData,
+    const MVGProjectionSnapshot& projection, const MVGManipulatorCache::EdgeData& onPressEdgeData,
     const MPoint& onPressCSMousePos, MPointArray& intermediateCSEdgePoints)
 {
-    assert(onPressEdgeData != NULL);
+    assert(onPressEdgeData.isValid());
+    const MPoint mouseCSPosition = getMousePosition(projection);
     // vertex 1
     MVector mouseToVertexCSOffset =
-        MVGGeometryUtil::worldToCameraSpace(view, onPressEdgeData->vertex1->worldPosition) -
+        MVGGeometryUtil::worldToCameraSpace(projection,
+                                            onPressEdgeData.getVertex1().getWorldPosition()) -
         onPressCSMousePos;
-    intermediateCSEdgePoints.append(getMousePosition(view) + mouseToVertexCSOffset);
+    intermediateCSEdgePoints.append(mouseCSPosition + mouseToVertexCSOffset);
     // vertex 2
     mouseToVertexCSOffset =
-        MVGGeometryUtil::worldToCameraSpace(view, onPressEdgeData->vertex2->worldPosition) -
+        MVGGeometryUtil::worldToCameraSpace(projection,
+                                            onPressEdgeData.getVertex2().getWorldPosition()) -
         onPressCSMousePos;
-    intermediateCSEdgePoints.append(getMousePosition(view) + mouseToVertexCSOffset);
+    intermediateCSEdgePoints.append(mouseCSPosition + mouseToVertexCSOffset);
 }
 
 const MPointArray
-MVGManipulator::getIntermediateCSEdgePoints(M3dView& view,
-                                            const MVGManipulatorCache::EdgeData* onPressEdgeData,
+MVGManipulator::getIntermediateCSEdgePoints(const MVGProjectionSnapshot& projection,
+                                            const MVGManipulatorCache::EdgeData& onPressEdgeData,
                                             const MPoint& onPressCSPoint)
 {
-    assert(onPressEdgeData != NULL);
+    assert(onPressEdgeData.isValid());
     MPointArray intermediateCSEdgePoints;
-    getIntermediateCSEdgePoints(view, onPressEdgeData, onPressCSPoint, intermediateCSEdgePoints);
+    getIntermediateCSEdgePoints(projection, onPressEdgeData, onPressCSPoint,
+                                intermediateCSEdgePoints);
     return intermediateCSEdgePoints;
 }
 
-void MVGManipulator::getTranslatedWSEdgePoints(M3dView& view,
-                                               const MVGManipulatorCache::EdgeData* originEdgeData,
+void MVGManipulator::getTranslatedWSEdgePoints(const MVGProjectionSnapshot& projection,
+                                               const MVGManipulatorCache::EdgeData& originEdgeData,
                                                MPoint& originCSPosition, MPoint& targetWSPosition,
                                                MPointArray& targetEdgeWSPositions) const
 {
-    assert(originEdgeData != NULL);
-    MVector edgeCSVector =
-        MVGGeometryUtil::worldToCameraSpace(view, originEdgeData->vertex1->worldPosition) -
-        MVGGeometryUtil::worldToCameraSpace(view, originEdgeData->vertex2->worldPosition);
-    MVector vertex1ToMouseCSVector =
-        originCSPosition -
-        MVGGeometryUtil::worldToCameraSpace(view, originEdgeData->vertex1->worldPosition);
+    assert(originEdgeData.isValid());
+    MPoint vertex1CSPosition, vertex2CSPosition;
+    projection.worldToCamera(originEdgeData.getVertex1().getWorldPosition(), vertex1CSPosition);
+    projection.worldToCamera(originEdgeData.getVertex2().getWorldPosition(), vertex2CSPosition);
+    MVector edgeCSVector = vertex1CSPosition - vertex2CSPosition;
+    MVector vertex1ToMouseCSVector = originCSPosition - vertex1CSPosition;
     float ratioVertex1 = vertex1ToMouseCSVector.length() / edgeCSVector.length();
     float ratioVertex2 = 1.f - ratioVertex1;
 
-    MVector edgeWSVector =
-        originEdgeData->vertex1->worldPosition - originEdgeData->vertex2->worldPosition;
+    MVector edgeWSVector = originEdgeData.getVertex1().getWorldPosition() -
+                           originEdgeData.getVertex2().getWorldPosition();
     targetEdgeWSPositions.append(targetWSPosition + ratioVertex1 * edgeWSVector);
     targetEdgeWSPositions.append(targetWSPosition - ratioVertex2 * edgeWSVector);
 }
@@ -164,6 +213,60 @@ MVGEditCmd* MVGManipulator::newEditCmd()
     return dynamic_cast<MVGEditCmd*>(_context->newCmd());
 }
 
+/**
+ * @brief Project on the point cloud. While computing the preview, the request is submitted to the
+ * preview worker and the most recent finished result of its component is returned, pending if
+ * there is none yet; otherwise it is computed now.
+ * @return false if the points could not be projected, or if the result is pending
+ */
+bool MVGManipulator::projectOnPointCloud(const MVGAsyncPreview::Request& request,
+                                         MVGAsyncPreview::Result& result)
+{
+    if(!_isComputingPreview)
+        return _preview.compute(request, result);
+    _preview.submit(request);
+    result = _preview.getResult(request);
+    return result.isValid;
+}
+
+/**
+ * @brief Defer processInput() to the next input processing of the context, so that the mouse
+ * events received in between are coalesced.
+ */
+void MVGManipulator::requestProcessInput()
+{
+    if(!_context)
+    {
+        processInput();
+        return;
+    }
+    _context->requestManipulatorInput(this);
+}
+
+void MVGManipulator::processInput()
+{
+    _isComputingPreview = true;
+    computePreview();
+    _isComputingPreview = false;
+    // poll the preview worker until the latest mouse position is computed
+    if(_context && _preview.isBusy())
+        _context->requestManipulatorInput(this);
+}
+
+/// Drop the pending processInput() of this manipulator, before computing its final positions
+void MVGManipulator::cancelProcessInput()
+{
+    if(_context)
+        _context->cancelManipulatorInput(this);
+}
+
+/// Run the pending processInput() before handling a press or a release
+void MVGManipulator::flushInput()
+{
+    if(_context)
+        _context->flushInput();
+}
+
 // static
 void MVGManipulator::drawIntersection2D(const MPointArray& intersectedVSPoints,
                                         const MFn::Type intersectionType)
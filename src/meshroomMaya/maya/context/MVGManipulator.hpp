@@ -1,7 +1,7 @@
 #pragma once
 
 #include "meshroomMaya/core/MVGGeometryUtil.hpp"
-#include "meshroomMaya/core/MVGPointCloudItem.hpp"
+#include "meshroomMaya/maya/context/MVGAsyncPreview.hpp"
 #include "meshroomMaya/maya/context/MVGManipulatorCache.hpp"
 #include "meshroomMaya/maya/context/MVGContext.hpp"
 #include "meshroomMaya/maya/cmd/MVGEditCmd.hpp"
@@ -23,29 +23,35 @@ public:
 
 public:
     MVGManipulator();
-    virtual ~MVGManipulator() {}
+    virtual ~MVGManipulator();
 
 public:
     void setContext(MVGContext* c) { _context = c; }
     MVGManipulatorCache* getCache() const { return _cache; }
     void setCache(MVGManipulatorCache* m) { _cache = m; }
+    /// Computation following the latest mouse move or drag, run once per display refresh
+    void processInput();
 
 public:
     MPoint getMousePosition(M3dView&, Space = kCamera);
     void getMousePosition(M3dView&, MPoint&, Space = kCamera);
+    MPoint getMousePosition(const MVGProjectionSnapshot&, Space = kCamera);
+    void getMousePosition(const MVGProjectionSnapshot&, MPoint&, Space = kCamera);
     const MPointArray& getFinalWSPoints() const;
     const MPointArray& getIntermediateCSPoints() const;
     const MPointArray getIntersectedPoints(M3dView&, Space = kCamera) const;
     void getIntersectedPoints(M3dView&, MPointArray&, Space = kCamera) const;
-    void getIntermediateCSEdgePoints(M3dView& view,
-                                     const MVGManipulatorCache::EdgeData* onPressEdgeData,
+    void getIntersectedPoints(const MVGProjectionSnapshot&, MPointArray&, Space = kCamera) const;
+    void getIntermediateCSEdgePoints(const MVGProjectionSnapshot& projection,
+                                     const MVGManipulatorCache::EdgeData& onPressEdgeData,
                                      const MPoint& onPressCSMousePos,
                                      MPointArray& intermediateCSEdgePoints);
     const MPointArray
-    getIntermediateCSEdgePoints(M3dView& view, const MVGManipulatorCache::EdgeData* onPressEdgeData,
+    getIntermediateCSEdgePoints(const MVGProjectionSnapshot& projection,
+                                const MVGManipulatorCache::EdgeData& onPressEdgeData,
                                 const MPoint& onPressCSPoint);
-    void getTranslatedWSEdgePoints(M3dView& view,
-                                   const MVGManipulatorCache::EdgeData* originEdgeData,
+    void getTranslatedWSEdgePoints(const MVGProjectionSnapshot& projection,
+                                   const MVGManipulatorCache::EdgeData& originEdgeData,
                                    MPoint& originCSPosition, MPoint& targetWSPosition,
                                    MPointArray& targetEdgeWSPositions) const;
 
@@ -55,8 +61,15 @@ public:
 
 protected:
     MVGEditCmd* newEditCmd();
+    void requestProcessInput();
+    void cancelProcessInput();
+    void flushInput();
+    bool projectOnPointCloud(const MVGAsyncPreview::Request& request,
+                             MVGAsyncPreview::Result& result);
+    /// Intersection and preview geometry for the latest mouse position
+    virtual void computePreview() {}
     void drawIntersection() const;
-    virtual void computeFinalWSPoints(M3dView& view) = 0;
+    virtual void computeFinalWSPoints(const MVGProjectionSnapshot& projection) = 0;
 
 protected:
     MVGManipulatorCache* _cache;
@@ -64,12 +77,14 @@ protected:
     MPoint _onPressCSPoint;
     MPointArray _finalWSPoints;
     int _cameraID;
-    std::vector<MVGPointCloudItem> _visiblePointCloudItems;
+    MVGAsyncPreview _preview;
     MIntArray _snapedPoints;
     bool _doDrag;
 
 private:
     MVGContext* _context;
+    /// the point cloud projections of computePreview() run on the preview worker
+    bool _isComputingPreview;
 };
 
 } // namespace
@@ -1,12 +1,21 @@
 #include "meshroomMaya/core/MVGGeometryUtil.hpp"
 #include "meshroomMaya/core/MVGMesh.hpp"
+#include "meshroomMaya/core/MVGBlindDataOrder.hpp"
 #include "meshroomMaya/core/MVGLog.hpp"
+#include "meshroomMaya/core/MVGSceneRegistry.hpp"
 #include "meshroomMaya/maya/context/MVGManipulatorCache.hpp"
-#include "meshroomMaya/maya/MVGMayaUtil.hpp"
 
+#include <maya/MFnMesh.h>
 #include <maya/MItMeshVertex.h>
 #include <maya/MItMeshEdge.h>
+#include <maya/MSpinLock.h>
 
+#include <QThread>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iterator>
 #include <list>
 
 namespace meshroomMaya
@@ -32,10 +41,488 @@ float minimumDistanceToEdge(MPoint A, MPoint B, MPoint P)
     return P.distanceTo(projection);
 }
 
+/// Average number of items per grid cell
+const int ITEMS_PER_CELL = 4;
+/// Limits the grid memory for degenerate bounding boxes
+const int MAX_CELLS_PER_AXIS = 512;
+/// Padding of the rasterized edges, relative to the cell size, against rounding errors
+const double EDGE_PADDING = 1e-6;
+
+/// Counts the items of each cell, first pass of fillGrid
+struct CellCounter
+{
+    explicit CellCounter(std::vector<int>& offsets)
+        : offsets(offsets)
+    {
+    }
+    void operator()(const int cell) { ++offsets[cell + 1]; }
+    std::vector<int>& offsets;
+};
+
+/// Stores an item in each cell, second pass of fillGrid
+struct CellFiller
+{
+    CellFiller(std::vector<int>& items, std::vector<int>& cursors)
+        : items(items)
+        , cursors(cursors)
+        , item(0)
+    {
+    }
+    void operator()(const int cell) { items[cursors[cell]++] = item; }
+    std::vector<int>& items;
+    std::vector<int>& cursors;
+    int item;
+};
+
+/// The cell of each vertex
+struct VertexCells
+{
+    VertexCells(const std::vector<double>& x, const std::vector<double>& y)
+        : x(x)
+        , y(y)
+    {
+    }
+    int getItemsCount() const { return static_cast<int>(x.size()); }
+    template <typename Visitor>
+    void operator()(const MVGManipulatorCache::CameraSpaceGrid& grid, const int vertex,
+                    Visitor& visitor) const
+    {
+        int firstX, firstY, lastX, lastY;
+        grid.getCellRange(x[vertex], y[vertex], x[vertex], y[vertex], firstX, firstY, lastX,
+                          lastY);
+        visitor(grid.getCell(firstX, firstY));
+    }
+    const std::vector<double>& x;
+    const std::vector<double>& y;
+};
+
+/**
+ * @brief The cells crossed by each edge (supercover rasterization).
+ * Each row of cells overlapped by the edge gets the cells overlapped by the part of the edge
+ * inside the row. The pickers pad their query box by the pick threshold: an edge closer than
+ * the threshold always has a point in one of the queried cells.
+ */
+struct EdgeCells
+{
+    EdgeCells(const std::vector<int>& edgeVertices, const std::vector<double>& x,
+              const std::vector<double>& y)
+        : edgeVertices(edgeVertices)
+        , x(x)
+        , y(y)
+    {
+    }
+    int getItemsCount() const { return static_cast<int>(edgeVertices.size() / 2); }
+    template <typename Visitor>
+    void operator()(const MVGManipulatorCache::CameraSpaceGrid& grid, const int edge,
+                    Visitor& visitor) const
+    {
+        const double pad = EDGE_PADDING * grid.cellSize;
+        const double ax = x[edgeVertices[2 * edge]];
+        const double ay = y[edgeVertices[2 * edge]];
+        const double bx = x[edgeVertices[2 * edge + 1]];
+        const double by = y[edgeVertices[2 * edge + 1]];
+        int firstX, firstY, lastX, lastY;
+        grid.getCellRange(std::min(ax, bx) - pad, std::min(ay, by) - pad,
+                          std::max(ax, bx) + pad, std::max(ay, by) + pad, firstX, firstY,
+                          lastX, lastY);
+        for(int cellY = firstY; cellY <= lastY; ++cellY)
+        {
+            // part of the edge inside the padded row
+            double rowMinX = std::min(ax, bx);
+            double rowMaxX = std::max(ax, bx);
+            if(ay != by && firstY != lastY)
+            {
+                const double rowMinY = grid.originY + cellY * grid.cellSize - pad;
+                const double rowMaxY = rowMinY + grid.cellSize + 2.0 * pad;
+                const double t0 = std::min(1.0, std::max(0.0, (rowMinY - ay) / (by - ay)));
+                const double t1 = std::min(1.0, std::max(0.0, (rowMaxY - ay) / (by - ay)));
+                rowMinX = ax + std::min(t0, t1) * (bx - ax);
+                rowMaxX = ax + std::max(t0, t1) * (bx - ax);
+                if(rowMinX > rowMaxX)
+                    std::swap(rowMinX, rowMaxX);
+            }
+            int rowFirstX, rowFirstY, rowLastX, rowLastY;
+            grid.getCellRange(rowMinX - pad, ay, rowMaxX + pad, ay, rowFirstX, rowFirstY,
+                              rowLastX, rowLastY);
+            for(int cellX = std::max(firstX, rowFirstX); cellX <= std::min(lastX, rowLastX);
+                ++cellX)
+                visitor(grid.getCell(cellX, cellY));
+        }
+    }
+    const std::vector<int>& edgeVertices;
+    const std::vector<double>& x;
+    const std::vector<double>& y;
+};
+
+/**
+ * @brief Fill the grid cells with the items overlapping them (count, prefix sum, then fill).
+ * @param[in] cells visits the cells overlapped by an item
+ */
+template <typename Cells>
+void fillGrid(MVGManipulatorCache::CameraSpaceGrid& grid, const Cells& cells)
+{
+    const int itemsCount = cells.getItemsCount();
+    grid.offsets.assign(grid.cellsX * grid.cellsY + 1, 0);
+    CellCounter counter(grid.offsets);
+    for(int i = 0; i < itemsCount; ++i)
+        cells(grid, i, counter);
+    for(size_t c = 1; c < grid.offsets.size(); ++c)
+        grid.offsets[c] += grid.offsets[c - 1];
+    grid.items.resize(grid.offsets.back());
+    std::vector<int> cursors(grid.offsets.begin(), grid.offsets.end() - 1);
+    CellFiller filler(grid.items, cursors);
+    for(filler.item = 0; filler.item < itemsCount; ++filler.item)
+        cells(grid, filler.item, filler);
+}
+
+/// Collects the (cell, item) pairs of some items
+struct CellCollector
+{
+    explicit CellCollector(std::vector<std::pair<int, int> >& cellItems)
+        : cellItems(cellItems)
+        , item(0)
+    {
+    }
+    void operator()(const int cell) { cellItems.push_back(std::make_pair(cell, item)); }
+    std::vector<std::pair<int, int> >& cellItems;
+    int item;
+};
+
+/// Sorted (cell, item) pairs of some items
+template <typename Cells>
+void collectCells(const MVGManipulatorCache::CameraSpaceGrid& grid, const Cells& cells,
+                  const std::vector<int>& items, std::vector<std::pair<int, int> >& cellItems)
+{
+    cellItems.clear();
+    CellCollector collector(cellItems);
+    for(size_t i = 0; i < items.size(); ++i)
+    {
+        collector.item = items[i];
+        cells(grid, items[i], collector);
+    }
+    std::sort(cellItems.begin(), cellItems.end());
+}
+
+/**
+ * @brief Move some items between the grid cells, without visiting the other items.
+ * The items of each cell stay sorted, as filled by fillGrid. The cells before the first
+ * modified one are left untouched.
+ * @param[in] oldCellItems sorted (cell, item) pairs of the items before their move
+ * @param[in] newCellItems sorted (cell, item) pairs of the items after their move
+ */
+void moveGridItems(MVGManipulatorCache::CameraSpaceGrid& grid,
+                   const std::vector<std::pair<int, int> >& oldCellItems,
+                   const std::vector<std::pair<int, int> >& newCellItems)
+{
+    typedef std::vector<std::pair<int, int> > CellItems;
+    CellItems removed;
+    CellItems added;
+    std::set_difference(oldCellItems.begin(), oldCellItems.end(), newCellItems.begin(),
+                        newCellItems.end(), std::back_inserter(removed));
+    std::set_difference(newCellItems.begin(), newCellItems.end(), oldCellItems.begin(),
+                        oldCellItems.end(), std::back_inserter(added));
+    if(removed.empty() && added.empty())
+        return;
+    int firstCell = grid.cellsX * grid.cellsY;
+    if(!removed.empty())
+        firstCell = removed.front().first;
+    if(!added.empty())
+        firstCell = std::min(firstCell, added.front().first);
+
+    // merge the items of the modified cells and the following ones
+    const int cellsCount = grid.cellsX * grid.cellsY;
+    const int firstOffset = grid.offsets[firstCell];
+    std::vector<int> items;
+    items.reserve(grid.items.size() - firstOffset + added.size());
+    CellItems::const_iterator removedIt = removed.begin();
+    CellItems::const_iterator addedIt = added.begin();
+    for(int cell = firstCell; cell < cellsCount; ++cell)
+    {
+        const int cellOffset = firstOffset + static_cast<int>(items.size());
+        for(int i = grid.offsets[cell]; i < grid.offsets[cell + 1]; ++i)
+        {
+            const int item = grid.items[i];
+            if(removedIt != removed.end() && removedIt->first == cell &&
+               removedIt->second == item)
+            {
+                ++removedIt;
+                continue;
+            }
+            for(; addedIt != added.end() && addedIt->first == cell && addedIt->second < item;
+                ++addedIt)
+                items.push_back(addedIt->second);
+            items.push_back(item);
+        }
+        for(; addedIt != added.end() && addedIt->first == cell; ++addedIt)
+            items.push_back(addedIt->second);
+        // the old offset of the next cell is read before being replaced
+        grid.offsets[cell] = cellOffset;
+    }
+    assert(removedIt == removed.end() && addedIt == added.end());
+    grid.items.resize(firstOffset + items.size());
+    std::copy(items.begin(), items.end(), grid.items.begin() + firstOffset);
+    grid.offsets[cellsCount] = static_cast<int>(grid.items.size());
+}
+
+/**
+ * @brief Build the bounding box and the picking grids of camera space positions.
+ * Only reads its arguments: can be run by a worker thread.
+ */
+void buildGrids(const std::vector<int>& edgeVertices,
+                MVGManipulatorCache::CameraSpacePositions& positions)
+{
+    const std::vector<double>& x = positions.x;
+    const std::vector<double>& y = positions.y;
+    positions.minX = *std::min_element(x.begin(), x.end());
+    positions.minY = *std::min_element(y.begin(), y.end());
+    positions.maxX = *std::max_element(x.begin(), x.end());
+    positions.maxY = *std::max_element(y.begin(), y.end());
+
+    // Vertices grid
+    const VertexCells vertexCells(x, y);
+    positions.vertexGrid.init(positions.minX, positions.minY, positions.maxX, positions.maxY,
+                              vertexCells.getItemsCount());
+    fillGrid(positions.vertexGrid, vertexCells);
+
+    // Edges grid: an edge is stored in the cells it crosses
+    const EdgeCells edgeCells(edgeVertices, x, y);
+    positions.edgeGrid.init(positions.minX, positions.minY, positions.maxX, positions.maxY,
+                            edgeCells.getItemsCount());
+    fillGrid(positions.edgeGrid, edgeCells);
+}
+
+/**
+ * @brief Project the vertices in camera space, then build the picking grids.
+ * Only reads its arguments: can be run by a worker thread.
+ */
+void computeCameraSpacePositions(const MVGProjectionSnapshot& projection,
+                                 const std::vector<MPoint>& worldPositions,
+                                 const std::vector<int>& edgeVertices,
+                                 MVGManipulatorCache::CameraSpacePositions& positions)
+{
+    const size_t verticesCount = worldPositions.size();
+    positions.x.resize(verticesCount);
+    positions.y.resize(verticesCount);
+    MPoint cameraSpacePoint;
+    for(size_t i = 0; i < verticesCount; ++i)
+    {
+        projection.worldToCamera(worldPositions[i], cameraSpacePoint);
+        positions.x[i] = cameraSpacePoint.x;
+        positions.y[i] = cameraSpacePoint.y;
+    }
+    buildGrids(edgeVertices, positions);
+}
+
+/**
+ * @brief Project some moved vertices in camera space, then move them and their edges between
+ * the cells of the picking grids.
+ * The bounding box only grows. The grids are rebuilt if a vertex leaves them.
+ * @param[in] movedVertices sorted vertex ids
+ * @param[in] movedEdges sorted ids of the edges of the moved vertices
+ */
+void updateCameraSpacePositions(const MVGProjectionSnapshot& projection,
+                                const std::vector<MPoint>& worldPositions,
+                                const std::vector<int>& edgeVertices,
+                                const std::vector<int>& movedVertices,
+                                const std::vector<int>& movedEdges,
+                                MVGManipulatorCache::CameraSpacePositions& positions)
+{
+    const VertexCells vertexCells(positions.x, positions.y);
+    const EdgeCells edgeCells(edgeVertices, positions.x, positions.y);
+    std::vector<std::pair<int, int> > oldVertexCells;
+    std::vector<std::pair<int, int> > oldEdgeCells;
+    collectCells(positions.vertexGrid, vertexCells, movedVertices, oldVertexCells);
+    collectCells(positions.edgeGrid, edgeCells, movedEdges, oldEdgeCells);
+
+    bool isInGrids = true;
+    MPoint cameraSpacePoint;
+    for(size_t i = 0; i < movedVertices.size(); ++i)
+    {
+        const int vertex = movedVertices[i];
+        projection.worldToCamera(worldPositions[vertex], cameraSpacePoint);
+        const double x = cameraSpacePoint.x;
+        const double y = cameraSpacePoint.y;
+        positions.x[vertex] = x;
+        positions.y[vertex] = y;
+        positions.minX = std::min(positions.minX, x);
+        positions.minY = std::min(positions.minY, y);
+        positions.maxX = std::max(positions.maxX, x);
+        positions.maxY = std::max(positions.maxY, y);
+        isInGrids = isInGrids && positions.vertexGrid.contains(x, y) &&
+                    positions.edgeGrid.contains(x, y);
+    }
+    if(!isInGrids)
+    {
+        buildGrids(edgeVertices, positions);
+        return;
+    }
+
+    std::vector<std::pair<int, int> > newCells;
+    collectCells(positions.vertexGrid, vertexCells, movedVertices, newCells);
+    moveGridItems(positions.vertexGrid, oldVertexCells, newCells);
+    collectCells(positions.edgeGrid, edgeCells, movedEdges, newCells);
+    moveGridItems(positions.edgeGrid, oldEdgeCells, newCells);
+}
+
+/// Whether the point is in the bounding box of the projected mesh, expanded by the threshold
+bool isInBoundingBox(const MVGManipulatorCache::CameraSpacePositions& positions,
+                     const MPoint& point, const double threshold)
+{
+    return point.x >= positions.minX - threshold && point.x <= positions.maxX + threshold &&
+           point.y >= positions.minY - threshold && point.y <= positions.maxY + threshold;
+}
+
 } // empty namespace
 
+size_t MVGManipulatorCache::CameraSpacePositions::getMemorySize() const
+{
+    return sizeof(CameraSpacePositions) + (x.capacity() + y.capacity()) * sizeof(double) +
+           (vertexGrid.offsets.capacity() + vertexGrid.items.capacity() +
+            edgeGrid.offsets.capacity() + edgeGrid.items.capacity() +
+            placedVertices.capacity()) *
+               sizeof(int);
+}
+
+bool MVGManipulatorCache::VertexData::getBlindData(const int cameraID,
+                                                   MPoint& clickedCSPosition) const
+{
+    const int first = mesh->blindDataOffsets[index];
+    const int last = mesh->blindDataOffsets[index + 1];
+    if(first == last)
+        return false;
+    // blind data are sorted by camera id
+    const MVGMesh::ClickedCSPosition* begin = &mesh->blindData[first];
+    const MVGMesh::ClickedCSPosition* it =
+        blindDataOrder::find(begin, begin + (last - first), cameraID);
+    if(!it)
+        return false;
+    clickedCSPosition = MPoint(it->x, it->y);
+    return true;
+}
+
+void MVGManipulatorCache::VertexData::getBlindData(
+    std::map<int, MPoint>& cameraToClickedCSPoints) const
+{
+    for(int i = mesh->blindDataOffsets[index]; i < mesh->blindDataOffsets[index + 1]; ++i)
+    {
+        const MVGMesh::ClickedCSPosition& blindData = mesh->blindData[i];
+        cameraToClickedCSPoints[blindData.cameraId] = MPoint(blindData.x, blindData.y);
+    }
+}
+
+MVGManipulatorCache::CameraSpaceGrid::CameraSpaceGrid()
+    : cellsX(0)
+    , cellsY(0)
+    , originX(0.0)
+    , originY(0.0)
+    , cellSize(1.0)
+{
+}
+
+void MVGManipulatorCache::CameraSpaceGrid::init(const double minX, const double minY,
+                                                const double maxX, const double maxY,
+                                                const int itemsCount)
+{
+    originX = minX;
+    originY = minY;
+    const double width = std::max(maxX - minX, 0.0);
+    const double height = std::max(maxY - minY, 0.0);
+    // square cells holding ITEMS_PER_CELL items on average
+    const double cellsCount = std::max(1.0, (double)itemsCount / ITEMS_PER_CELL);
+    const double extent = std::max(width, height);
+    cellSize = std::sqrt(std::max(width * height, extent * extent / cellsCount) / cellsCount);
+    if(cellSize <= 0.0)
+        cellSize = 1.0;
+    cellsX = std::min(MAX_CELLS_PER_AXIS, std::max(1, (int)std::ceil(width / cellSize)));
+    cellsY = std::min(MAX_CELLS_PER_AXIS, std::max(1, (int)std::ceil(height / cellSize)));
+    cellSize = std::max(cellSize, std::max(width / cellsX, height / cellsY));
+    offsets.assign(cellsX * cellsY + 1, 0);
+    items.clear();
+}
+
+bool MVGManipulatorCache::CameraSpaceGrid::contains(const double x, const double y) const
+{
+    return x >= originX && x <= originX + cellsX * cellSize && y >= originY &&
+           y <= originY + cellsY * cellSize;
+}
+
+void MVGManipulatorCache::CameraSpaceGrid::getCellRange(const double minX, const double minY,
+                                                        const double maxX, const double maxY,
+                                                        int& firstX, int& firstY, int& lastX,
+                                                        int& lastY) const
+{
+    // items on the maximum border belong to the last cells
+    firstX = std::min(cellsX - 1, std::max(0, (int)std::floor((minX - originX) / cellSize)));
+    firstY = std::min(cellsY - 1, std::max(0, (int)std::floor((minY - originY) / cellSize)));
+    lastX = std::max(0, std::min(cellsX - 1, (int)std::floor((maxX - originX) / cellSize)));
+    lastY = std::max(0, std::min(cellsY - 1, (int)std::floor((maxY - originY) / cellSize)));
+}
+
+/**
+ * @brief Camera space positions computed by a worker thread, for one camera.
+ * The inputs are shared copies of the mesh data, so that the worker thread never reads the
+ * cache.
+ */
+struct MVGManipulatorCache::PrefetchJob
+{
+    PrefetchJob(const MVGProjectionSnapshot& projection, const int cameraID)
+        : projection(projection)
+        , cameraID(cameraID)
+        , isDone(false)
+        , isAbandoned(false)
+    {
+    }
+    const MVGProjectionSnapshot projection;
+    const int cameraID;
+    // per mesh
+    std::vector<std::string> meshNames;
+    std::vector<int> generations;
+    std::vector<std::shared_ptr<const PrefetchGeometry> > geometries;
+    std::vector<CameraSpacePositions> positions;
+    /// protects isDone and isAbandoned
+    MSpinLock lock;
+    bool isDone;
+    /// the cache is being destroyed: the worker thread skips the remaining meshes
+    bool isAbandoned;
+};
+
+// static
+std::map<std::string, MVGManipulatorCache::DirtyMesh> MVGManipulatorCache::_dirtyMeshes;
+// static
+int MVGManipulatorCache::_generationsCount = 0;
+// static
+size_t MVGManipulatorCache::_memoryBudget = 256 * 1024 * 1024;
+
 MVGManipulatorCache::MVGManipulatorCache()
+    : _evictionsCount(0)
+{
+}
+
+MVGManipulatorCache::~MVGManipulatorCache()
 {
+    // the running jobs stop after their current mesh
+    for(size_t i = 0; i < _prefetchJobs.size(); ++i)
+    {
+        PrefetchJob* job = _prefetchJobs[i];
+        job->lock.lock();
+        job->isAbandoned = true;
+        job->lock.unlock();
+    }
+    for(size_t i = 0; i < _prefetchJobs.size(); ++i)
+    {
+        PrefetchJob* job = _prefetchJobs[i];
+        while(true)
+        {
+            job->lock.lock();
+            const bool isDone = job->isDone;
+            job->lock.unlock();
+            if(isDone)
+                break;
+            QThread::yieldCurrentThread();
+        }
+        delete job;
+        MThreadAsync::release();
+    }
 }
 
 void MVGManipulatorCache::setActiveView(const M3dView& view)
@@ -94,6 +581,7 @@ const MVGManipulatorCache::MeshData& MVGManipulatorCache::getMeshData(const std:
 }
 void MVGManipulatorCache::rebuildMeshesCache()
 {
+    _dirtyMeshes.clear();
     // List all meshes currently stored in meshData
     std::list<std::string> meshesList;
     for(std::map<std::string, MeshData>::iterator it = _meshData.begin(); it != _meshData.end();
@@ -120,6 +608,7 @@ void MVGManipulatorCache::rebuildMeshCache(const MDagPath& path)
 {
     if(!path.isValid())
         return;
+    _dirtyMeshes.erase(path.fullPathName().asChar());
     MVGMesh mesh(path);
     // Remove non active mesh
     if(!mesh.isActive())
@@ -138,9 +627,9 @@ void MVGManipulatorCache::rebuildMeshCache(const MDagPath& path)
     {
         type = _selectedComponent.type;
         if(type == MFn::kBlindData || type == MFn::kMeshVertComponent)
-            index = _selectedComponent.vertex->index;
+            index = _selectedComponent.vertex.index;
         if(type == MFn::kMeshEdgeComponent)
-            index = _selectedComponent.edge->index;
+            index = _selectedComponent.edge.index;
     }
 
     // Clear component associated to meshData
@@ -163,8 +652,12 @@ void MVGManipulatorCache::rebuildMeshCache(const MDagPath& path)
     const std::string pathsString = path.fullPathName().asChar();
     _meshData[pathsString] = MeshData();
     MeshData& newMeshData = _meshData[pathsString];
-    newMeshData.vertices.resize(vIt.count());
-    newMeshData.edges.resize(eIt.count());
+    newMeshData.path = path;
+    newMeshData.generation = ++_generationsCount;
+    const int verticesCount = vIt.count();
+    newMeshData.worldPositions.resize(verticesCount);
+    newMeshData.numConnectedEdges.resize(verticesCount, -1);
+    newMeshData.edgeVertices.resize(2 * eIt.count(), 0);
     // fill it with vertices data
     while(!vIt.isDone())
     {
@@ -172,27 +665,31 @@ void MVGManipulatorCache::rebuildMeshCache(const MDagPath& path)
         CHECK(status)
         int numConnectedEdges = -1;
         CHECK(vIt.numConnectedEdges(numConnectedEdges))
-        // blind data
-        VertexData& vertex = newMeshData.vertices[index];
-        vertex.index = index;
-        vertex.numConnectedEdges = numConnectedEdges;
-        vertex.worldPosition = vIt.position(MSpace::kWorld, &status);
-        mesh.getBlindData(index, vertex.blindData);
+        newMeshData.numConnectedEdges[index] = numConnectedEdges;
+        newMeshData.worldPositions[index] = vIt.position(MSpace::kWorld, &status);
         vIt.next();
     }
+    // blind data, sorted by camera id for each vertex
+    status = mesh.getAllBlindData(newMeshData.blindDataOffsets, newMeshData.blindData);
+    if(!status || (int)newMeshData.blindDataOffsets.size() != verticesCount + 1)
+    {
+        newMeshData.blindDataOffsets.assign(verticesCount + 1, 0);
+        newMeshData.blindData.clear();
+    }
+    for(int index = 0; index < verticesCount; ++index)
+    {
+        std::sort(newMeshData.blindData.begin() + newMeshData.blindDataOffsets[index],
+                  newMeshData.blindData.begin() + newMeshData.blindDataOffsets[index + 1],
+                  blindDataOrder::isLess<MVGMesh::ClickedCSPosition>);
+    }
     // fill it w/ edges data
     while(!eIt.isDone())
     {
-        assert(eIt.index(0) < newMeshData.vertices.size());
-        assert(eIt.index(1) < newMeshData.vertices.size());
-        std::vector<VertexData>::iterator v1It = newMeshData.vertices.begin();
-        std::vector<VertexData>::iterator v2It = newMeshData.vertices.begin();
-        v1It += eIt.index(0);
-        v2It += eIt.index(1);
-        EdgeData& edge = newMeshData.edges[eIt.index()];
-        edge.index = eIt.index();
-        edge.vertex1 = &(*v1It);
-        edge.vertex2 = &(*v2It);
+        assert(eIt.index(0) < verticesCount);
+        assert(eIt.index(1) < verticesCount);
+        const int index = eIt.index();
+        newMeshData.edgeVertices[2 * index] = eIt.index(0);
+        newMeshData.edgeVertices[2 * index + 1] = eIt.index(1);
         eIt.next();
     }
 
@@ -203,13 +700,86 @@ void MVGManipulatorCache::rebuildMeshCache(const MDagPath& path)
 void MVGManipulatorCache::checkForCameraSpacePositions(M3dView& view, MeshData& meshData,
                                                        const int cameraID)
 {
-    if(meshData.vertices.empty())
+    if(meshData.worldPositions.empty())
         return;
-    std::map<int, MPoint>& cameraSpacePoints = meshData.vertices.begin()->cameraSpacePoints;
-    std::map<int, MPoint>::iterator cameraIt = cameraSpacePoints.find(cameraID);
+    bool isCacheGrowing = collectPrefetchJobs();
     // We compute position only if there are not in the cache to avoid computing them all the time
-    if(cameraIt == cameraSpacePoints.end())
+    if(meshData.cameraSpacePositions.find(cameraID) == meshData.cameraSpacePositions.end())
+    {
         computeMeshCacheForCameraID(view, meshData, cameraID);
+        isCacheGrowing = true;
+    }
+    useCamera(cameraID);
+    if(isCacheGrowing)
+        applyMemoryBudget();
+}
+
+/**
+ * @brief Move the camera to the front of the recently used cameras.
+ */
+void MVGManipulatorCache::useCamera(const int cameraID)
+{
+    if(!_recentCameraIDs.empty() && _recentCameraIDs.front() == cameraID)
+        return;
+    _recentCameraIDs.remove(cameraID);
+    _recentCameraIDs.push_front(cameraID);
+}
+
+/**
+ * @brief Evict the least recently used cameras until the camera space positions fit in the
+ * memory budget. The cameras of the MeshroomMaya panels are never evicted.
+ */
+void MVGManipulatorCache::applyMemoryBudget()
+{
+    std::map<int, size_t> cameraMemorySizes;
+    size_t memorySize = 0;
+    for(std::map<std::string, MeshData>::const_iterator meshIt = _meshData.begin();
+        meshIt != _meshData.end(); ++meshIt)
+    {
+        const std::map<int, CameraSpacePositions>& cameraSpacePositions =
+            meshIt->second.cameraSpacePositions;
+        for(std::map<int, CameraSpacePositions>::const_iterator it = cameraSpacePositions.begin();
+            it != cameraSpacePositions.end(); ++it)
+        {
+            const size_t size = it->second.getMemorySize();
+            cameraMemorySizes[it->first] += size;
+            memorySize += size;
+        }
+    }
+    if(memorySize <= _memoryBudget)
+        return;
+
+    std::vector<int> panelCameraIDs;
+    const char* panelNames[] = {"mvgLPanel", "mvgRPanel"};
+    for(int i = 0; i < 2; ++i)
+    {
+        M3dView view;
+        MDagPath cameraPath;
+        if(!M3dView::getM3dViewFromModelEditor(panelNames[i], view) || !view.getCamera(cameraPath))
+            continue;
+        const MVGCamera camera(cameraPath);
+        if(camera.isValid())
+            panelCameraIDs.push_back(camera.getId());
+    }
+    std::list<int>::iterator it = _recentCameraIDs.end();
+    while(memorySize > _memoryBudget && it != _recentCameraIDs.begin())
+    {
+        --it;
+        const int cameraID = *it;
+        if(std::find(panelCameraIDs.begin(), panelCameraIDs.end(), cameraID) !=
+           panelCameraIDs.end())
+            continue;
+        it = _recentCameraIDs.erase(it);
+        const std::map<int, size_t>::const_iterator sizeIt = cameraMemorySizes.find(cameraID);
+        if(sizeIt == cameraMemorySizes.end())
+            continue;
+        // the total is only computed once: the evicted sizes are subtracted from it
+        memorySize -= sizeIt->second;
+        for(std::map<std::string, MeshData>::iterator meshIt = _meshData.begin();
+            meshIt != _meshData.end(); ++meshIt)
+            meshIt->second.cameraSpacePositions.erase(cameraID);
+        ++_evictionsCount;
+    }
 }
 
 /**
@@ -217,35 +787,347 @@ void MVGManipulatorCache::checkForCameraSpacePositions(M3dView& view, MeshData&
  * @param view
  * @param meshData
  * @param cameraID
- * @brief Compute camera space coordinates and add it to mesh cache
+ * @brief Compute camera space coordinates and add it to mesh cache, with the picking grids
  */
 void MVGManipulatorCache::computeMeshCacheForCameraID(M3dView& view, MeshData& meshData,
                                                       const int cameraID)
 {
-    std::vector<VertexData>& vertices = meshData.vertices;
-    for(std::vector<VertexData>::iterator vertexIt = vertices.begin(); vertexIt != vertices.end();
-        ++vertexIt)
+    const MVGProjectionSnapshot projection(view);
+    // Add new camera
+    CameraSpacePositions& positions = meshData.cameraSpacePositions[cameraID];
+    computeCameraSpacePositions(projection, meshData.worldPositions, meshData.edgeVertices,
+                                positions);
+    updatePlacedVertices(meshData, cameraID, positions);
+}
+
+/**
+ * @brief List the vertices placed in the camera
+ */
+// static
+void MVGManipulatorCache::updatePlacedVertices(const MeshData& meshData, const int cameraID,
+                                               CameraSpacePositions& positions)
+{
+    const int verticesCount = meshData.getVerticesCount();
+    positions.placedVertices.clear();
+    MPoint clickedCSPosition;
+    for(int i = 0; i < verticesCount; ++i)
     {
-        // Add new camera
-        std::map<int, MPoint>& cameraSpacePoints = vertexIt->cameraSpacePoints;
-        cameraSpacePoints[cameraID] =
-            MVGGeometryUtil::worldToCameraSpace(view, vertexIt->worldPosition);
+        if(VertexData(&meshData, i).getBlindData(cameraID, clickedCSPosition))
+            positions.placedVertices.push_back(i);
     }
 }
 
-void MVGManipulatorCache::removeMeshCacheForCameraID(const int cameraID)
+/**
+ * @brief Update the placed vertices of the camera for some modified vertices
+ * @param[in] vertexIds sorted ids of the modified vertices
+ */
+// static
+void MVGManipulatorCache::updatePlacedVertices(const MeshData& meshData, const int cameraID,
+                                               const std::vector<int>& vertexIds,
+                                               CameraSpacePositions& positions)
 {
-    for(std::map<std::string, MeshData>::iterator meshIt = _meshData.begin();
-        meshIt != _meshData.end(); ++meshIt)
+    std::vector<int> placedVertices;
+    placedVertices.reserve(positions.placedVertices.size() + vertexIds.size());
+    std::set_difference(positions.placedVertices.begin(), positions.placedVertices.end(),
+                        vertexIds.begin(), vertexIds.end(), std::back_inserter(placedVertices));
+    const size_t keptCount = placedVertices.size();
+    MPoint clickedCSPosition;
+    for(size_t i = 0; i < vertexIds.size(); ++i)
+    {
+        if(VertexData(&meshData, vertexIds[i]).getBlindData(cameraID, clickedCSPosition))
+            placedVertices.push_back(vertexIds[i]);
+    }
+    std::inplace_merge(placedVertices.begin(), placedVertices.begin() + keptCount,
+                       placedVertices.end());
+    positions.placedVertices.swap(placedVertices);
+}
+
+void MVGManipulatorCache::prefetchCameraSpacePositions(
+    const MString& panelName, const std::vector<MDagPath>& neighbourCameras)
+{
+    M3dView view;
+    MStatus status = M3dView::getM3dViewFromModelEditor(panelName, view);
+    CHECK_RETURN(status)
+    view.updateViewingParameters();
+    const MVGProjectionSnapshot projection(view);
+    const MVGCamera camera(projection.getCameraPath());
+    if(!camera.isValid())
+        return;
+    startPrefetchJob(projection, camera.getId());
+    for(size_t i = 0; i < neighbourCameras.size(); ++i)
     {
-        std::vector<VertexData>& vertices = meshIt->second.vertices;
-        for(std::vector<VertexData>::iterator vertexIt = vertices.begin();
-            vertexIt != vertices.end(); ++vertexIt)
+        const MVGCamera neighbourCamera(neighbourCameras[i]);
+        if(!neighbourCamera.isValid() || !projection.hasSameFilmProjection(neighbourCameras[i]))
+            continue;
+        startPrefetchJob(MVGProjectionSnapshot(projection, neighbourCameras[i]),
+                         neighbourCamera.getId());
+    }
+}
+
+void MVGManipulatorCache::startPrefetchJob(const MVGProjectionSnapshot& projection,
+                                           const int cameraID)
+{
+    for(size_t i = 0; i < _prefetchJobs.size(); ++i)
+    {
+        if(_prefetchJobs[i]->cameraID == cameraID)
+            return;
+    }
+    PrefetchJob* job = new PrefetchJob(projection, cameraID);
+    for(std::map<std::string, MeshData>::iterator it = _meshData.begin(); it != _meshData.end();
+        ++it)
+    {
+        MeshData& meshData = it->second;
+        if(meshData.worldPositions.empty() ||
+           meshData.cameraSpacePositions.find(cameraID) != meshData.cameraSpacePositions.end())
+            continue;
+        // copied once per generation, for all the cameras
+        if(!meshData.prefetchGeometry ||
+           meshData.prefetchGeometry->generation != meshData.generation)
         {
-            std::map<int, MPoint>& cameraSpacePoints = vertexIt->cameraSpacePoints;
-            cameraSpacePoints.erase(cameraID);
+            PrefetchGeometry* geometry = new PrefetchGeometry;
+            geometry->generation = meshData.generation;
+            geometry->worldPositions = meshData.worldPositions;
+            geometry->edgeVertices = meshData.edgeVertices;
+            meshData.prefetchGeometry.reset(geometry);
         }
+        job->meshNames.push_back(it->first);
+        job->generations.push_back(meshData.generation);
+        job->geometries.push_back(meshData.prefetchGeometry);
     }
+    if(job->meshNames.empty())
+    {
+        delete job;
+        return;
+    }
+    job->positions.resize(job->meshNames.size());
+    MStatus status = MThreadAsync::init();
+    if(!status)
+    {
+        delete job;
+        return;
+    }
+    _prefetchJobs.push_back(job);
+    status = MThreadAsync::createTask(prefetchTask, job, prefetchTaskDone, job);
+    if(status)
+        return;
+    // the positions will be computed lazily
+    _prefetchJobs.pop_back();
+    delete job;
+    MThreadAsync::release();
+}
+
+/**
+ * @brief Add the results of the finished jobs to the mesh data, in the main thread.
+ */
+bool MVGManipulatorCache::collectPrefetchJobs()
+{
+    bool isCacheGrowing = false;
+    std::vector<PrefetchJob*>::iterator jobIt = _prefetchJobs.begin();
+    while(jobIt != _prefetchJobs.end())
+    {
+        PrefetchJob* job = *jobIt;
+        job->lock.lock();
+        const bool isDone = job->isDone;
+        job->lock.unlock();
+        if(!isDone)
+        {
+            ++jobIt;
+            continue;
+        }
+        for(size_t m = 0; m < job->meshNames.size(); ++m)
+        {
+            std::map<std::string, MeshData>::iterator meshIt = _meshData.find(job->meshNames[m]);
+            // the mesh has been removed, rebuilt or patched since the job started
+            if(meshIt == _meshData.end() || meshIt->second.generation != job->generations[m])
+                continue;
+            MeshData& meshData = meshIt->second;
+            // already computed lazily
+            if(meshData.cameraSpacePositions.find(job->cameraID) !=
+               meshData.cameraSpacePositions.end())
+                continue;
+            CameraSpacePositions& positions = meshData.cameraSpacePositions[job->cameraID];
+            std::swap(positions, job->positions[m]);
+            updatePlacedVertices(meshData, job->cameraID, positions);
+            isCacheGrowing = true;
+        }
+        // prefetched cameras count as recently used
+        if(std::find(_recentCameraIDs.begin(), _recentCameraIDs.end(), job->cameraID) ==
+           _recentCameraIDs.end())
+            _recentCameraIDs.push_front(job->cameraID);
+        delete job;
+        jobIt = _prefetchJobs.erase(jobIt);
+        MThreadAsync::release();
+    }
+    return isCacheGrowing;
+}
+
+// static
+MThreadRetVal MVGManipulatorCache::prefetchTask(void* data)
+{
+    PrefetchJob* job = static_cast<PrefetchJob*>(data);
+    for(size_t m = 0; m < job->meshNames.size(); ++m)
+    {
+        job->lock.lock();
+        const bool isAbandoned = job->isAbandoned;
+        job->lock.unlock();
+        if(isAbandoned)
+            break;
+        computeCameraSpacePositions(job->projection, job->geometries[m]->worldPositions,
+                                    job->geometries[m]->edgeVertices, job->positions[m]);
+    }
+    return 0;
+}
+
+// static
+void MVGManipulatorCache::prefetchTaskDone(void* data)
+{
+    PrefetchJob* job = static_cast<PrefetchJob*>(data);
+    job->lock.lock();
+    job->isDone = true;
+    job->lock.unlock();
+}
+
+// static
+void MVGManipulatorCache::setMeshDirty(const MDagPath& path, const MIntArray& vertexIds)
+{
+    if(!path.isValid())
+        return;
+    DirtyMesh& dirtyMesh = _dirtyMeshes[path.fullPathName().asChar()];
+    dirtyMesh.path = path;
+    if(vertexIds.length() == 0)
+        dirtyMesh.isTopologyDirty = true;
+    for(unsigned int i = 0; i < vertexIds.length(); ++i)
+        dirtyMesh.vertexIds.insert(vertexIds[i]);
+}
+
+void MVGManipulatorCache::updateDirtyMeshes()
+{
+    // rebuildMeshCache removes the mesh from the dirty meshes
+    std::map<std::string, DirtyMesh> dirtyMeshes;
+    dirtyMeshes.swap(_dirtyMeshes);
+    for(std::map<std::string, DirtyMesh>::const_iterator it = dirtyMeshes.begin();
+        it != dirtyMeshes.end(); ++it)
+    {
+        const DirtyMesh& dirtyMesh = it->second;
+        std::map<std::string, MeshData>::iterator meshIt = _meshData.find(it->first);
+        if(dirtyMesh.isTopologyDirty || meshIt == _meshData.end() ||
+           !updateMeshCacheVertices(meshIt->second, dirtyMesh.vertexIds))
+            rebuildMeshCache(dirtyMesh.path);
+    }
+}
+
+/**
+ * @brief Patch the world positions, blind data and camera space positions of some vertices.
+ * Camera space positions of the cameras whose film projection differs from the active one are
+ * removed, to be computed again when needed.
+ * @return false if the mesh cache needs to be rebuilt
+ */
+bool MVGManipulatorCache::updateMeshCacheVertices(MeshData& meshData,
+                                                  const std::set<int>& vertexIds)
+{
+    MVGMesh mesh(meshData.path);
+    const int verticesCount = meshData.getVerticesCount();
+    if(!mesh.isValid() || !mesh.isActive() || mesh.getVerticesCount() != verticesCount)
+        return false;
+    if(!vertexIds.empty() && (*vertexIds.begin() < 0 || *vertexIds.rbegin() >= verticesCount))
+        return false;
+
+    // world positions
+    MStatus status;
+    MFnMesh fnMesh(meshData.path, &status);
+    CHECK_RETURN_VARIABLE(status, false)
+    for(std::set<int>::const_iterator it = vertexIds.begin(); it != vertexIds.end(); ++it)
+    {
+        status = fnMesh.getPoint(*it, meshData.worldPositions[*it], MSpace::kWorld);
+        CHECK_RETURN_VARIABLE(status, false)
+    }
+
+    // blind data: only the modified vertices are replaced
+    MIntArray modifiedIds;
+    for(std::set<int>::const_iterator it = vertexIds.begin(); it != vertexIds.end(); ++it)
+        modifiedIds.append(*it);
+    std::vector<std::vector<MVGMesh::ClickedCSPosition> > modifiedBlindData;
+    status = mesh.getBlindData(modifiedIds, modifiedBlindData);
+    CHECK_RETURN_VARIABLE(status, false)
+    std::vector<int> blindDataOffsets(verticesCount + 1);
+    std::vector<MVGMesh::ClickedCSPosition> blindData;
+    blindData.reserve(meshData.blindData.size());
+    unsigned int modifiedIndex = 0;
+    for(int index = 0; index < verticesCount; ++index)
+    {
+        blindDataOffsets[index] = static_cast<int>(blindData.size());
+        if(modifiedIndex == modifiedIds.length() || modifiedIds[modifiedIndex] != index)
+        {
+            blindData.insert(blindData.end(),
+                             meshData.blindData.begin() + meshData.blindDataOffsets[index],
+                             meshData.blindData.begin() + meshData.blindDataOffsets[index + 1]);
+            continue;
+        }
+        std::vector<MVGMesh::ClickedCSPosition>& vertexBlindData =
+            modifiedBlindData[modifiedIndex++];
+        std::sort(vertexBlindData.begin(), vertexBlindData.end(),
+                  blindDataOrder::isLess<MVGMesh::ClickedCSPosition>);
+        blindData.insert(blindData.end(), vertexBlindData.begin(), vertexBlindData.end());
+    }
+    blindDataOffsets[verticesCount] = static_cast<int>(blindData.size());
+    meshData.blindDataOffsets.swap(blindDataOffsets);
+    meshData.blindData.swap(blindData);
+    meshData.generation = ++_generationsCount;
+    // the running prefetch jobs keep their own reference
+    meshData.prefetchGeometry.reset();
+    if(meshData.cameraSpacePositions.empty())
+        return true;
+
+    // camera space positions: only the modified vertices and their edges are updated
+    const std::vector<int> movedVertices(vertexIds.begin(), vertexIds.end());
+    std::vector<char> isMoved(verticesCount, 0);
+    for(size_t i = 0; i < movedVertices.size(); ++i)
+        isMoved[movedVertices[i]] = 1;
+    std::vector<int> movedEdges;
+    const int edgesCount = meshData.getEdgesCount();
+    for(int edge = 0; edge < edgesCount; ++edge)
+    {
+        if(isMoved[meshData.edgeVertices[2 * edge]] || isMoved[meshData.edgeVertices[2 * edge + 1]])
+            movedEdges.push_back(edge);
+    }
+    // the other cameras are projected through the active view, as when prefetched
+    const int activeCameraID = _activeCamera.getId();
+    const MVGProjectionSnapshot activeProjection(_activeView);
+    std::map<int, CameraSpacePositions>::iterator positionsIt =
+        meshData.cameraSpacePositions.begin();
+    while(positionsIt != meshData.cameraSpacePositions.end())
+    {
+        const int cameraID = positionsIt->first;
+        MDagPath cameraPath;
+        if(cameraID != activeCameraID &&
+           (!MVGSceneRegistry::getCameraPath(cameraID, cameraPath) ||
+            !activeProjection.hasSameFilmProjection(cameraPath)))
+        {
+            // computed again when needed
+            meshData.cameraSpacePositions.erase(positionsIt++);
+            continue;
+        }
+        CameraSpacePositions& positions = positionsIt->second;
+        if(cameraID == activeCameraID)
+            updateCameraSpacePositions(activeProjection, meshData.worldPositions,
+                                       meshData.edgeVertices, movedVertices, movedEdges,
+                                       positions);
+        else
+            updateCameraSpacePositions(MVGProjectionSnapshot(activeProjection, cameraPath),
+                                       meshData.worldPositions, meshData.edgeVertices,
+                                       movedVertices, movedEdges, positions);
+        updatePlacedVertices(meshData, cameraID, movedVertices, positions);
+        ++positionsIt;
+    }
+    return true;
+}
+
+void MVGManipulatorCache::removeMeshCacheForCameraID(const int cameraID)
+{
+    _recentCameraIDs.remove(cameraID);
+    for(std::map<std::string, MeshData>::iterator meshIt = _meshData.begin();
+        meshIt != _meshData.end(); ++meshIt)
+        meshIt->second.cameraSpacePositions.erase(cameraID);
 }
 
 void MVGManipulatorCache::setSelectedComponent(const MVGComponent& selectedComponent)
@@ -269,15 +1151,21 @@ void MVGManipulatorCache::updateSelectedComponent(const MDagPath& meshPath, cons
     component.meshPath = meshPath;
 
     const std::string meshPathString = meshPath.fullPathName().asChar();
+    std::map<std::string, MeshData>::const_iterator it = _meshData.find(meshPathString);
+    if(it == _meshData.end())
+        return;
+    const MeshData& meshData = it->second;
     if(type == MFn::kMeshVertComponent || type == MFn::kBlindData)
     {
-        std::map<std::string, MeshData>::iterator it = _meshData.find(meshPathString);
-        if(it == _meshData.end())
+        if(index < 0 || meshData.getVerticesCount() <= index)
             return;
-        std::vector<VertexData>& verticesArray = _meshData[meshPathString].vertices;
-        if(verticesArray.size() <= index)
+        component.vertex = VertexData(&meshData, index);
+    }
+    if(type == MFn::kMeshEdgeComponent)
+    {
+        if(index < 0 || meshData.getEdgesCount() <= index)
             return;
-        component.vertex = &(verticesArray[index]);
+        component.edge = EdgeData(&meshData, index);
     }
     _selectedComponent = component;
 }
@@ -291,35 +1179,46 @@ bool MVGManipulatorCache::isIntersectingBlindData(const double tolerance,
     const double threshold =
         (tolerance * _activeCamera.getZoom()) / (double)_activeView.portWidth();
     const int cameraID = _activeCamera.getId();
-    // check each mesh vertices
+    // find the nearest placed vertex among all meshes
+    const MeshData* nearestMesh = NULL;
+    int nearestIndex = -1;
+    double nearestDistance = 0.0;
     std::map<std::string, MeshData>::iterator meshIt = _meshData.begin();
     for(; meshIt != _meshData.end(); ++meshIt)
     {
-        std::vector<VertexData>& vertices = meshIt->second.vertices;
-        std::vector<VertexData>::iterator vertexIt = vertices.begin();
-        for(; vertexIt < vertices.end(); ++vertexIt)
+        checkForCameraSpacePositions(_activeView, meshIt->second, cameraID);
+        const MeshData& meshData = meshIt->second;
+        std::map<int, CameraSpacePositions>::const_iterator positionsIt =
+            meshData.cameraSpacePositions.find(cameraID);
+        if(positionsIt == meshData.cameraSpacePositions.end())
+            continue;
+        const std::vector<int>& placedVertices = positionsIt->second.placedVertices;
+        for(size_t i = 0; i < placedVertices.size(); ++i)
         {
-            std::map<int, MPoint>::const_iterator blindDataIt = vertexIt->blindData.find(cameraID);
-            if(blindDataIt == vertexIt->blindData.end())
+            const VertexData vertex(&meshData, placedVertices[i]);
+            MPoint pointCSPosition;
+            if(!vertex.getBlindData(cameraID, pointCSPosition))
                 continue;
-            MPoint pointCSPosition = blindDataIt->second;
             // check if we intersect w/ the vertex position
-            if(mouseCSPosition.x <= pointCSPosition.x + threshold &&
-               mouseCSPosition.x >= pointCSPosition.x - threshold &&
-               mouseCSPosition.y <= pointCSPosition.y + threshold &&
-               mouseCSPosition.y >= pointCSPosition.y - threshold)
-            {
-                MDagPath meshPath;
-                MVGMayaUtil::getDagPathByName(meshIt->first.c_str(), meshPath);
-                _intersectedComponent.type = MFn::kBlindData;
-                _intersectedComponent.meshPath = meshPath;
-                _intersectedComponent.vertex = &(*vertexIt);
-                _intersectedComponent.edge = NULL;
-                return true;
-            }
+            const double dx = std::fabs(mouseCSPosition.x - pointCSPosition.x);
+            const double dy = std::fabs(mouseCSPosition.y - pointCSPosition.y);
+            if(dx > threshold || dy > threshold)
+                continue;
+            const double distance = dx * dx + dy * dy;
+            if(nearestMesh && distance >= nearestDistance)
+                continue;
+            nearestMesh = &meshData;
+            nearestIndex = vertex.index;
+            nearestDistance = distance;
         }
     }
-    return false;
+    if(!nearestMesh)
+        return false;
+    _intersectedComponent.type = MFn::kBlindData;
+    _intersectedComponent.meshPath = nearestMesh->path;
+    _intersectedComponent.vertex = VertexData(nearestMesh, nearestIndex);
+    _intersectedComponent.edge = EdgeData();
+    return true;
 }
 
 bool MVGManipulatorCache::isIntersectingPoint(const double tolerance, const MPoint& mouseCSPosition)
@@ -330,7 +1229,10 @@ bool MVGManipulatorCache::isIntersectingPoint(const double tolerance, const MPoi
     double threshold = (tolerance * _activeCamera.getZoom()) / (double)_activeView.portWidth();
 
     int cameraID = _activeCamera.getId();
-    // check each mesh vertice
+    // find the nearest vertex among all meshes
+    const MeshData* nearestMesh = NULL;
+    int nearestIndex = -1;
+    double nearestDistance = 0.0;
     std::map<std::string, MeshData>::iterator meshIt = _meshData.begin();
     for(; meshIt != _meshData.end(); ++meshIt)
     {
@@ -339,28 +1241,49 @@ bool MVGManipulatorCache::isIntersectingPoint(const double tolerance, const MPoi
         // time
         checkForCameraSpacePositions(_activeView, meshIt->second, cameraID);
 
-        std::vector<VertexData>& vertices = meshIt->second.vertices;
-        std::vector<VertexData>::iterator vertexIt = vertices.begin();
-        for(; vertexIt < vertices.end(); ++vertexIt)
+        const MeshData& meshData = meshIt->second;
+        std::map<int, CameraSpacePositions>::const_iterator positionsIt =
+            meshData.cameraSpacePositions.find(cameraID);
+        if(positionsIt == meshData.cameraSpacePositions.end())
+            continue;
+        const CameraSpacePositions& positions = positionsIt->second;
+        if(!isInBoundingBox(positions, mouseCSPosition, threshold))
+            continue;
+        const CameraSpaceGrid& grid = positions.vertexGrid;
+        int firstX, firstY, lastX, lastY;
+        grid.getCellRange(mouseCSPosition.x - threshold, mouseCSPosition.y - threshold,
+                          mouseCSPosition.x + threshold, mouseCSPosition.y + threshold, firstX,
+                          firstY, lastX, lastY);
+        for(int cellY = firstY; cellY <= lastY; ++cellY)
         {
-            // check if we intersect w/ the real vertex position projection
-            MPoint& realCSVertexPosition = vertexIt->cameraSpacePoints[cameraID];
-            if(mouseCSPosition.x <= realCSVertexPosition.x + threshold &&
-               mouseCSPosition.x >= realCSVertexPosition.x - threshold &&
-               mouseCSPosition.y <= realCSVertexPosition.y + threshold &&
-               mouseCSPosition.y >= realCSVertexPosition.y - threshold)
+            for(int cellX = firstX; cellX <= lastX; ++cellX)
             {
-                MDagPath meshPath;
-                MVGMayaUtil::getDagPathByName(meshIt->first.c_str(), meshPath);
-                _intersectedComponent.type = MFn::kMeshVertComponent;
-                _intersectedComponent.meshPath = meshPath;
-                _intersectedComponent.vertex = &(*vertexIt);
-                _intersectedComponent.edge = NULL;
-                return true;
+                const int cell = grid.getCell(cellX, cellY);
+                for(int i = grid.offsets[cell]; i < grid.offsets[cell + 1]; ++i)
+                {
+                    const int index = grid.items[i];
+                    // check if we intersect w/ the real vertex position projection
+                    const double dx = std::fabs(mouseCSPosition.x - positions.x[index]);
+                    const double dy = std::fabs(mouseCSPosition.y - positions.y[index]);
+                    if(dx > threshold || dy > threshold)
+                        continue;
+                    const double distance = dx * dx + dy * dy;
+                    if(nearestMesh && distance >= nearestDistance)
+                        continue;
+                    nearestMesh = &meshData;
+                    nearestIndex = index;
+                    nearestDistance = distance;
+                }
             }
         }
     }
-    return false;
+    if(!nearestMesh)
+        return false;
+    _intersectedComponent.type = MFn::kMeshVertComponent;
+    _intersectedComponent.meshPath = nearestMesh->path;
+    _intersectedComponent.vertex = VertexData(nearestMesh, nearestIndex);
+    _intersectedComponent.edge = EdgeData();
+    return true;
 }
 
 bool MVGManipulatorCache::isIntersectingEdge(const double tolerance, const MPoint& mouseCSPosition)
@@ -371,7 +1294,10 @@ bool MVGManipulatorCache::isIntersectingEdge(const double tolerance, const MPoin
     double threshold = (tolerance * _activeCamera.getZoom()) / (double)_activeView.portWidth();
 
     int cameraID = _activeCamera.getId();
-    // check each mesh edges
+    // find the nearest edge among all meshes
+    const MeshData* nearestMesh = NULL;
+    int nearestIndex = -1;
+    double nearestDistance = 0.0;
     std::map<std::string, MeshData>::iterator meshIt = _meshData.begin();
     for(; meshIt != _meshData.end(); ++meshIt)
     {
@@ -380,26 +1306,55 @@ bool MVGManipulatorCache::isIntersectingEdge(const double tolerance, const MPoin
         // time
         checkForCameraSpacePositions(_activeView, meshIt->second, cameraID);
 
-        std::vector<EdgeData>& edges = meshIt->second.edges;
-        std::vector<EdgeData>::iterator edgeIt = edges.begin();
-        for(; edgeIt < edges.end(); ++edgeIt)
+        const MeshData& meshData = meshIt->second;
+        std::map<int, CameraSpacePositions>::const_iterator positionsIt =
+            meshData.cameraSpacePositions.find(cameraID);
+        if(positionsIt == meshData.cameraSpacePositions.end())
+            continue;
+        const CameraSpacePositions& positions = positionsIt->second;
+        if(!isInBoundingBox(positions, mouseCSPosition, threshold))
+            continue;
+        const std::vector<double>& x = positions.x;
+        const std::vector<double>& y = positions.y;
+        const CameraSpaceGrid& grid = positions.edgeGrid;
+        int firstX, firstY, lastX, lastY;
+        grid.getCellRange(mouseCSPosition.x - threshold, mouseCSPosition.y - threshold,
+                          mouseCSPosition.x + threshold, mouseCSPosition.y + threshold, firstX,
+                          firstY, lastX, lastY);
+        for(int cellY = firstY; cellY <= lastY; ++cellY)
         {
-            MPoint& vertex1CSPosition = edgeIt->vertex1->cameraSpacePoints[cameraID];
-            MPoint& vertex2CSPosition = edgeIt->vertex2->cameraSpacePoints[cameraID];
-            if(minimumDistanceToEdge(vertex1CSPosition, vertex2CSPosition, mouseCSPosition) <
-               threshold)
+            for(int cellX = firstX; cellX <= lastX; ++cellX)
             {
-                MDagPath meshPath;
-                MVGMayaUtil::getDagPathByName(meshIt->first.c_str(), meshPath);
-                _intersectedComponent.type = MFn::kMeshEdgeComponent;
-                _intersectedComponent.meshPath = meshPath;
-                _intersectedComponent.vertex = NULL;
-                _intersectedComponent.edge = &(*edgeIt);
-                return true;
+                // edges overlapping several cells may be tested several times
+                const int cell = grid.getCell(cellX, cellY);
+                for(int i = grid.offsets[cell]; i < grid.offsets[cell + 1]; ++i)
+                {
+                    const int index = grid.items[i];
+                    const int vertex1 = meshData.edgeVertices[2 * index];
+                    const int vertex2 = meshData.edgeVertices[2 * index + 1];
+                    const MPoint vertex1CSPosition(x[vertex1], y[vertex1]);
+                    const MPoint vertex2CSPosition(x[vertex2], y[vertex2]);
+                    const double distance =
+                        minimumDistanceToEdge(vertex1CSPosition, vertex2CSPosition,
+                                              mouseCSPosition);
+                    if(distance >= threshold)
+                        continue;
+                    if(nearestMesh && distance >= nearestDistance)
+                        continue;
+                    nearestMesh = &meshData;
+                    nearestIndex = index;
+                    nearestDistance = distance;
+                }
             }
         }
     }
-    return false;
+    if(!nearestMesh)
+        return false;
+    _intersectedComponent.type = MFn::kMeshEdgeComponent;
+    _intersectedComponent.meshPath = nearestMesh->path;
+    _intersectedComponent.vertex = VertexData();
+    _intersectedComponent.edge = EdgeData(nearestMesh, nearestIndex);
+    return true;
 }
 
 } // namespace
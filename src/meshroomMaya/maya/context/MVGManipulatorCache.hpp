@@ -1,11 +1,17 @@
 #pragma once
 
 #include "meshroomMaya/core/MVGCamera.hpp"
+#include "meshroomMaya/core/MVGMesh.hpp"
+#include "meshroomMaya/core/MVGProjectionSnapshot.hpp"
 #include <maya/MDagPath.h>
 #include <maya/MIntArray.h>
 #include <maya/MPointArray.h>
 #include <maya/M3dView.h>
+#include <maya/MThreadAsync.h>
+#include <list>
 #include <map>
+#include <memory>
+#include <set>
 #include <vector>
 
 namespace meshroomMaya
@@ -16,57 +22,165 @@ class MVGContext;
 class MVGManipulatorCache
 {
 public:
-    struct VertexData
+    /**
+     * @brief Uniform grid over a camera space bounding box.
+     * Each cell lists the vertices inside it, or the edges crossing it.
+     */
+    struct CameraSpaceGrid
     {
-        VertexData()
-            : index(-1)
-            , numConnectedEdges(-1)
+        CameraSpaceGrid();
+        void init(const double minX, const double minY, const double maxX, const double maxY,
+                  const int itemsCount);
+        /// Range of the cells overlapped by a camera space box, clamped to the grid
+        void getCellRange(const double minX, const double minY, const double maxX,
+                          const double maxY, int& firstX, int& firstY, int& lastX,
+                          int& lastY) const;
+        int getCell(const int x, const int y) const { return y * cellsX + x; }
+        /// Whether a camera space point is inside the grid, borders included
+        bool contains(const double x, const double y) const;
+
+        int cellsX;
+        int cellsY;
+        double originX;
+        double originY;
+        double cellSize;
+        /// Items of the cell c are in [offsets[c], offsets[c + 1])
+        std::vector<int> offsets;
+        std::vector<int> items;
+    };
+
+    /// Camera space positions of the vertices of a mesh, for one camera
+    struct CameraSpacePositions
+    {
+        std::vector<double> x;
+        std::vector<double> y;
+        /// Bounding box of the vertices, not shrunk when vertices are moved
+        double minX;
+        double minY;
+        double maxX;
+        double maxY;
+        CameraSpaceGrid vertexGrid;
+        CameraSpaceGrid edgeGrid;
+        /// Vertices having blind data for this camera
+        std::vector<int> placedVertices;
+
+        /// Allocated memory, in bytes
+        size_t getMemorySize() const;
+    };
+
+    /**
+     * @brief Immutable copy of the geometry of a mesh, shared by the prefetch jobs of a mesh
+     * generation.
+     */
+    struct PrefetchGeometry
+    {
+        int generation;
+        std::vector<MPoint> worldPositions;
+        std::vector<int> edgeVertices;
+    };
+
+    /**
+     * @brief Cached mesh data, stored as flat arrays indexed by vertex or edge id.
+     */
+    struct MeshData
+    {
+        MeshData()
+            : generation(0)
         {
         }
-        int index;
-        int numConnectedEdges;
-        MPoint worldPosition;
-        std::map<int, MPoint> blindData; // map from cameraIDs to clickedCSPositions
+        MDagPath path;
+        /// Changes each time the mesh data are rebuilt or patched
+        int generation;
+        std::vector<MPoint> worldPositions;
+        std::vector<int> numConnectedEdges;
+        /// Vertex ids of the edge e are edgeVertices[2 * e] and edgeVertices[2 * e + 1]
+        std::vector<int> edgeVertices;
+        /// Blind data of the vertex v are in [blindDataOffsets[v], blindDataOffsets[v + 1]),
+        /// sorted by camera id
+        std::vector<int> blindDataOffsets;
+        std::vector<MVGMesh::ClickedCSPosition> blindData;
         /// Map from cameraIDs to cameraSpacePositions
         /// Only store points for the cameras used in the UI.
-        std::map<int, MPoint> cameraSpacePoints;
+        std::map<int, CameraSpacePositions> cameraSpacePositions;
+        /// Created by the first prefetch job of the generation
+        std::shared_ptr<const PrefetchGeometry> prefetchGeometry;
+
+        int getVerticesCount() const { return static_cast<int>(worldPositions.size()); }
+        int getEdgesCount() const { return static_cast<int>(edgeVertices.size() / 2); }
     };
 
-    struct EdgeData
+    /**
+     * @brief Reference to a cached vertex.
+     * Only valid until the mesh cache is rebuilt.
+     */
+    struct VertexData
     {
-        EdgeData()
-            : index(-1)
-            , vertex1(NULL)
-            , vertex2(NULL)
+        VertexData()
+            : mesh(NULL)
+            , index(-1)
+        {
+        }
+        VertexData(const MeshData* mesh, const int index)
+            : mesh(mesh)
+            , index(index)
+        {
+        }
+        bool isValid() const { return mesh && index >= 0; }
+        const MPoint& getWorldPosition() const { return mesh->worldPositions[index]; }
+        int getNumConnectedEdges() const { return mesh->numConnectedEdges[index]; }
+        int getBlindDataCount() const
         {
+            return mesh->blindDataOffsets[index + 1] - mesh->blindDataOffsets[index];
         }
+        bool getBlindData(const int cameraID, MPoint& clickedCSPosition) const;
+        void getBlindData(std::map<int, MPoint>& cameraToClickedCSPoints) const;
+
+        const MeshData* mesh;
         int index;
-        VertexData* vertex1;
-        VertexData* vertex2;
     };
 
-    struct MeshData
+    /**
+     * @brief Reference to a cached edge.
+     * Only valid until the mesh cache is rebuilt.
+     */
+    struct EdgeData
     {
-        std::vector<VertexData> vertices;
-        std::vector<EdgeData> edges;
+        EdgeData()
+            : mesh(NULL)
+            , index(-1)
+        {
+        }
+        EdgeData(const MeshData* mesh, const int index)
+            : mesh(mesh)
+            , index(index)
+        {
+        }
+        bool isValid() const { return mesh && index >= 0; }
+        VertexData getVertex1() const { return VertexData(mesh, mesh->edgeVertices[2 * index]); }
+        VertexData getVertex2() const
+        {
+            return VertexData(mesh, mesh->edgeVertices[2 * index + 1]);
+        }
+
+        const MeshData* mesh;
+        int index;
     };
 
     struct MVGComponent
     {
         MVGComponent()
             : type(MFn::kInvalid)
-            , vertex(NULL)
-            , edge(NULL)
         {
         }
         MFn::Type type; // kMeshEdgeComponent, kMeshVertComponent, kBlindData
         MDagPath meshPath;
-        VertexData* vertex;
-        EdgeData* edge;
+        VertexData vertex;
+        EdgeData edge;
     };
 
 public:
     MVGManipulatorCache();
+    ~MVGManipulatorCache();
 
 public:
     // views
@@ -88,6 +202,28 @@ public:
     void checkForCameraSpacePositions(M3dView& view, MeshData& meshData, const int cameraID);
     void computeMeshCacheForCameraID(M3dView& view, MeshData& meshData, const int cameraID);
     void removeMeshCacheForCameraID(const int cameraID);
+    /// Number of cameras whose camera space positions were evicted to fit in the memory budget
+    int getEvictionsCount() const { return _evictionsCount; }
+    /**
+     * @brief Compute the camera space positions of the camera looked through by a panel, and of
+     * some other cameras, on a worker thread.
+     * Results are added to the mesh data by checkForCameraSpacePositions(), on the main thread,
+     * unless the mesh data changed in the meantime.
+     * @param[in] panelName model panel, already looking through its new camera
+     * @param[in] neighbourCameras other cameras, skipped if their film projection differs
+     */
+    void prefetchCameraSpacePositions(const MString& panelName,
+                                      const std::vector<MDagPath>& neighbourCameras);
+
+    /**
+     * @brief Record the vertices modified by an edit, to be patched by updateDirtyMeshes().
+     * @param[in] path modified mesh
+     * @param[in] vertexIds modified vertices, empty if the topology changed
+     */
+    static void setMeshDirty(const MDagPath& path, const MIntArray& vertexIds);
+    static bool hasDirtyMeshes() { return !_dirtyMeshes.empty(); }
+    /// Patch the modified vertices of the dirty meshes, rebuild the meshes whose topology changed
+    void updateDirtyMeshes();
 
     const MVGComponent& getSelectedComponent() const { return _selectedComponent; }
     void setSelectedComponent(const MVGComponent& selectedComponent);
@@ -95,6 +231,33 @@ public:
     void updateSelectedComponent(const MDagPath& meshPath, const MFn::Type type, const int index);
 
 private:
+    /// Modified vertices of a mesh since the last cache update
+    struct DirtyMesh
+    {
+        DirtyMesh()
+            : isTopologyDirty(false)
+        {
+        }
+        MDagPath path;
+        bool isTopologyDirty;
+        std::set<int> vertexIds;
+    };
+
+    struct PrefetchJob;
+
+private:
+    bool updateMeshCacheVertices(MeshData& meshData, const std::set<int>& vertexIds);
+    static void updatePlacedVertices(const MeshData& meshData, const int cameraID,
+                                     CameraSpacePositions& positions);
+    static void updatePlacedVertices(const MeshData& meshData, const int cameraID,
+                                     const std::vector<int>& vertexIds,
+                                     CameraSpacePositions& positions);
+    void startPrefetchJob(const MVGProjectionSnapshot& projection, const int cameraID);
+    bool collectPrefetchJobs();
+    void useCamera(const int cameraID);
+    void applyMemoryBudget();
+    static MThreadRetVal prefetchTask(void* data);
+    static void prefetchTaskDone(void* data);
     bool isIntersectingBlindData(const double, const MPoint&);
     bool isIntersectingPoint(const double, const MPoint&);
     bool isIntersectingEdge(const double, const MPoint&);
@@ -105,6 +268,16 @@ private:
     MVGComponent _intersectedComponent;
     MVGComponent _selectedComponent;
     std::map<std::string, MeshData> _meshData; // per mesh
+    std::vector<PrefetchJob*> _prefetchJobs;
+    /// Cameras having camera space positions, most recently used first
+    std::list<int> _recentCameraIDs;
+    int _evictionsCount;
+    static int _generationsCount;
+
+public:
+    /// Memory budget of the camera space positions of all cameras, in bytes
+    static size_t _memoryBudget;
+    static std::map<std::string, DirtyMesh> _dirtyMeshes;
 };
 
 } // namespace
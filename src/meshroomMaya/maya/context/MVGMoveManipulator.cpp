@@ -56,6 +56,9 @@ void MVGMoveManipulator::draw(M3dView& view, const MDagPath& path, M3dView::Disp
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+    // Capture viewing parameters once for the whole draw
+    const MVGProjectionSnapshot projection(view);
+
     // World space coordinates of edge/vertex intersected on press
     MPointArray onPressIntersectedWSPoints;
     // Camera space positions needed to draw the new element
@@ -69,20 +72,22 @@ void MVGMoveManipulator::draw(M3dView& view, const MDagPath& path, M3dView::Disp
         case MFn::kBlindData:
             if(_mode != eMoveModeNViewTriangulation)
                 break;
-            intermediateIntersectedCSPoints.append(getMousePosition(view));
-            onPressIntersectedWSPoints.append(_onPressIntersectedComponent.vertex->worldPosition);
+            intermediateIntersectedCSPoints.append(getMousePosition(projection));
+            onPressIntersectedWSPoints.append(
+                _onPressIntersectedComponent.vertex.getWorldPosition());
             break;
         case MFn::kMeshVertComponent:
-            intermediateIntersectedCSPoints.append(getMousePosition(view));
-            onPressIntersectedWSPoints.append(_onPressIntersectedComponent.vertex->worldPosition);
+            intermediateIntersectedCSPoints.append(getMousePosition(projection));
+            onPressIntersectedWSPoints.append(
+                _onPressIntersectedComponent.vertex.getWorldPosition());
             break;
         case MFn::kMeshEdgeComponent:
-            getIntermediateCSEdgePoints(view, _onPressIntersectedComponent.edge, _onPressCSPoint,
-                                        intermediateIntersectedCSPoints);
+            getIntermediateCSEdgePoints(projection, _onPressIntersectedComponent.edge,
+                                        _onPressCSPoint, intermediateIntersectedCSPoints);
             onPressIntersectedWSPoints.append(
-                _onPressIntersectedComponent.edge->vertex1->worldPosition);
+                _onPressIntersectedComponent.edge.getVertex1().getWorldPosition());
             onPressIntersectedWSPoints.append(
-                _onPressIntersectedComponent.edge->vertex2->worldPosition);
+                _onPressIntersectedComponent.edge.getVertex2().getWorldPosition());
             break;
         default:
             break;
@@ -116,28 +121,29 @@ void MVGMoveManipulator::draw(M3dView& view, const MDagPath& path, M3dView::Disp
             view.endGL();
             return;
         }
-        drawPlacedPoints(view, camera, _cache, _onPressIntersectedComponent);
+        drawPlacedPoints(view, projection, camera, _cache, _onPressIntersectedComponent);
         // Draw selected point
         if(!_doDrag)
-            drawSelectedPoint2D(view, camera, selectedComponent);
+            drawSelectedPoint2D(projection, camera, selectedComponent);
         // Draw in active MeshroomMaya viewport
         if(!isActiveView)
         {
-            drawComplementaryIntersectedBlindData(view, camera, _cache->getIntersectedComponent());
+            drawComplementaryIntersectedBlindData(projection, camera,
+                                                  _cache->getIntersectedComponent());
             MVGDrawUtil::end2DDrawing();
             glDisable(GL_BLEND);
             view.endGL();
             return;
         }
         // Draw vertex information on hover
-        drawVertexOnHover(view, _cache, getMousePosition(view, kView));
+        drawVertexOnHover(view, projection, _cache, mouseVSPosition);
         if(!_doDrag)
         {
             // Draw point to be placed
-            drawPointToBePlaced(view, camera, selectedComponent, mouseVSPosition);
+            drawPointToBePlaced(projection, camera, selectedComponent, mouseVSPosition);
             // Draw intersection
             MPointArray intersectedVSPoints;
-            getIntersectedPoints(view, intersectedVSPoints, MVGManipulator::kView);
+            getIntersectedPoints(projection, intersectedVSPoints, MVGManipulator::kView);
             MVGManipulator::drawIntersection2D(intersectedVSPoints, intersectedComponentType);
         }
         // draw triangulation
@@ -148,7 +154,7 @@ void MVGMoveManipulator::draw(M3dView& view, const MDagPath& path, M3dView::Disp
                 triangulatedWSPoints = _finalWSPoints;
             MVGDrawUtil::drawTriangulatedPoints(
                 view, triangulatedWSPoints,
-                MVGGeometryUtil::cameraToViewSpace(view, intermediateIntersectedCSPoints));
+                MVGGeometryUtil::cameraToViewSpace(projection, intermediateIntersectedCSPoints));
         }
         if(_doDrag)
             MVGDrawUtil::drawLineLoop2D(_intermediateVSPoints, MVGDrawUtil::_errorColor, 3.0);
@@ -162,6 +168,7 @@ void MVGMoveManipulator::draw(M3dView& view, const MDagPath& path, M3dView::Disp
 
 MStatus MVGMoveManipulator::doPress(M3dView& view)
 {
+    flushInput();
     if(!MVGMayaUtil::isActiveView(view) || !MVGMayaUtil::isMVGView(view))
         return MPxManipulatorNode::doPress(view);
     // use only the left mouse button
@@ -175,14 +182,16 @@ MStatus MVGMoveManipulator::doPress(M3dView& view)
     if(_cache->getActiveCamera().getId() != _cameraID)
     {
         _cameraID = _cache->getActiveCamera().getId();
-        _cache->getActiveCamera().getVisibleItems(_visiblePointCloudItems);
+        _preview.setVisibleItems(_cache->getActiveCamera());
     }
 
     // set this view as the active view
     _cache->setActiveView(view);
+    _preview.reset();
+    const MVGProjectionSnapshot projection(view);
 
     // check if we intersect w/ a mesh component
-    _onPressCSPoint = getMousePosition(view);
+    _onPressCSPoint = getMousePosition(projection);
     bool triangulationMode = (_mode == eMoveModeNViewTriangulation);
     if(!_cache->checkIntersection(10.0, _onPressCSPoint, triangulationMode))
     {
@@ -196,12 +205,12 @@ MStatus MVGMoveManipulator::doPress(M3dView& view)
     // Update selected component
     if(_mode == eMoveModeNViewTriangulation)
     {
-        _cache->checkIntersection(10.0, getMousePosition(view), true);
+        _cache->checkIntersection(10.0, getMousePosition(projection), true);
         _cache->setSelectedComponent(_onPressIntersectedComponent);
     }
 
     // compute final positions
-    computeFinalWSPoints(view);
+    computeFinalWSPoints(projection);
 
     storeTweakInformation();
 
@@ -210,6 +219,9 @@ MStatus MVGMoveManipulator::doPress(M3dView& view)
 
 MStatus MVGMoveManipulator::doRelease(M3dView& view)
 {
+    // the final positions are computed below: a preview submitted now would only be cancelled
+    cancelProcessInput();
+    flushInput();
     _doDrag = false;
     if(!MVGMayaUtil::isActiveView(view) || !MVGMayaUtil::isMVGView(view))
         return MPxManipulatorNode::doRelease(view);
@@ -218,6 +230,7 @@ MStatus MVGMoveManipulator::doRelease(M3dView& view)
     const MVGCamera& camera = _cache->getActiveCamera();
     if(!camera.isValid())
         return MPxManipulatorNode::doRelease(view);
+    const MVGProjectionSnapshot projection(view);
 
     // If there is a selected component, and if there is no blind data for the current camera
     // Use the selected component instead of _onPressIntersectedComponent to compute final positions
@@ -226,9 +239,8 @@ MStatus MVGMoveManipulator::doRelease(M3dView& view)
        selectedComponent.type == MFn::kBlindData)
     {
         // Compute triangulated point with mouse position only if point is not already placed in 2D
-        std::map<int, MPoint>::const_iterator currentData =
-            selectedComponent.vertex->blindData.find(camera.getId());
-        if(currentData == selectedComponent.vertex->blindData.end())
+        MPoint currentData;
+        if(!selectedComponent.vertex.getBlindData(camera.getId(), currentData))
             _onPressIntersectedComponent = selectedComponent;
     }
     if(_onPressIntersectedComponent.type == MFn::kInvalid) // not moving a component
@@ -238,7 +250,7 @@ MStatus MVGMoveManipulator::doRelease(M3dView& view)
     }
 
     // compute the final vertex/edge position depending on move mode
-    computeFinalWSPoints(view);
+    computeFinalWSPoints(projection);
 
     // prepare commands data
     MIntArray indices;
@@ -253,17 +265,17 @@ MStatus MVGMoveManipulator::doRelease(M3dView& view)
                 break;
         case MFn::kMeshVertComponent:
         {
-            indices.append(_onPressIntersectedComponent.vertex->index);
+            indices.append(_onPressIntersectedComponent.vertex.index);
             if(_mode == eMoveModeNViewTriangulation)
-                clickedCSPoints.append(getMousePosition(view));
+                clickedCSPoints.append(getMousePosition(projection));
             break;
         }
         case MFn::kMeshEdgeComponent:
         {
-            indices.append(_onPressIntersectedComponent.edge->vertex1->index);
-            indices.append(_onPressIntersectedComponent.edge->vertex2->index);
+            indices.append(_onPressIntersectedComponent.edge.getVertex1().index);
+            indices.append(_onPressIntersectedComponent.edge.getVertex2().index);
             if(_mode == eMoveModeNViewTriangulation)
-                getIntermediateCSEdgePoints(view, _onPressIntersectedComponent.edge,
+                getIntermediateCSEdgePoints(projection, _onPressIntersectedComponent.edge,
                                             _onPressCSPoint, clickedCSPoints);
             break;
         }
@@ -279,7 +291,7 @@ MStatus MVGMoveManipulator::doRelease(M3dView& view)
             _onPressIntersectedComponent = MVGManipulatorCache::MVGComponent();
             return MPxManipulatorNode::doRelease(view);
         }
-        clickedCSPoints = MVGGeometryUtil::worldToCameraSpace(view, _finalWSPoints);
+        clickedCSPoints = MVGGeometryUtil::worldToCameraSpace(projection, _finalWSPoints);
     }
 
     // Retrieve tweak information
@@ -296,7 +308,7 @@ MStatus MVGMoveManipulator::doRelease(M3dView& view)
         if(cmd->doIt(args))
         {
             cmd->finalize();
-            _cache->rebuildMeshCache(_onPressIntersectedComponent.meshPath);
+            _cache->updateDirtyMeshes();
         }
     }
 
@@ -307,7 +319,7 @@ MStatus MVGMoveManipulator::doRelease(M3dView& view)
     // Select after rebuilding cache
     if(_mode == eMoveModeNViewTriangulation)
     {
-        _cache->checkIntersection(10.0, getMousePosition(view), true);
+        _cache->checkIntersection(10.0, getMousePosition(projection), true);
         MVGManipulatorCache::MVGComponent intersectedComponent = _cache->getIntersectedComponent();
         _cache->setSelectedComponent(intersectedComponent);
     }
@@ -316,24 +328,27 @@ MStatus MVGMoveManipulator::doRelease(M3dView& view)
 
 MStatus MVGMoveManipulator::doMove(M3dView& view, bool& refresh)
 {
-    const MVGCamera& camera = _cache->getActiveCamera();
-    if(!camera.isValid())
-        return MPxManipulatorNode::doMove(view, refresh);
-
-    bool triangulationMode = (_mode == eMoveModeNViewTriangulation);
-    _cache->checkIntersection(10.0, getMousePosition(view), triangulationMode);
-
+    requestProcessInput();
     return MPxManipulatorNode::doMove(view, refresh);
 }
 
 MStatus MVGMoveManipulator::doDrag(M3dView& view)
+{
+    requestProcessInput();
+    return MPxManipulatorNode::doDrag(view);
+}
+
+void MVGMoveManipulator::computePreview()
 {
     const MVGCamera& camera = _cache->getActiveCamera();
     if(!camera.isValid())
-        return MPxManipulatorNode::doDrag(view);
+        return;
 
+    const MVGProjectionSnapshot projection(_cache->getActiveView());
     bool triangulationMode = (_mode == eMoveModeNViewTriangulation);
-    _cache->checkIntersection(10.0, getMousePosition(view), triangulationMode);
+    _cache->checkIntersection(10.0, getMousePosition(projection), triangulationMode);
+    if(!_doDrag)
+        return;
 
     // If there is a selected component, and if there is no blind data for the current camera
     // Use the selected component instead of _onPressIntersectedComponent to compute final positions
@@ -351,15 +366,15 @@ MStatus MVGMoveManipulator::doDrag(M3dView& view)
             if(_mode != eMoveModeNViewTriangulation)
                 break;
         case MFn::kMeshVertComponent:
-            verticesID.append(_onPressIntersectedComponent.vertex->index);
+            verticesID.append(_onPressIntersectedComponent.vertex.index);
             break;
         case MFn::kMeshEdgeComponent:
-            verticesID.append(_onPressIntersectedComponent.edge->vertex1->index);
-            verticesID.append(_onPressIntersectedComponent.edge->vertex2->index);
+            verticesID.append(_onPressIntersectedComponent.edge.getVertex1().index);
+            verticesID.append(_onPressIntersectedComponent.edge.getVertex2().index);
             break;
     }
 
-    computeFinalWSPoints(view);
+    computeFinalWSPoints(projection);
 
     // Set points
     if(_finalWSPoints.length() > 0)
@@ -369,14 +384,14 @@ MStatus MVGMoveManipulator::doDrag(M3dView& view)
     }
     else
         resetTweakInformation();
-
-    return MPxManipulatorNode::doDrag(view);
 }
 
-void MVGMoveManipulator::computeFinalWSPoints(M3dView& view)
+void MVGMoveManipulator::computeFinalWSPoints(const MVGProjectionSnapshot& projection)
 {
-    // clear last computed positions
-    _intermediateVSPoints.clear();
+    // clear last computed positions; the point cloud projection keeps them until its first
+    // preview result
+    if(_mode != eMoveModePointCloudProjection)
+        _intermediateVSPoints.clear();
 
     // TODO in case we are intersecting a component of the same type, return this component
     // positions
@@ -385,13 +400,13 @@ void MVGMoveManipulator::computeFinalWSPoints(M3dView& view)
     switch(_mode)
     {
         case eMoveModeNViewTriangulation:
-            computeTriangulatedPoints(view, _finalWSPoints);
+            computeTriangulatedPoints(projection, _finalWSPoints);
             break;
         case eMoveModePointCloudProjection:
-            computePCPoints(view, _finalWSPoints);
+            computePCPoints(projection, _finalWSPoints);
             break;
         case eMoveModeAdjacentFaceProjection:
-            computeAdjacentPoints(view, _finalWSPoints);
+            computeAdjacentPoints(projection, _finalWSPoints);
             break;
     }
 }
@@ -401,10 +416,11 @@ void MVGMoveManipulator::computeFinalWSPoints(M3dView& view)
  *
  * "Moved points" could be one vertex or 2 points of an edge.
  *
- * @param view Viewport
+ * @param projection viewing parameters of the active view
  * @param finalWSPoints computed points in 3D World Space coords.
  */
-void MVGMoveManipulator::computeTriangulatedPoints(M3dView& view, MPointArray& finalWSPoints)
+void MVGMoveManipulator::computeTriangulatedPoints(const MVGProjectionSnapshot& projection,
+                                                   MPointArray& finalWSPoints)
 {
     finalWSPoints.clear();
     MPointArray intermediateCSPositions;
@@ -413,9 +429,9 @@ void MVGMoveManipulator::computeTriangulatedPoints(M3dView& view, MPointArray& f
         case MFn::kBlindData:
         case MFn::kMeshVertComponent:
         {
-            intermediateCSPositions.append(getMousePosition(view));
+            intermediateCSPositions.append(getMousePosition(projection));
             MPoint triangulatedWSPoint;
-            if(triangulate(view, _onPressIntersectedComponent.vertex, intermediateCSPositions[0],
+            if(triangulate(_onPressIntersectedComponent.vertex, intermediateCSPositions[0],
                            triangulatedWSPoint))
                 finalWSPoints.append(triangulatedWSPoint);
             break;
@@ -426,15 +442,15 @@ void MVGMoveManipulator::computeTriangulatedPoints(M3dView& view, MPointArray& f
             MPoint triangulatedWSPoint;
             bool isVertex1Computed = false;
             bool isVertex2Computed = false;
-            getIntermediateCSEdgePoints(view, _onPressIntersectedComponent.edge, _onPressCSPoint,
-                                        intermediateCSPositions);
-            if(triangulate(view, _onPressIntersectedComponent.edge->vertex1,
+            getIntermediateCSEdgePoints(projection, _onPressIntersectedComponent.edge,
+                                        _onPressCSPoint, intermediateCSPositions);
+            if(triangulate(_onPressIntersectedComponent.edge.getVertex1(),
                            intermediateCSPositions[0], triangulatedWSPoint))
             {
                 isVertex1Computed = true;
                 finalWSPoints.append(triangulatedWSPoint);
             }
-            if(triangulate(view, _onPressIntersectedComponent.edge->vertex2,
+            if(triangulate(_onPressIntersectedComponent.edge.getVertex2(),
                            intermediateCSPositions[1], triangulatedWSPoint))
             {
                 isVertex2Computed = true;
@@ -443,8 +459,8 @@ void MVGMoveManipulator::computeTriangulatedPoints(M3dView& view, MPointArray& f
             // in case we can move only one vertex
             if(finalWSPoints.length() == 1)
             {
-                MVector edgeWS = _onPressIntersectedComponent.edge->vertex2->worldPosition -
-                                 _onPressIntersectedComponent.edge->vertex1->worldPosition;
+                MVector edgeWS = _onPressIntersectedComponent.edge.getVertex2().getWorldPosition() -
+                                 _onPressIntersectedComponent.edge.getVertex1().getWorldPosition();
                 if(isVertex1Computed)
                     finalWSPoints.append(finalWSPoints[0] + edgeWS);
                 if(isVertex2Computed)
@@ -464,24 +480,26 @@ void MVGMoveManipulator::computeTriangulatedPoints(M3dView& view, MPointArray& f
  * @brief Recompute the plane of the moved points to fit the point cloud.
  *
  * "Moved points" could be one vertex or 2 points of an edge.
+ * While no preview result of the moved component is finished, the previous points and error
+ * polygon are kept as is.
  *
- * @param view Viewport
+ * @param projection viewing parameters of the active view
  * @param finalWSPoints computed points in 3D World Space coords.
  */
-void MVGMoveManipulator::computePCPoints(M3dView& view, MPointArray& finalWSPoints)
+void MVGMoveManipulator::computePCPoints(const MVGProjectionSnapshot& projection,
+                                         MPointArray& finalWSPoints)
 {
-    finalWSPoints.clear();
     MVGMesh mesh(_onPressIntersectedComponent.meshPath);
     switch(_onPressIntersectedComponent.type)
     {
         case MFn::kMeshVertComponent:
         {
             MPointArray intermediateCSPositions;
-            intermediateCSPositions.append(getMousePosition(view));
+            intermediateCSPositions.append(getMousePosition(projection));
             MIntArray connectedFacesIDs =
-                mesh.getConnectedFacesToVertex(_onPressIntersectedComponent.vertex->index);
+                mesh.getConnectedFacesToVertex(_onPressIntersectedComponent.vertex.index);
             if(connectedFacesIDs.length() < 1)
-                return;
+                break;
             MIntArray verticesIDs = mesh.getFaceVertices(connectedFacesIDs[0]);
             MPointArray cameraSpacePoints;
             int movingVertexIDInThisFace = -1;
@@ -489,73 +507,95 @@ void MVGMoveManipulator::computePCPoints(M3dView& view, MPointArray& finalWSPoin
             {
                 // replace the moved vertex position with the current mouse position (camera
                 // space)
-                if(verticesIDs[i] == _onPressIntersectedComponent.vertex->index)
+                if(verticesIDs[i] == _onPressIntersectedComponent.vertex.index)
                 {
-                    cameraSpacePoints.append(getMousePosition(view));
+                    cameraSpacePoints.append(getMousePosition(projection));
                     movingVertexIDInThisFace = i;
                     continue;
                 }
                 MPoint vertexWSPoint;
                 mesh.getPoint(verticesIDs[i], vertexWSPoint);
-                cameraSpacePoints.append(MVGGeometryUtil::worldToCameraSpace(view, vertexWSPoint));
+                cameraSpacePoints.append(
+                    MVGGeometryUtil::worldToCameraSpace(projection, vertexWSPoint));
             }
             assert(movingVertexIDInThisFace != -1);
-            MPointArray worldSpacePoints;
-            MVGPointCloud cloud(MVGProject::_CLOUD);
-            if(cloud.projectPoints(view, _visiblePointCloudItems, cameraSpacePoints,
-                                   worldSpacePoints))
+            MVGAsyncPreview::Request request(projection);
+            request.faceCSPoints = cameraSpacePoints;
+            request.meshPath = _onPressIntersectedComponent.meshPath;
+            request.componentType = MFn::kMeshVertComponent;
+            request.componentIndex = _onPressIntersectedComponent.vertex.index;
+            request.faceIndex = connectedFacesIDs[0];
+            MVGAsyncPreview::Result result;
+            const bool isProjected = projectOnPointCloud(request, result);
+            if(result.isPending)
+                return;
+            finalWSPoints.clear();
+            _intermediateVSPoints.clear();
+            if(isProjected && movingVertexIDInThisFace < (int)result.faceWSPoints.length())
             {
                 // add only the moved vertex position, not the other projected vertices
-                finalWSPoints.append(worldSpacePoints[movingVertexIDInThisFace]);
+                finalWSPoints.append(result.faceWSPoints[movingVertexIDInThisFace]);
             }
             else
             {
                 // Save positions for error display
-                _intermediateVSPoints = MVGGeometryUtil::cameraToViewSpace(view, cameraSpacePoints);
+                _intermediateVSPoints =
+                    MVGGeometryUtil::cameraToViewSpace(projection, cameraSpacePoints);
             }
-            break;
+            return;
         }
         case MFn::kMeshEdgeComponent:
         {
             MIntArray connectedFacesIDs =
-                mesh.getConnectedFacesToEdge(_onPressIntersectedComponent.edge->index);
+                mesh.getConnectedFacesToEdge(_onPressIntersectedComponent.edge.index);
             if(connectedFacesIDs.length() < 1)
-                return;
+                break;
             MIntArray verticesIDs = mesh.getFaceVertices(connectedFacesIDs[0]);
             MPointArray intermediateCSPositions;
-            getIntermediateCSEdgePoints(view, _onPressIntersectedComponent.edge, _onPressCSPoint,
-                                        intermediateCSPositions);
+            getIntermediateCSEdgePoints(projection, _onPressIntersectedComponent.edge,
+                                        _onPressCSPoint, intermediateCSPositions);
             MPointArray cameraSpacePoints;
             // replace the moved edge position
             for(size_t i = 0; i < verticesIDs.length(); ++i)
             {
-                if(verticesIDs[i] == _onPressIntersectedComponent.edge->vertex1->index)
+                if(verticesIDs[i] == _onPressIntersectedComponent.edge.getVertex1().index)
                 {
                     cameraSpacePoints.append(intermediateCSPositions[0]);
                     continue;
                 }
-                if(verticesIDs[i] == _onPressIntersectedComponent.edge->vertex2->index)
+                if(verticesIDs[i] == _onPressIntersectedComponent.edge.getVertex2().index)
                 {
                     cameraSpacePoints.append(intermediateCSPositions[1]);
                     continue;
                 }
                 MPoint vertexWSPoint;
                 mesh.getPoint(verticesIDs[i], vertexWSPoint);
-                cameraSpacePoints.append(MVGGeometryUtil::worldToCameraSpace(view, vertexWSPoint));
+                cameraSpacePoints.append(
+                    MVGGeometryUtil::worldToCameraSpace(projection, vertexWSPoint));
             }
             // Project mouse on point cloud
-            MPoint projectedMouseWS;
-            MVGPointCloud cloud(MVGProject::_CLOUD);
-            MPointArray constraintedWSPoints;
-            constraintedWSPoints.append(_onPressIntersectedComponent.edge->vertex1->worldPosition);
-            constraintedWSPoints.append(_onPressIntersectedComponent.edge->vertex2->worldPosition);
-            if(cloud.projectPointsWithLineConstraint(view, _visiblePointCloudItems,
-                                                     cameraSpacePoints, constraintedWSPoints,
-                                                     getMousePosition(view), projectedMouseWS))
+            MVGAsyncPreview::Request request(projection);
+            request.faceCSPoints = cameraSpacePoints;
+            const MVGManipulatorCache::EdgeData& onPressEdge = _onPressIntersectedComponent.edge;
+            request.constraintWSPoints.append(onPressEdge.getVertex1().getWorldPosition());
+            request.constraintWSPoints.append(onPressEdge.getVertex2().getWorldPosition());
+            request.mouseCSPoint = getMousePosition(projection);
+            request.meshPath = _onPressIntersectedComponent.meshPath;
+            request.componentType = MFn::kMeshEdgeComponent;
+            request.componentIndex = onPressEdge.index;
+            request.faceIndex = connectedFacesIDs[0];
+            MVGAsyncPreview::Result result;
+            const bool isProjected = projectOnPointCloud(request, result);
+            if(result.isPending)
+                return;
+            finalWSPoints.clear();
+            _intermediateVSPoints.clear();
+            if(isProjected)
             {
                 MPointArray translatedWSEdgePoints;
-                getTranslatedWSEdgePoints(view, _onPressIntersectedComponent.edge, _onPressCSPoint,
-                                          projectedMouseWS, translatedWSEdgePoints);
+                getTranslatedWSEdgePoints(projection, _onPressIntersectedComponent.edge,
+                                          _onPressCSPoint, result.mouseWSPoint,
+                                          translatedWSEdgePoints);
                 // add only the moved vertices positions, not the other projected vertices
                 finalWSPoints.append(translatedWSEdgePoints[0]);
                 finalWSPoints.append(translatedWSEdgePoints[1]);
@@ -564,13 +604,17 @@ void MVGMoveManipulator::computePCPoints(M3dView& view, MPointArray& finalWSPoin
             {
                 // Save positions for error display
                 cameraSpacePoints.remove(cameraSpacePoints.length() - 1);
-                _intermediateVSPoints = MVGGeometryUtil::cameraToViewSpace(view, cameraSpacePoints);
+                _intermediateVSPoints =
+                    MVGGeometryUtil::cameraToViewSpace(projection, cameraSpacePoints);
             }
-            break;
+            return;
         }
         default:
             break;
     }
+    // no face to project
+    finalWSPoints.clear();
+    _intermediateVSPoints.clear();
 }
 
 /**
@@ -578,10 +622,11 @@ void MVGMoveManipulator::computePCPoints(M3dView& view, MPointArray& finalWSPoin
  *
  * "Moved points" could be one vertex or 2 points of an edge.
  *
- * @param view Viewport
+ * @param projection viewing parameters of the active view
  * @param finalWSPoints computed points in 3D World Space coords.
  */
-void MVGMoveManipulator::computeAdjacentPoints(M3dView& view, MPointArray& finalWSPoints)
+void MVGMoveManipulator::computeAdjacentPoints(const MVGProjectionSnapshot& projection,
+                                               MPointArray& finalWSPoints)
 {
     finalWSPoints.clear();
     MVGMesh mesh(_onPressIntersectedComponent.meshPath);
@@ -590,10 +635,10 @@ void MVGMoveManipulator::computeAdjacentPoints(M3dView& view, MPointArray& final
         case MFn::kMeshVertComponent:
         {
             MPointArray intermediateCSPositions;
-            intermediateCSPositions.append(getMousePosition(view));
+            intermediateCSPositions.append(getMousePosition(projection));
             // get face vertices
             MIntArray connectedFacesIDs =
-                mesh.getConnectedFacesToVertex(_onPressIntersectedComponent.vertex->index);
+                mesh.getConnectedFacesToVertex(_onPressIntersectedComponent.vertex.index);
             if(connectedFacesIDs.length() < 1)
                 return;
             MIntArray verticesIDs = mesh.getFaceVertices(connectedFacesIDs[0]);
@@ -608,15 +653,15 @@ void MVGMoveManipulator::computeAdjacentPoints(M3dView& view, MPointArray& final
             PlaneKernel::Model planeModel;
             MVGGeometryUtil::computePlane(faceWSPoints, planeModel);
             MPoint projectedWSPoint;
-            if(MVGGeometryUtil::projectPointOnPlane(view, intermediateCSPositions[0], planeModel,
-                                                    projectedWSPoint))
+            if(MVGGeometryUtil::projectPointOnPlane(projection, intermediateCSPositions[0],
+                                                    planeModel, projectedWSPoint))
                 finalWSPoints.append(projectedWSPoint);
             break;
         }
         case MFn::kMeshEdgeComponent:
         {
             MIntArray connectedFacesIDs =
-                mesh.getConnectedFacesToEdge(_onPressIntersectedComponent.edge->index);
+                mesh.getConnectedFacesToEdge(_onPressIntersectedComponent.edge.index);
             if(connectedFacesIDs.length() < 1)
                 return;
             MIntArray verticesIDs = mesh.getFaceVertices(connectedFacesIDs[0]);
@@ -631,15 +676,16 @@ void MVGMoveManipulator::computeAdjacentPoints(M3dView& view, MPointArray& final
             MPointArray intermediateCSPositions;
             MPointArray projectedWSPoints;
             // Project mouse point to compute mouseWSPoint
-            intermediateCSPositions.append(getMousePosition(view));
+            intermediateCSPositions.append(getMousePosition(projection));
             PlaneKernel::Model planeModel;
             MVGGeometryUtil::computePlane(faceWSPoints, planeModel);
-            if(!MVGGeometryUtil::projectPointsOnPlane(view, intermediateCSPositions, planeModel,
-                                                      projectedWSPoints))
+            if(!MVGGeometryUtil::projectPointsOnPlane(projection, intermediateCSPositions,
+                                                      planeModel, projectedWSPoints))
                 return;
             MPointArray translatedWSEdgePoints;
-            getTranslatedWSEdgePoints(view, _onPressIntersectedComponent.edge, _onPressCSPoint,
-                                      projectedWSPoints[0], translatedWSEdgePoints);
+            getTranslatedWSEdgePoints(projection, _onPressIntersectedComponent.edge,
+                                      _onPressCSPoint, projectedWSPoints[0],
+                                      translatedWSEdgePoints);
             // add only the moved vertices positions, not the other projected vertices
             finalWSPoints.append(translatedWSEdgePoints[0]);
             finalWSPoints.append(translatedWSEdgePoints[1]);
@@ -726,12 +772,13 @@ MStatus MVGMoveManipulator::resetTweakInformation()
     return status;
 }
 
-bool MVGMoveManipulator::triangulate(M3dView& view, MVGManipulatorCache::VertexData* vertex,
+bool MVGMoveManipulator::triangulate(const MVGManipulatorCache::VertexData& vertex,
                                      const MPoint& currentVertexPositionsInActiveView,
                                      MPoint& triangulatedWSPoint)
 {
     // retrieve blind data
-    std::map<int, MPoint> blindData = vertex->blindData;
+    std::map<int, MPoint> blindData;
+    vertex.getBlindData(blindData);
     // override blind data for the active camera
     blindData[_cache->getActiveCamera().getId()] = currentVertexPositionsInActiveView;
     if(blindData.size() < 2)
@@ -765,11 +812,13 @@ void MVGMoveManipulator::drawCursor(const MPoint& originVS)
 /**
  * Draw placed points in current camera
  * @param view
+ * @param projection
  * @param cache
  * @param onPressIntersectedComponent
  */
 void MVGMoveManipulator::drawPlacedPoints(
-    M3dView& view, const MVGCamera& camera, MVGManipulatorCache* cache,
+    M3dView& view, const MVGProjectionSnapshot& projection, const MVGCamera& camera,
+    MVGManipulatorCache* cache,
     const MVGManipulatorCache::MVGComponent& onPressIntersectedComponent)
 {
     if(!camera.isValid())
@@ -781,14 +830,12 @@ void MVGMoveManipulator::drawPlacedPoints(
     for(; it != meshData.end(); ++it)
     {
         // browse vertices
-        const std::vector<MVGManipulatorCache::VertexData>& vertices = it->second.vertices;
-        for(std::vector<MVGManipulatorCache::VertexData>::const_iterator verticesIt =
-                vertices.begin();
-            verticesIt != vertices.end(); ++verticesIt)
+        const MVGManipulatorCache::MeshData& mesh = it->second;
+        for(int index = 0; index < mesh.getVerticesCount(); ++index)
         {
-            std::map<int, MPoint>::const_iterator currentData =
-                verticesIt->blindData.find(camera.getId());
-            if(currentData == verticesIt->blindData.end())
+            const MVGManipulatorCache::VertexData vertex(&mesh, index);
+            MPoint currentData;
+            if(!vertex.getBlindData(camera.getId(), currentData))
                 continue;
 
             // Don't draw if point is currently moving //in the current view
@@ -798,32 +845,33 @@ void MVGMoveManipulator::drawPlacedPoints(
                    (onPressIntersectedComponent.type == MFn::kBlindData &&
                     _mode == eMoveModeNViewTriangulation))
                 {
-                    if(onPressIntersectedComponent.vertex->index == verticesIt->index)
+                    if(onPressIntersectedComponent.vertex.index == index)
                         continue;
                 }
                 if(onPressIntersectedComponent.type == MFn::kMeshEdgeComponent)
                 {
-                    if(onPressIntersectedComponent.edge->vertex1->index == verticesIt->index)
+                    if(onPressIntersectedComponent.edge.getVertex1().index == index)
                         continue;
-                    if(onPressIntersectedComponent.edge->vertex2->index == verticesIt->index)
+                    if(onPressIntersectedComponent.edge.getVertex2().index == index)
                         continue;
                 }
             }
 
             // 2D position
-            MPoint clickedVSPoint =
-                MVGGeometryUtil::cameraToViewSpace(view, verticesIt->blindData.at(camera.getId()));
+            MPoint clickedVSPoint;
+            projection.cameraToView(currentData, clickedVSPoint);
             MVGDrawUtil::drawFullCross(clickedVSPoint, 7, 1, MVGDrawUtil::_triangulateColor);
             // Link between 2D/3D positions
-            MPoint vertexVS = MVGGeometryUtil::worldToViewSpace(view, verticesIt->worldPosition);
+            MPoint vertexVS;
+            projection.worldToView(vertex.getWorldPosition(), vertexVS);
             MVGDrawUtil::drawLine2D(clickedVSPoint, vertexVS, MVGDrawUtil::_triangulateColor, 1.5f,
                                     1.f, true);
             // Number of placed points
             MString nbView;
-            nbView += (int)(verticesIt->blindData.size());
+            nbView += vertex.getBlindDataCount();
             view.setDrawColor(MColor(0.9f, 0.3f, 0.f));
-            view.drawText(nbView,
-                          MVGGeometryUtil::viewToWorldSpace(view, clickedVSPoint + MPoint(5, 5)));
+            view.drawText(nbView, MVGGeometryUtil::viewToWorldSpace(projection,
+                                                                    clickedVSPoint + MPoint(5, 5)));
         }
     }
 }
@@ -831,11 +879,11 @@ void MVGMoveManipulator::drawPlacedPoints(
 // static
 /**
  * Hightlight blind data of intersected points in MVG views
- * @param view
+ * @param projection
  * @param MVGComponent
  */
 void MVGMoveManipulator::drawComplementaryIntersectedBlindData(
-    M3dView& view, const MVGCamera& camera,
+    const MVGProjectionSnapshot& projection, const MVGCamera& camera,
     const MVGManipulatorCache::MVGComponent& intersectedComponent)
 {
     if(intersectedComponent.type != MFn::kBlindData)
@@ -843,11 +891,11 @@ void MVGMoveManipulator::drawComplementaryIntersectedBlindData(
     if(!camera.isValid())
         return;
 
-    const std::map<int, MPoint>::const_iterator it =
-        intersectedComponent.vertex->blindData.find(camera.getId());
-    if(it != intersectedComponent.vertex->blindData.end())
+    MPoint intersectedCSPoint;
+    if(intersectedComponent.vertex.getBlindData(camera.getId(), intersectedCSPoint))
     {
-        MPoint intersectedVSPoint = MVGGeometryUtil::cameraToViewSpace(view, it->second);
+        MPoint intersectedVSPoint =
+            MVGGeometryUtil::cameraToViewSpace(projection, intersectedCSPoint);
         MVGDrawUtil::drawEmptyCross(intersectedVSPoint, 8, 2, MVGDrawUtil::_intersectionColor, 1.5);
     }
 }
@@ -856,10 +904,12 @@ void MVGMoveManipulator::drawComplementaryIntersectedBlindData(
  * Draw vertex information on hover :
  *      - number of views in which the point is placed
  * @param view
+ * @param projection
  * @param cache
  * @param mouseVSPosition
  */
-void MVGMoveManipulator::drawVertexOnHover(M3dView& view, MVGManipulatorCache* cache,
+void MVGMoveManipulator::drawVertexOnHover(M3dView& view, const MVGProjectionSnapshot& projection,
+                                           MVGManipulatorCache* cache,
                                            const MPoint& mouseVSPosition)
 {
     MString nbView;
@@ -868,36 +918,36 @@ void MVGMoveManipulator::drawVertexOnHover(M3dView& view, MVGManipulatorCache* c
     if(!cache->getActiveCamera().isValid())
         return;
     const int cameraID = cache->getActiveCamera().getId();
-    std::map<int, MPoint> intersectedBD;
+    MPoint intersectedBD;
     switch(intersectedComponent.type)
     {
         case MFn::kMeshVertComponent:
         {
-            intersectedBD = intersectedComponent.vertex->blindData;
-            if(intersectedBD.find(cameraID) != intersectedBD.end())
+            const MVGManipulatorCache::VertexData& vertex = intersectedComponent.vertex;
+            if(vertex.getBlindData(cameraID, intersectedBD))
                 break;
-            nbView += (int)(intersectedBD.size());
+            nbView += vertex.getBlindDataCount();
             view.setDrawColor(MVGDrawUtil::_placedInOtherViewColor);
-            view.drawText(
-                nbView, MVGGeometryUtil::viewToWorldSpace(view, mouseVSPosition + MPoint(12, 12)));
+            view.drawText(nbView, MVGGeometryUtil::viewToWorldSpace(
+                                      projection, mouseVSPosition + MPoint(12, 12)));
             break;
         }
         case MFn::kMeshEdgeComponent:
         {
-            intersectedBD = intersectedComponent.edge->vertex1->blindData;
-            if(intersectedBD.find(cameraID) == intersectedBD.end())
+            const MVGManipulatorCache::VertexData vertex1 = intersectedComponent.edge.getVertex1();
+            if(!vertex1.getBlindData(cameraID, intersectedBD))
             {
-                nbView += (int)(intersectedBD.size());
+                nbView += vertex1.getBlindDataCount();
                 view.setDrawColor(MVGDrawUtil::_placedInOtherViewColor);
-                view.drawText(nbView, intersectedComponent.edge->vertex1->worldPosition);
+                view.drawText(nbView, vertex1.getWorldPosition());
             }
-            intersectedBD = intersectedComponent.edge->vertex2->blindData;
-            if(intersectedBD.find(cameraID) == intersectedBD.end())
+            const MVGManipulatorCache::VertexData vertex2 = intersectedComponent.edge.getVertex2();
+            if(!vertex2.getBlindData(cameraID, intersectedBD))
             {
                 nbView.clear();
-                nbView += (int)(intersectedBD.size());
+                nbView += vertex2.getBlindDataCount();
                 view.setDrawColor(MVGDrawUtil::_placedInOtherViewColor);
-                view.drawText(nbView, intersectedComponent.edge->vertex2->worldPosition);
+                view.drawText(nbView, vertex2.getWorldPosition());
             }
             break;
         }
@@ -907,21 +957,21 @@ void MVGMoveManipulator::drawVertexOnHover(M3dView& view, MVGManipulatorCache* c
 // static
 /**
  * Highlight the blind data attached to the selected point
- * @param view
+ * @param projection
  * @param selectedComponent
  */
 void
-MVGMoveManipulator::drawSelectedPoint2D(M3dView& view, const MVGCamera& camera,
+MVGMoveManipulator::drawSelectedPoint2D(const MVGProjectionSnapshot& projection,
+                                        const MVGCamera& camera,
                                         const MVGManipulatorCache::MVGComponent& selectedComponent)
 {
     if(selectedComponent.type != MFn::kMeshVertComponent &&
        selectedComponent.type != MFn::kBlindData)
         return;
-    std::map<int, MPoint>::const_iterator currentData =
-        selectedComponent.vertex->blindData.find(camera.getId());
-    if(currentData != selectedComponent.vertex->blindData.end())
+    MPoint currentData;
+    if(selectedComponent.vertex.getBlindData(camera.getId(), currentData))
     {
-        MPoint blindDataVS = MVGGeometryUtil::cameraToViewSpace(view, currentData->second);
+        MPoint blindDataVS = MVGGeometryUtil::cameraToViewSpace(projection, currentData);
         MVGDrawUtil::drawEmptyCross(blindDataVS, 8, 2, MVGDrawUtil::_selectionColor, 1.5);
     }
 }
@@ -940,20 +990,21 @@ MVGMoveManipulator::drawSelectedPoint3D(M3dView& view,
        selectedComponent.type != MFn::kBlindData)
         return;
 
-    MVGDrawUtil::drawPoint3D(selectedComponent.vertex->worldPosition, MVGDrawUtil::_selectionColor,
-                             6.f);
+    MVGDrawUtil::drawPoint3D(selectedComponent.vertex.getWorldPosition(),
+                             MVGDrawUtil::_selectionColor, 6.f);
 }
 
 // static
 /**
  * Draw a full cross at the mouseVSPosition
  * Draw a line from the mouseVSPosition to the point in 3D
- * @param view
+ * @param projection
  * @param selectedComponent
  * @param mouseVSPosition : position of the mouse in View Space coordinates
  */
 void
-MVGMoveManipulator::drawPointToBePlaced(M3dView& view, const MVGCamera& camera,
+MVGMoveManipulator::drawPointToBePlaced(const MVGProjectionSnapshot& projection,
+                                        const MVGCamera& camera,
                                         const MVGManipulatorCache::MVGComponent& selectedComponent,
                                         const MPoint& mouseVSPosition)
 {
@@ -963,16 +1014,14 @@ MVGMoveManipulator::drawPointToBePlaced(M3dView& view, const MVGCamera& camera,
        selectedComponent.type != MFn::kBlindData)
         return;
 
-    std::map<int, MPoint>::const_iterator currentData =
-        selectedComponent.vertex->blindData.find(camera.getId());
-
     // Only draw if no blind data for the current view
-    if(currentData != selectedComponent.vertex->blindData.end())
+    MPoint currentData;
+    if(selectedComponent.vertex.getBlindData(camera.getId(), currentData))
         return;
 
     MVGDrawUtil::drawFullCross(mouseVSPosition, 7, 1, MVGDrawUtil::_selectionColor);
     MPoint vertexVS =
-        MVGGeometryUtil::worldToViewSpace(view, selectedComponent.vertex->worldPosition);
+        MVGGeometryUtil::worldToViewSpace(projection, selectedComponent.vertex.getWorldPosition());
     MVGDrawUtil::drawLine2D(mouseVSPosition, vertexVS, MVGDrawUtil::_selectionColor, 1.5f, 1.f,
                             true);
 }
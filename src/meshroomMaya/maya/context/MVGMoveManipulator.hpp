@@ -31,31 +31,38 @@ public:
     virtual MStatus doMove(M3dView& view, bool& refresh);
     virtual MStatus doDrag(M3dView& view);
 
+protected:
+    virtual void computePreview();
+
 private:
-    void computeFinalWSPoints(M3dView& view);
-    void computeTriangulatedPoints(M3dView& view, MPointArray& finalWSPoints);
-    void computePCPoints(M3dView& view, MPointArray& finalWSPoints);
-    void computeAdjacentPoints(M3dView& view, MPointArray& finalWSPoints);
+    void computeFinalWSPoints(const MVGProjectionSnapshot& projection);
+    void computeTriangulatedPoints(const MVGProjectionSnapshot& projection,
+                                   MPointArray& finalWSPoints);
+    void computePCPoints(const MVGProjectionSnapshot& projection, MPointArray& finalWSPoints);
+    void computeAdjacentPoints(const MVGProjectionSnapshot& projection, MPointArray& finalWSPoints);
     MStatus storeTweakInformation();
     MStatus resetTweakInformation();
-    bool triangulate(M3dView& view, MVGManipulatorCache::VertexData* vertex,
+    bool triangulate(const MVGManipulatorCache::VertexData& vertex,
                      const MPoint& currentVertexPositionsInActiveView, MPoint& triangulatedWSPoint);
 
 public:
     static void drawCursor(const MPoint& originVS);
     static void
-    drawPlacedPoints(M3dView& view, const MVGCamera& camera, MVGManipulatorCache* cache,
+    drawPlacedPoints(M3dView& view, const MVGProjectionSnapshot& projection,
+                     const MVGCamera& camera, MVGManipulatorCache* cache,
                      const MVGManipulatorCache::MVGComponent& onPressIntersectedComponent);
     static void drawComplementaryIntersectedBlindData(
-        M3dView& view, const MVGCamera& camera,
+        const MVGProjectionSnapshot& projection, const MVGCamera& camera,
         const MVGManipulatorCache::MVGComponent& intersectedComponent);
-    static void drawVertexOnHover(M3dView& view, MVGManipulatorCache* cache,
-                                  const MPoint& mouseVSPosition);
-    static void drawSelectedPoint2D(M3dView& view, const MVGCamera& camera,
+    static void drawVertexOnHover(M3dView& view, const MVGProjectionSnapshot& projection,
+                                  MVGManipulatorCache* cache, const MPoint& mouseVSPosition);
+    static void drawSelectedPoint2D(const MVGProjectionSnapshot& projection,
+                                    const MVGCamera& camera,
                                     const MVGManipulatorCache::MVGComponent& selectedComponent);
     static void drawSelectedPoint3D(M3dView& view,
                                     const MVGManipulatorCache::MVGComponent& selectedComponent);
-    static void drawPointToBePlaced(M3dView& view, const MVGCamera& camera,
+    static void drawPointToBePlaced(const MVGProjectionSnapshot& projection,
+                                    const MVGCamera& camera,
                                     const MVGManipulatorCache::MVGComponent& selectedComponent,
                                     const MPoint& mouseVSPosition);
 
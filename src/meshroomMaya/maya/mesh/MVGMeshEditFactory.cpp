@@ -90,26 +90,22 @@ MStatus MVGMeshEditFactory::doIt()
             if(_componentIDs.length() == _worldPositions.length())
             {
                 for(size_t i = 0; i < _componentIDs.length(); ++i)
-                {
                     CHECK(mesh.setPoint(_componentIDs[i], _worldPositions[i]))
-                    if(_clearBD)
-                        CHECK(mesh.unsetBlindData(_componentIDs[i]));
-                }
+                if(_clearBD)
+                    CHECK(mesh.unsetBlindData(_componentIDs))
             }
-            if(!_clearBD)
+            // moves without camera positions (re-triangulation) keep the blind data
+            if(!_clearBD && _cameraPositions.length() > 0)
             {
                 // set blind data
                 assert(_componentIDs.length() == _cameraPositions.length());
-                for(size_t i = 0; i < _componentIDs.length(); ++i)
-                    CHECK(mesh.setBlindDataPerCamera(_componentIDs[i], _cameraID,
-                                                     _cameraPositions[i]))
+                CHECK(mesh.setBlindDataPerCamera(_componentIDs, _cameraID, _cameraPositions))
             }
             break;
         }
         case kClearBD:
         {
-            for(size_t i = 0; i < _componentIDs.length(); ++i)
-                CHECK(mesh.unsetBlindData(_componentIDs[i]));
+            CHECK(mesh.unsetBlindData(_componentIDs))
             break;
         }
     }
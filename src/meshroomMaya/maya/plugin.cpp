@@ -1,10 +1,15 @@
 #include "meshroomMaya/core/MVGLog.hpp"
+#include "meshroomMaya/core/MVGCameraProjectionCache.hpp"
+#include "meshroomMaya/core/MVGPointCloudCache.hpp"
+#include "meshroomMaya/core/MVGSceneRegistry.hpp"
 #include "meshroomMaya/version.hpp"
 #include "meshroomMaya/maya/MVGMayaUtil.hpp"
 #include "meshroomMaya/maya/MVGMayaCallbacks.hpp"
 #include "meshroomMaya/maya/cmd/MVGCmd.hpp"
 #include "meshroomMaya/maya/cmd/MVGEditCmd.hpp"
 #include "meshroomMaya/maya/cmd/MVGImagePlaneCmd.hpp"
+#include "meshroomMaya/maya/cmd/MVGImportSfMCmd.hpp"
+#include "meshroomMaya/maya/cmd/MVGRetriangulateCmd.hpp"
 #include "meshroomMaya/maya/cmd/MVGSelectClosestCamCmd.hpp"
 #include "meshroomMaya/maya/context/MVGContextCmd.hpp"
 #include "meshroomMaya/maya/context/MVGCreateManipulator.hpp"
@@ -140,6 +145,10 @@ MStatus initializePlugin(MObject obj)
     CHECK(plugin.registerCommand("MVGImagePlaneCmd", MVGImagePlaneCmd::creator,
                                  MVGImagePlaneCmd::newSyntax))
     CHECK(plugin.registerCommand(MVGSelectClosestCamCmd::_name, MVGSelectClosestCamCmd::creator))
+    CHECK(plugin.registerCommand(MVGRetriangulateCmd::_name, MVGRetriangulateCmd::creator,
+                                 MVGRetriangulateCmd::newSyntax))
+    CHECK(plugin.registerCommand(MVGImportSfMCmd::_name, MVGImportSfMCmd::creator,
+                                 MVGImportSfMCmd::newSyntax))
     CHECK(plugin.registerContextCommand(MVGContextCmd::name, &MVGContextCmd::creator,
                                         MVGEditCmd::_name, MVGEditCmd::creator,
                                         MVGEditCmd::newSyntax))
@@ -218,6 +227,21 @@ MStatus initializePlugin(MObject obj)
     if(status)
         _callbacks.append(id);
     id = MDGMessage::addNodeAddedCallback(nodeAddedCB, "objectSet", &status);
+    if(status)
+        _callbacks.append(id);
+    id = MDGMessage::addNodeAddedCallback(nodeAddedCB, "camera", &status);
+    if(status)
+        _callbacks.append(id);
+    id = MDGMessage::addNodeRemovedCallback(nodeRemovedCB, "camera", &status);
+    if(status)
+        _callbacks.append(id);
+    id = MDGMessage::addNodeAddedCallback(nodeAddedCB, "transform", &status);
+    if(status)
+        _callbacks.append(id);
+    id = MDGMessage::addNodeRemovedCallback(nodeRemovedCB, "transform", &status);
+    if(status)
+        _callbacks.append(id);
+    id = MDGMessage::addNodeRemovedCallback(nodeRemovedCB, "objectSet", &status);
     if(status)
         _callbacks.append(id);
 
@@ -246,10 +270,16 @@ MStatus uninitializePlugin(MObject obj)
     // Deregister Maya callbacks
     CHECK(MUserEventMessage::deregisterUserEvent(_modeChangedEvent))
     CHECK(MMessage::removeCallbacks(_callbacks))
+    MVGPointCloudCache::clear();
+    MVGSceneRegistry::clear();
+    MVGCameraProjectionCache::clear();
+    MVGCamera::clearImagePlanes();
 
     // Deregister Maya context, commands & nodes
     CHECK(plugin.deregisterCommand("MVGCmd"))
     CHECK(plugin.deregisterCommand("MVGSelectClosestCamCmd"))
+    CHECK(plugin.deregisterCommand(MVGRetriangulateCmd::_name))
+    CHECK(plugin.deregisterCommand(MVGImportSfMCmd::_name))
     CHECK(plugin.deregisterCommand("MVGImagePlaneCmd"))
     CHECK(plugin.deregisterContextCommand(MVGContextCmd::name, MVGEditCmd::_name))
     CHECK(plugin.deregisterNode(MVGCreateManipulator::_id))
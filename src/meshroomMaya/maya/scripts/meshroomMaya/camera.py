@@ -16,31 +16,6 @@ def mvgSetImagePlane(cameraShape, imageFile):
     imagePlaneName = cmds.imagePlane(camera=cameraShape)
     cmds.setAttr( "%s.imageName" % imagePlaneName[0], imageFile, type="string")
 
-def setImagesPaths(abcFilePath, imageAttribute, imageSourceAttribute, thumbnailAttribute, viewIDAttribute):
-  import os
-
-  projectPath = os.path.dirname(abcFilePath)
-  imageDir = os.path.join(projectPath, 'undistort/proxy/')
-  thumbnailDir = os.path.join(projectPath, 'undistort/thumbnail/')
-  cameraList = cmds.ls(ca=True)
-  for c in cameraList:
-    if not cmds.attributeQuery(imageAttribute, node=c, exists=True):
-      continue
-    if not cmds.attributeQuery(imageSourceAttribute, node=c, exists=True):
-      continue
-    originalImagePath = cmds.getAttr(c+'.'+imageAttribute)
-    cmds.setAttr(c+'.'+imageSourceAttribute, originalImagePath, type="string")
-    basename = os.path.basename(originalImagePath)
-    fileName, fileExtension = os.path.splitext(basename)
-    viewID = cmds.getAttr(c+'.'+viewIDAttribute)
-    imageName = fileName + "-" + str(viewID) + "-UOP.jpg"
-    cmds.setAttr(c+'.'+imageAttribute, os.path.join(imageDir, imageName,), type="string")
-
-    if not cmds.attributeQuery(thumbnailAttribute, node=c, exists=True):
-      continue
-    imageName = fileName + "-" + str(viewID) + "-UOT.jpg"
-    cmds.setAttr(c+'.'+thumbnailAttribute, os.path.join(thumbnailDir, imageName), type="string")
-
 def mapImagesPaths(imageAttribute, thumbnailAttribute, abcFilePath):
   import os
 
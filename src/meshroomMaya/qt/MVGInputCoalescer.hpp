@@ -0,0 +1,99 @@
+#pragma once
+
+#include "meshroomMaya/qt/MVGQt.hpp"
+#include <QBasicTimer>
+#include <QElapsedTimer>
+#include <QTimerEvent>
+#include <algorithm>
+
+namespace meshroomMaya
+{
+
+/**
+ * @brief Run the input processing of a user object at most once per display refresh.
+ *
+ * Input events only store the latest pointer and wheel state in the user object, then call
+ * request(). The first request schedules T::processInput() once the queued events are handled,
+ * and no sooner than one refresh interval after the previous processing. The requests received
+ * while the processing is pending are counted as dropped events.
+ */
+template <class T>
+class MVGInputCoalescer : public QObject
+{
+public:
+    MVGInputCoalescer(T* userObj, const int refreshInterval = 16);
+    ~MVGInputCoalescer();
+
+public:
+    void request();
+    /// Run the pending processing now, before an event relying on the latest input state
+    void flush();
+
+public:
+    bool isPending() const { return _timer.isActive(); }
+    int getDroppedEventsCount() const { return _droppedEventsCount; }
+
+protected:
+    void timerEvent(QTimerEvent* e);
+
+protected:
+    T* _userObj;
+    /// minimum delay between two processings, in milliseconds
+    int _refreshInterval;
+    QBasicTimer _timer;
+    QElapsedTimer _lastProcessingTime;
+    int _droppedEventsCount;
+};
+
+} // namespace
+
+template <class T>
+meshroomMaya::MVGInputCoalescer<T>::MVGInputCoalescer(T* userObj, const int refreshInterval)
+    : QObject(NULL) // no parent
+    , _userObj(userObj)
+    , _refreshInterval(refreshInterval)
+    , _droppedEventsCount(0)
+{
+}
+
+template <class T>
+meshroomMaya::MVGInputCoalescer<T>::~MVGInputCoalescer()
+{
+    _timer.stop();
+}
+
+template <class T>
+void meshroomMaya::MVGInputCoalescer<T>::request()
+{
+    if(_timer.isActive())
+    {
+        ++_droppedEventsCount;
+        return;
+    }
+    int delay = 0;
+    if(_lastProcessingTime.isValid())
+        delay = std::max(0, _refreshInterval - (int)_lastProcessingTime.elapsed());
+    _timer.start(delay, this);
+}
+
+template <class T>
+void meshroomMaya::MVGInputCoalescer<T>::flush()
+{
+    if(!_timer.isActive())
+        return;
+    _timer.stop();
+    _lastProcessingTime.start();
+    if(_userObj)
+        _userObj->processInput();
+}
+
+template <class T>
+void meshroomMaya::MVGInputCoalescer<T>::timerEvent(QTimerEvent* e)
+{
+    if(e->timerId() != _timer.timerId())
+    {
+        QObject::timerEvent(e);
+        return;
+    }
+    flush();
+}
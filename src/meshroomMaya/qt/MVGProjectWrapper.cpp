@@ -1,17 +1,20 @@
 #include "meshroomMaya/qt/MVGProjectWrapper.hpp"
 #include "meshroomMaya/version.hpp"
 #include <QCoreApplication>
+#include <QFileInfo>
 #include "MVGCameraSetWrapper.hpp"
 #include "meshroomMaya/qt/MVGCameraWrapper.hpp"
 #include "meshroomMaya/qt/MVGMeshWrapper.hpp"
 #include "meshroomMaya/maya/MVGMayaUtil.hpp"
 #include "meshroomMaya/core/MVGLog.hpp"
 #include "meshroomMaya/core/MVGPointCloud.hpp"
+#include "meshroomMaya/core/MVGPointCloudCache.hpp"
 #include "meshroomMaya/maya/context/MVGContextCmd.hpp"
 #include "meshroomMaya/maya/context/MVGContext.hpp"
 #include "meshroomMaya/maya/context/MVGMoveManipulator.hpp"
 #include "meshroomMaya/maya/MVGDummyLocator.h"
 #include "meshroomMaya/maya/MVGCameraPointsLocator.hpp"
+#include "meshroomMaya/maya/cmd/MVGImportSfMCmd.hpp"
 #include "meshroomMaya/maya/cmd/MVGSelectClosestCamCmd.hpp"
 #include "Eigen/src/StlSupport/StdVector.h"
 #include <maya/MQtUtil.h>
@@ -19,6 +22,7 @@
 #include <maya/MFnTransform.h>
 #include <maya/MFnIntArrayData.h>
 #include <maya/MFnCamera.h>
+#include <maya/MFnDagNode.h>
 #include <maya/MDagPath.h>
 #include <maya/MNodeMessage.h>
 #include <maya/MFnSet.h>
@@ -26,6 +30,10 @@
 #include <maya/MItSelectionList.h>
 #include <maya/MObjectSetMessage.h>
 #include <maya/MDagModifier.h>
+#include <maya/MDoubleArray.h>
+#include <maya/MTimer.h>
+#include <algorithm>
+#include <cctype>
 
 namespace meshroomMaya
 {
@@ -75,6 +83,37 @@ std::set<T> setsIntersection(const std::vector< std::set<T> >& sets)
     return intersection;
 }
 
+/**
+ * Find a child node from its name, without namespace, or from the name Maya gave it if it
+ * was already used (the name followed by digits).
+ *
+ * @param parentPath the parent node
+ * @param name the name of the child when created
+ * @param childPath the path to the child if found
+ * @return true if the child was found
+ */
+bool getChildByName(const MDagPath& parentPath, const std::string& name, MDagPath& childPath)
+{
+    for(unsigned int i = 0; i < parentPath.childCount(); ++i)
+    {
+        const MObject child = parentPath.child(i);
+        std::string childName = MFnDagNode(child).name().asChar();
+        const size_t separator = childName.find_last_of(':');
+        if(separator != std::string::npos)
+            childName = childName.substr(separator + 1);
+        if(childName.compare(0, name.size(), name) != 0)
+            continue;
+        std::string::const_iterator it = childName.begin() + name.size();
+        while(it != childName.end() && std::isdigit(static_cast<unsigned char>(*it)))
+            ++it;
+        if(it != childName.end())
+            continue;
+        childPath = parentPath;
+        return childPath.push(child);
+    }
+    return false;
+}
+
 }
 
 MVGProjectWrapper::MVGProjectWrapper(QObject* parent):
@@ -281,12 +320,16 @@ void MVGProjectWrapper::updateParticleSelection(const std::set<int>& selection)
     _particleSelection = selection;
     _selectionScorePerCamera.clear();
 
+    const int* cameraIndex;
+    const int* lastCameraIndex;
     for(const auto& pointId : _particleSelection)
     {
-        if(!_camerasPerPoint.count(pointId))
-            continue;
-        for(auto* camWrapper : _camerasPerPoint[pointId])
+        _visibility.getPointCameras(pointId, cameraIndex, lastCameraIndex);
+        for(; cameraIndex != lastCameraIndex; ++cameraIndex)
         {
+            auto* camWrapper = _visibilityCameras[*cameraIndex];
+            if(!camWrapper)
+                continue;
             if(!_selectionScorePerCamera.count(camWrapper))
                 _selectionScorePerCamera[camWrapper] = 0;
             _selectionScorePerCamera[camWrapper]++;
@@ -330,23 +373,21 @@ void MVGProjectWrapper::updateParticlesOpacity()
         // Set opacity to 0 for all particles
         pc.setOpacity(0);
         // set opacity to 1 for particles visible by cams in current set
-        std::set<int> indices;
-        std::map<int, int> indexScore;
-        MIntArray array;
+        std::vector<int> indexScore(_visibility.getPointsCount(), 0);
+        const int* pointId;
+        const int* lastPointId;
         for(auto* wrapper : _currentCameraSet->getCameras()->asQList<MVGCameraWrapper>())
         {
-
-            wrapper->getCamera().getVisibleIndexes(array);
-            for(unsigned int i=0; i < array.length(); ++i)
-            {
-                indexScore[array[i]]++;
-            }
+            const int cameraIndex = _visibility.findCamera(wrapper->getCamera().getId());
+            _visibility.getCameraPoints(cameraIndex, pointId, lastPointId);
+            for(; pointId != lastPointId; ++pointId)
+                indexScore[*pointId]++;
         }
-        array.clear();
-        for(const auto& indexToScore : indexScore)
+        MIntArray array;
+        for(int i = 0; i < (int)indexScore.size(); ++i)
         {
-            if(indexToScore.second > _pointsFilteringThreshold)
-                array.append(indexToScore.first);
+            if(indexScore[i] > _pointsFilteringThreshold)
+                array.append(i);
         }
         pc.setOpacity(array, 1.0);
     }
@@ -440,17 +481,48 @@ void MVGProjectWrapper::loadABC(const QString& abcFilePath)
     if(abcFilePath.isEmpty())
         return;
 
-    // Load abc
+    // Load the SfM natively, the other Alembic files with AbcImport
     MString cmd;
-    cmd.format("AbcImport -mode import \"^1s\"", abcFilePath.toStdString().c_str());
-    status = MGlobal::executeCommand(cmd);
-    CHECK_RETURN(status)
+    MDoubleArray importTimings;
+    MTimer timer;
+    const MString filePath(abcFilePath.toStdString().c_str());
+    const bool isNativeImport = MVGImportSfMCmd::canRead(filePath);
+    if(isNativeImport)
+    {
+        cmd.format("^1s \"^2s\"", MVGImportSfMCmd::_name, filePath);
+        status = MGlobal::executeCommand(cmd, importTimings);
+        CHECK_RETURN(status)
+        if(importTimings.length() == 0)
+            return; // import cancelled
+    }
+    else
+    {
+        if(!abcFilePath.endsWith(".abc", Qt::CaseInsensitive))
+        {
+            LOG_ERROR("Unable to import " << abcFilePath.toStdString())
+            return;
+        }
+        cmd.format("AbcImport -mode import \"^1s\"", filePath);
+        timer.beginTimer();
+        status = MGlobal::executeCommand(cmd);
+        timer.endTimer();
+        CHECK_RETURN(status)
+        importTimings.append(timer.elapsedTime());
+    }
 
-    // Retrieve root node
+    // Retrieve root node, renamed by Maya if the name is already used
     MDagPath rootDagPath;
-    status = MVGMayaUtil::getDagPathByName(MVGProject::_PROJECT.c_str(), rootDagPath);
-    if(!status)
-        status = MVGMayaUtil::getDagPathByName(("*:" + MVGProject::_PROJECT).c_str(), rootDagPath);
+    if(isNativeImport)
+    {
+        status = MVGImportSfMCmd::getRoot(rootDagPath) ? MS::kSuccess : MS::kFailure;
+    }
+    else
+    {
+        status = MVGMayaUtil::getDagPathByName(MVGProject::_PROJECT.c_str(), rootDagPath);
+        if(!status)
+            status = MVGMayaUtil::getDagPathByName(("*:" + MVGProject::_PROJECT).c_str(),
+                                                   rootDagPath);
+    }
     CHECK_RETURN(status)
 
     _project = MVGProject(rootDagPath);
@@ -464,13 +536,19 @@ void MVGProjectWrapper::loadABC(const QString& abcFilePath)
 
     // Cameras group node
     MDagPath cameraGroupPath;
-    status = MVGMayaUtil::getDagPathByName(MVGProject::_CAMERAS_GROUP.c_str(), cameraGroupPath);
-    CHECK_RETURN(status);
+    if(!getChildByName(rootDagPath, MVGProject::_CAMERAS_GROUP, cameraGroupPath))
+    {
+        LOG_ERROR("Can't find " << MVGProject::_CAMERAS_GROUP << " in MVG hierarchy")
+        return;
+    }
 
     // Cloud group node
     MDagPath cloudGroupPath;
-    status = MVGMayaUtil::getDagPathByName(MVGProject::_CLOUD_GROUP.c_str(), cloudGroupPath);
-    CHECK_RETURN(status);
+    if(!getChildByName(rootDagPath, MVGProject::_CLOUD_GROUP, cloudGroupPath))
+    {
+        LOG_ERROR("Can't find " << MVGProject::_CLOUD_GROUP << " in MVG hierarchy")
+        return;
+    }
 
     // Camera points locator
     initCameraPointsLocator();
@@ -486,16 +564,15 @@ void MVGProjectWrapper::loadABC(const QString& abcFilePath)
     pointCloudDagPath.extendToShape();
     MObject pointCloud = pointCloudDagPath.node();
 
-    // Visibility
-    MIntArray visibilitySizeArray;
-    status =
-        MVGMayaUtil::getIntArrayAttribute(pointCloud, "mvg_visibilitySize", visibilitySizeArray);
-    CHECK_RETURN(status)
-
-
-    std::map<int, MIntArray> itemsPerCam;
-    MIntArray visibilitiesArray;
+    // Visibility, already built by the native import
+    if(!isNativeImport || !MVGImportSfMCmd::takeVisibility(_visibility))
     {
+        MIntArray visibilitySizeArray;
+        status = MVGMayaUtil::getIntArrayAttribute(pointCloud, "mvg_visibilitySize",
+                                                   visibilitySizeArray);
+        CHECK_RETURN(status)
+
+        MIntArray visibilitiesArray;
         int step = 1;
         status = MVGMayaUtil::getIntArrayAttribute(pointCloud, "mvg_visibilityViewId", visibilitiesArray);
         if(status == MS::kSuccess)
@@ -512,17 +589,10 @@ void MVGProjectWrapper::loadABC(const QString& abcFilePath)
             CHECK_RETURN(status)
         }
 
-        int fullNbVisibilities = 0;
-        for(int j = 0; j < visibilitySizeArray.length(); ++j)
-        {
-            int nbViews = visibilitySizeArray[j];
-            fullNbVisibilities += nbViews;
-        }
-        if(fullNbVisibilities * step != visibilitiesArray.length())
+        if(!_visibility.build(visibilitySizeArray, visibilitiesArray, step))
         {
             LOG_ERROR("Incorrect file: mvg_visibilitySize is not coherent with mvg_visibilityIds."
                       "(mvg_visibilitySize length= " + std::to_string(visibilitySizeArray.length()) +
-                      ", mvg_visibilitySize total= " + std::to_string(fullNbVisibilities) +
                       ", mvg_visibilityIds size= " + std::to_string(visibilitiesArray.length()) +
                       ", step= " + std::to_string(step) +
                       ")")
@@ -531,23 +601,11 @@ void MVGProjectWrapper::loadABC(const QString& abcFilePath)
         {
             LOG_INFO("Valid file: mvg_visibilitySize is coherent with mvg_visibilityIds."
                       "(mvg_visibilitySize length= " + std::to_string(visibilitySizeArray.length()) +
-                      ", mvg_visibilitySize total= " + std::to_string(fullNbVisibilities) +
+                      ", mvg_visibilitySize total= " +
+                      std::to_string(_visibility.getObservationsCount()) +
                       ", mvg_visibilityIds size= " + std::to_string(visibilitiesArray.length()) +
                       ", step= " + std::to_string(step) +
                       ")")
-            int k = 0;
-            // Browse 3D points
-            for(int j = 0; j < visibilitySizeArray.length(); ++j)
-            {
-                int nbViews = visibilitySizeArray[j];
-                int endPosition = k + nbViews * step;
-                // Browse visibilities
-                for(; k < endPosition; k += step)
-                {
-                    int viewID = visibilitiesArray[k];
-                    itemsPerCam[viewID].append(j);
-                }
-            }
         }
     }
 
@@ -558,29 +616,35 @@ void MVGProjectWrapper::loadABC(const QString& abcFilePath)
         return;
     }
 
-    MDagPathArray cameras;
-    cameraGroupPath.getAllPathsBelow(cameras);
-
-    for(unsigned int i = 0; i < cameras.length(); ++i)
+    // Configure the imported cameras and set their image paths, already done by the native
+    // import. Image planes are created when the cameras are shown.
+    if(!isNativeImport)
     {
-        MDagPath cameraDagPath = cameras[i];
-        if(cameraDagPath.apiType() != MFn::kCamera)
-            continue;
-        MVGCamera::create(cameraDagPath, itemsPerCam);
+        MDagPathArray cameras;
+        cameraGroupPath.getAllPathsBelow(cameras);
+        timer.beginTimer();
+        status = MVGCamera::create(cameras, _visibility,
+                                   QFileInfo(abcFilePath).path().toStdString());
+        timer.endTimer();
+        CHECK(status)
+        LOG_INFO("AbcImport " << importTimings[0] << " s, camera configuration "
+                              << timer.elapsedTime() << " s")
+    }
+    else if(importTimings.length() == 5)
+    {
+        LOG_INFO("SfM import: read " << importTimings[0] << " s, visibility " << importTimings[1]
+                                     << " s, nodes " << importTimings[2] << " s, cameras "
+                                     << importTimings[3] << " s, point cloud "
+                                     << importTimings[4] << " s")
     }
 
-    // Set images paths
-    cmd.format("from meshroomMaya import camera;\n"
-               "camera.setImagesPaths('^1s', '^2s', '^3s', '^4s', '^5s')",
-               abcFilePath.toStdString().c_str(), MVGCamera::_MVG_IMAGE_PATH.asChar(),
-               MVGCamera::_MVG_IMAGE_SOURCE_PATH.asChar(), MVGCamera::_MVG_THUMBNAIL_PATH.asChar(),
-               MVGCamera::_MVG_VIEW_ID.asChar());
-    MGlobal::executePythonCommand(cmd);
+    // Save the visibility for the next reopen
+    _projectCache.write(abcFilePath.toStdString(), _visibility);
 
     _project.lockProject();
 
-    // Update view
-    reloadMVGCamerasFromMaya();
+    // Update view, the visibility index is up to date
+    reloadMVGCamerasFromMaya(false);
 }
 
 void MVGProjectWrapper::remapPaths(const QString& abcFilePath)
@@ -726,6 +790,9 @@ void MVGProjectWrapper::setCameraToView(MVGCameraWrapper* cameraWrapper, const Q
 
     // Update active camera
     _activeCameraNameByView[viewName.toStdString()] = cameraWrapper ? cameraWrapper->getDagPathAsString().toStdString() : "";
+    // Before the early return below, when another view has no camera
+    if(cameraWrapper)
+        prefetchCameraSpacePositions(cameraWrapper, viewName);
 
     // Update data from new configuration
     for(const auto& camByView : _activeCameraNameByView)
@@ -742,6 +809,32 @@ void MVGProjectWrapper::setCameraToView(MVGCameraWrapper* cameraWrapper, const Q
     updatePointsVisibility();
 }
 
+void MVGProjectWrapper::prefetchCameraSpacePositions(MVGCameraWrapper* cameraWrapper,
+                                                     const QString& viewName) const
+{
+    // The cache belongs to the MeshroomMaya context
+    if(!MVGMayaUtil::mvgContextExists())
+        return;
+    // Neighbours of the camera in the current camera set are likely to be viewed next
+    QStringList neighbourCameras;
+    if(_currentCameraSet)
+    {
+        QObjectListModel* cameras = _currentCameraSet->getCameras();
+        const int index = cameras->indexOf(cameraWrapper);
+        if(index > 0)
+            neighbourCameras.append(
+                static_cast<MVGCameraWrapper*>(cameras->at(index - 1))->getDagPathAsString());
+        if(index >= 0 && index + 1 < cameras->count())
+            neighbourCameras.append(
+                static_cast<MVGCameraWrapper*>(cameras->at(index + 1))->getDagPathAsString());
+    }
+    MString cmd;
+    cmd.format("^1s -e -prefetch \"^2s\" \"^3s\" ^4s", MVGContextCmd::name,
+               MQtUtil::toMString(viewName), MQtUtil::toMString(neighbourCameras.join(" ")),
+               MVGContextCmd::instanceName);
+    MGlobal::executeCommand(cmd);
+}
+
 void MVGProjectWrapper::setPerspFromCamera(MVGCameraWrapper *wrapper)
 {
     // Retrieve "persp" cam transform
@@ -811,9 +904,9 @@ void MVGProjectWrapper::updatePointsVisibility()
     status = MDagPath::getAPathTo(locator, locatorPath);
     CHECK_RETURN(status)
 
-    std::vector<MVGPointCloudItem> allPoints;
     MVGPointCloud pointCloud(MVGProject::_CLOUD);
-    pointCloud.getItems(allPoints);
+    status = MVGPointCloudCache::update(pointCloud.getDagPath());
+    CHECK_RETURN(status)
 
     // PointCloudItem positions are in world space;
     // multiply them by the locator inverse matrix to be independent from the locator transform
@@ -830,14 +923,14 @@ void MVGProjectWrapper::updatePointsVisibility()
         const auto& cameraPoints = *(pointsPerCamera[camName]);
         MPointArray array;
         for(const auto& point : cameraPoints)
-            array.append(locatorInverseMatrix * allPoints[point]._position);
+            array.append(locatorInverseMatrix * MVGPointCloudCache::getPosition(point));
         MVGMayaUtil::setPointArrayAttribute(locator, attrName.c_str(), array);
     }
 
     { // Common points
         MPointArray array;
         for(const auto& point : intersection)
-            array.append(locatorInverseMatrix * allPoints[point]._position);
+            array.append(locatorInverseMatrix * MVGPointCloudCache::getPosition(point));
         MVGMayaUtil::setPointArrayAttribute(locator, "mvgCommonPoints", array);
     }
 }
@@ -1036,6 +1129,8 @@ void MVGProjectWrapper::removeCameraFromUI(MObject& camera)
         if(idx >= 0)
             setWrapper->getCameras()->removeAt(idx);
     }
+    std::replace(_visibilityCameras.begin(), _visibilityCameras.end(), wrapper,
+                 static_cast<MVGCameraWrapper*>(nullptr));
 
     // Clear the views if needed
     MDagPath leftCameraPath, rightCameraPath;
@@ -1144,30 +1239,28 @@ void MVGProjectWrapper::setMoveMode(const int mode)
     Q_EMIT moveModeChanged();
 }
 
-void MVGProjectWrapper::reloadMVGCamerasFromMaya()
+void MVGProjectWrapper::reloadMVGCamerasFromMaya(const bool rebuildVisibility)
 {
     _camerasByName.clear();
     _activeCameraNameByView.clear();
-    _camerasPerPoint.clear();
+    _visibilityCameras.clear();
     _cameraSetsByName.clear();
     _cameraSets.clear();
     _selectionScorePerCamera.clear();
 
     const std::vector<MVGCamera>& cameraList = MVGCamera::getCameras();
+    if(rebuildVisibility)
+        loadVisibility(cameraList);
+    _visibilityCameras.resize(_visibility.getCamerasCount(), nullptr);
     QObjectList camWrappers;
     for(const auto& camera : cameraList)
     {
         MVGCameraWrapper* cameraWrapper = new MVGCameraWrapper(camera);
         camWrappers.append(cameraWrapper);
         _camerasByName[camera.getDagPathAsString()] = cameraWrapper;
-        MIntArray indices;
-        camera.getVisibleIndexes(indices);
-        for(unsigned int i = 0; i < indices.length(); ++i)
-        {
-            if(!_camerasPerPoint.count(indices[i]))
-                _camerasPerPoint.emplace(indices[i], std::vector<MVGCameraWrapper*>());
-            _camerasPerPoint[indices[i]].push_back(cameraWrapper);
-        }
+        const int cameraIndex = _visibility.findCamera(camera.getId());
+        if(cameraIndex >= 0)
+            _visibilityCameras[cameraIndex] = cameraWrapper;
         MObject cam = camera.getObject();
         // Lock cam node to avoid manipulation errors
         MFnDagNode dagCam(cam);
@@ -1193,6 +1286,31 @@ void MVGProjectWrapper::reloadMVGCamerasFromMaya()
     }
 }
 
+void MVGProjectWrapper::loadVisibility(const std::vector<MVGCamera>& cameras)
+{
+    // The index may use the rows of the cache, which are unmapped by open() and write()
+    _visibility.clear();
+    const std::string projectPath = _project.getProjectDirectory();
+    MVGPointCloud pointCloud(MVGProject::_CLOUD);
+    if(!pointCloud.isValid())
+    {
+        _visibility.build(cameras);
+        return;
+    }
+    std::vector<int> viewIds;
+    viewIds.reserve(cameras.size());
+    for(size_t i = 0; i < cameras.size(); ++i)
+        viewIds.push_back(cameras[i].getId());
+    std::sort(viewIds.begin(), viewIds.end());
+    if(_projectCache.open(projectPath, viewIds, pointCloud.getItemsCount()))
+    {
+        _visibility.assign(_projectCache.getVisibilityRows());
+        return;
+    }
+    _visibility.build(cameras);
+    _projectCache.write(projectPath, _visibility);
+}
+
 void MVGProjectWrapper::updatePanelColor(const QString& viewName)
 {
     // Update panel's color
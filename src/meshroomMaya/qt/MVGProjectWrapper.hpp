@@ -6,6 +6,8 @@
 #include "meshroomMaya/qt/MVGCameraSetWrapper.hpp"
 #include "meshroomMaya/qt/MVGMeshWrapper.hpp"
 #include "meshroomMaya/core/MVGProject.hpp"
+#include "meshroomMaya/core/MVGProjectCache.hpp"
+#include "meshroomMaya/core/MVGVisibilityIndex.hpp"
 #include "maya/MDistance.h"
 #include <QObject>
 #include <set>
@@ -213,7 +215,9 @@ protected Q_SLOTS:
 private:
     void initCameraPointsLocator();
     void updatePointsVisibility();
-    void reloadMVGCamerasFromMaya();
+    void reloadMVGCamerasFromMaya(const bool rebuildVisibility = true);
+    /// Map the visibility from the project cache, or rebuild it from the cameras and save it
+    void loadVisibility(const std::vector<MVGCamera>& cameras);
     /// Update members of the camera set based on particle selection
     void updateCamerasFromParticleSelection(bool force=false);
     /// Update set's MVGCameraSetWrapper members (MVGCameraWrappers)
@@ -222,6 +226,9 @@ private:
     void setCurrentCameraSet(MVGCameraSetWrapper *wrapper);
     MVGCameraWrapper* cameraFromViewName(const QString& viewName);
     MVGPanelWrapper* panelFromViewName(const QString& viewName);
+    /// Precompute the manipulator cache of the camera set in a view, and of its neighbours
+    void prefetchCameraSpacePositions(MVGCameraWrapper* cameraWrapper,
+                                      const QString& viewName) const;
 
 private:
     QObjectListModel _cameraSets;
@@ -243,7 +250,11 @@ private:
     int _currentCameraSetId;
     std::set<int> _particleSelection;
     std::map<MVGCameraWrapper*, int> _selectionScorePerCamera;
-    std::map<int, std::vector<MVGCameraWrapper*>> _camerasPerPoint;
+    MVGVisibilityIndex _visibility;
+    /// wrapper of each camera of the visibility index, null if removed
+    std::vector<MVGCameraWrapper*> _visibilityCameras;
+    /// sidecar of the project, may hold the rows of the visibility index
+    MVGProjectCache _projectCache;
     int _particleSelectionAccuracy;
     int _particleMaxAccuracy;
     bool _filterPoints;
@@ -34,7 +34,7 @@ Item {
             implicitWidth: 30
             height: 30
             iconSource: "img/Folder.png"
-            tooltip: "Select project file (.abc)"
+            tooltip: "Select project file (.abc, .sfm, .json)"
             onClicked: {
                 var abcFile = m.project.openFileDialog()
                 m.project.loadABC(abcFile)
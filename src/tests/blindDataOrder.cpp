@@ -0,0 +1,77 @@
+/**
+ * Check that the blind data of a vertex are found by camera id once sorted, with AliceVision
+ * view ids on both sides of 2^31 (negative once passed around as int).
+ */
+#include "meshroomMaya/core/MVGBlindDataOrder.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace meshroomMaya;
+
+namespace
+{ // empty namespace
+
+/// Same layout as MVGMesh::ClickedCSPosition
+struct ClickedCSPosition
+{
+    unsigned int cameraId;
+    double x;
+    double y;
+};
+
+} // empty namespace
+
+int main()
+{
+    const unsigned int viewIds[] = {0u,          1u,          12345u,      0x7FFFFFFEu,
+                                    0x7FFFFFFFu, 0x80000000u, 0x80000001u, 2840194503u,
+                                    3000000000u, 0xFFFFFFFEu, 0xFFFFFFFFu};
+    const int viewIdsCount = sizeof(viewIds) / sizeof(viewIds[0]);
+    std::mt19937 generator(42);
+    int failures = 0;
+
+    for(int test = 0; test < 1000; ++test)
+    {
+        // random subset of the view ids, in random order
+        std::vector<ClickedCSPosition> blindData;
+        std::vector<bool> isObserved(viewIdsCount, false);
+        for(int i = 0; i < viewIdsCount; ++i)
+        {
+            if(generator() % 2)
+                continue;
+            const ClickedCSPosition position = {viewIds[i], (double)i, (double)test};
+            blindData.push_back(position);
+            isObserved[i] = true;
+        }
+        if(blindData.empty())
+            continue;
+        std::shuffle(blindData.begin(), blindData.end(), generator);
+        std::sort(blindData.begin(), blindData.end(), blindDataOrder::isLess<ClickedCSPosition>);
+
+        const ClickedCSPosition* first = &blindData[0];
+        const ClickedCSPosition* last = first + blindData.size();
+        for(int i = 0; i < viewIdsCount; ++i)
+        {
+            // camera ids are read from the int mvg_viewId attribute
+            const int cameraId = static_cast<int>(viewIds[i]);
+            const ClickedCSPosition* it = blindDataOrder::find(first, last, cameraId);
+            const bool isFound = (it != NULL) && (it->x == (double)i);
+            if(isFound == isObserved[i])
+                continue;
+            if(failures == 0)
+                std::printf("view id %u (%d) %s\n", viewIds[i], cameraId,
+                            isObserved[i] ? "not found" : "found but not observed");
+            ++failures;
+        }
+    }
+    if(failures > 0)
+    {
+        std::printf("FAILED: %d wrong lookups\n", failures);
+        return EXIT_FAILURE;
+    }
+    std::printf("OK\n");
+    return EXIT_SUCCESS;
+}
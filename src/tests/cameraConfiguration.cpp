@@ -0,0 +1,251 @@
+/**
+ * Compare the configuration of the cameras imported by AbcImport, side by side on the same
+ * synthetic cameras: the batch MVGCamera::create against the previous path, one MDagModifier
+ * per camera followed by one getAttr/setAttr pass per camera for the image paths. Both paths
+ * must give the same attributes.
+ * Runs in a Maya standalone session.
+ *
+ * Usage: meshroomMaya_cameraConfiguration [camerasCount...]
+ */
+#include "meshroomMaya/core/MVGCamera.hpp"
+#include "meshroomMaya/core/MVGVisibilityIndex.hpp"
+#include "meshroomMaya/maya/MVGMayaUtil.hpp"
+#include <maya/MDagModifier.h>
+#include <maya/MDagPath.h>
+#include <maya/MDagPathArray.h>
+#include <maya/MFnCamera.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnTypedAttribute.h>
+#include <maya/MGlobal.h>
+#include <maya/MIntArray.h>
+#include <maya/MLibrary.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace meshroomMaya;
+
+namespace
+{ // empty namespace
+
+const std::string PROJECT_DIRECTORY = "/data/project";
+/// Cameras seeing each point
+const int OBSERVATIONS_PER_POINT = 3;
+const int POINTS_PER_CAMERA = 2000;
+
+double getSeconds(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// Cameras as left by AbcImport: view id and source image path, no other MVG attribute
+MStatus createCameras(const int camerasCount, MDagPathArray& cameraPaths)
+{
+    MStatus status;
+    MDagModifier dagModifier;
+    std::vector<MObject> shapes;
+    for(int i = 0; i < camerasCount; ++i)
+    {
+        const MObject transform = dagModifier.createNode("transform", MObject::kNullObj);
+        const MObject shape = dagModifier.createNode("camera", transform);
+        MFnNumericAttribute nAttr;
+        MFnTypedAttribute tAttr;
+        dagModifier.addAttribute(
+            shape, nAttr.create(MVGCamera::_MVG_VIEW_ID, "mvgvi", MFnNumericData::kInt, -1));
+        dagModifier.addAttribute(
+            shape, tAttr.create(MVGCamera::_MVG_IMAGE_PATH, "mvgimp", MFnData::kString));
+        shapes.push_back(shape);
+    }
+    status = dagModifier.doIt();
+    if(!status)
+        return status;
+    cameraPaths.clear();
+    char imagePath[64];
+    for(int i = 0; i < camerasCount; ++i)
+    {
+        MDagPath path;
+        MDagPath::getAPathTo(shapes[i], path);
+        cameraPaths.append(path);
+        std::snprintf(imagePath, sizeof(imagePath), "/data/images/IMG_%05d.JPG", i);
+        MVGMayaUtil::setIntAttribute(shapes[i], MVGCamera::_MVG_VIEW_ID, 1000 + i);
+        MVGMayaUtil::setStringAttribute(shapes[i], MVGCamera::_MVG_IMAGE_PATH, imagePath);
+    }
+    return status;
+}
+
+/// Each point seen by consecutive cameras, as in a turntable capture
+void createVisibility(const int camerasCount, MVGVisibilityIndex& visibility)
+{
+    const int pointsCount = camerasCount * POINTS_PER_CAMERA / OBSERVATIONS_PER_POINT;
+    MIntArray visibilitySizes(pointsCount, OBSERVATIONS_PER_POINT);
+    MIntArray viewIds(pointsCount * OBSERVATIONS_PER_POINT);
+    for(int p = 0; p < pointsCount; ++p)
+    {
+        for(int o = 0; o < OBSERVATIONS_PER_POINT; ++o)
+            viewIds[p * OBSERVATIONS_PER_POINT + o] =
+                1000 + (p * OBSERVATIONS_PER_POINT / POINTS_PER_CAMERA + o) % camerasCount;
+    }
+    visibility.build(visibilitySizes, viewIds, 1);
+}
+
+/**
+ * Previous configuration: MVGCamera::create was called for each camera with its own
+ * MDagModifier, then camera.setImagesPaths set the image paths with getAttr and setAttr on
+ * each camera. The commands are run in MEL here, Python being not available in standalone.
+ */
+MStatus configurePerCamera(const MDagPathArray& cameraPaths, const MVGVisibilityIndex& visibility,
+                           const std::string& projectDirectory)
+{
+    MStatus status;
+    for(unsigned int i = 0; i < cameraPaths.length(); ++i)
+    {
+        const MObject cameraNode = cameraPaths[i].node();
+        MFnCamera fnCamera(cameraPaths[i]);
+        fnCamera.setPanZoomEnabled(true);
+        fnCamera.setHorizontalFilmOffset(0.0);
+        fnCamera.setVerticalFilmOffset(0.0);
+
+        MDagModifier dagModifier;
+        MFnTypedAttribute tAttr;
+        int viewID;
+        MVGMayaUtil::getIntAttribute(cameraNode, MVGCamera::_MVG_VIEW_ID, viewID);
+        dagModifier.addAttribute(cameraNode,
+                                 tAttr.create(MVGCamera::_MVG_ITEMS, "itm", MFnData::kIntArray));
+        dagModifier.addAttribute(
+            cameraNode, tAttr.create(MVGCamera::_MVG_THUMBNAIL_PATH, "mtp", MFnData::kString));
+        dagModifier.addAttribute(
+            cameraNode, tAttr.create(MVGCamera::_MVG_IMAGE_SOURCE_PATH, "misp", MFnData::kString));
+        status = dagModifier.doIt();
+        if(!status)
+            return status;
+
+        MIntArray items;
+        visibility.getCameraPoints(visibility.findCamera(viewID), items);
+        MVGMayaUtil::setIntArrayAttribute(cameraNode, MVGCamera::_MVG_ITEMS, items);
+    }
+    for(unsigned int i = 0; i < cameraPaths.length(); ++i)
+    {
+        const MString camera = cameraPaths[i].fullPathName();
+        MString cmd;
+        MString imagePath;
+        cmd.format("getAttr \"^1s.^2s\"", camera, MVGCamera::_MVG_IMAGE_PATH);
+        status = MGlobal::executeCommand(cmd, imagePath);
+        if(!status)
+            return status;
+        int viewID;
+        cmd.format("getAttr \"^1s.^2s\"", camera, MVGCamera::_MVG_VIEW_ID);
+        MGlobal::executeCommand(cmd, viewID);
+        std::string proxyPath;
+        std::string thumbnailPath;
+        MVGCamera::getUndistortedImagePaths(projectDirectory, imagePath.asChar(), viewID,
+                                            proxyPath, thumbnailPath);
+        cmd.format("setAttr -type \"string\" \"^1s.^2s\" \"^3s\"", camera,
+                   MVGCamera::_MVG_IMAGE_SOURCE_PATH, imagePath);
+        MGlobal::executeCommand(cmd);
+        cmd.format("setAttr -type \"string\" \"^1s.^2s\" \"^3s\"", camera,
+                   MVGCamera::_MVG_IMAGE_PATH, proxyPath.c_str());
+        MGlobal::executeCommand(cmd);
+        cmd.format("setAttr -type \"string\" \"^1s.^2s\" \"^3s\"", camera,
+                   MVGCamera::_MVG_THUMBNAIL_PATH, thumbnailPath.c_str());
+        MGlobal::executeCommand(cmd);
+    }
+    return status;
+}
+
+bool isSameCamera(const MObject& a, const MObject& b)
+{
+    MIntArray itemsA;
+    MIntArray itemsB;
+    MVGMayaUtil::getIntArrayAttribute(a, MVGCamera::_MVG_ITEMS, itemsA);
+    MVGMayaUtil::getIntArrayAttribute(b, MVGCamera::_MVG_ITEMS, itemsB);
+    if(itemsA.length() != itemsB.length())
+        return false;
+    for(unsigned int i = 0; i < itemsA.length(); ++i)
+    {
+        if(itemsA[i] != itemsB[i])
+            return false;
+    }
+    const MString attributes[] = {MVGCamera::_MVG_IMAGE_PATH, MVGCamera::_MVG_IMAGE_SOURCE_PATH,
+                                  MVGCamera::_MVG_THUMBNAIL_PATH};
+    for(size_t i = 0; i < sizeof(attributes) / sizeof(attributes[0]); ++i)
+    {
+        MString valueA;
+        MString valueB;
+        MVGMayaUtil::getStringAttribute(a, attributes[i], valueA);
+        MVGMayaUtil::getStringAttribute(b, attributes[i], valueB);
+        if(valueA != valueB)
+            return false;
+    }
+    return MFnCamera(a).isPanZoomEnabled() && MFnCamera(b).isPanZoomEnabled();
+}
+
+} // empty namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<int> camerasCounts;
+    for(int i = 1; i < argc; ++i)
+        camerasCounts.push_back(std::atoi(argv[i]));
+    if(camerasCounts.empty())
+    {
+        camerasCounts.push_back(100);
+        camerasCounts.push_back(500);
+        camerasCounts.push_back(2000);
+    }
+
+    MStatus status = MLibrary::initialize(true, argv[0], true);
+    if(!status)
+    {
+        std::printf("Unable to initialize Maya: %s\n", status.errorString().asChar());
+        return EXIT_FAILURE;
+    }
+
+    int failures = 0;
+    std::printf("%8s %16s %12s %9s\n", "cameras", "per camera (s)", "batch (s)", "speed-up");
+    for(size_t c = 0; c < camerasCounts.size(); ++c)
+    {
+        const int camerasCount = camerasCounts[c];
+        MGlobal::executeCommand("file -force -new");
+        MVGVisibilityIndex visibility;
+        createVisibility(camerasCount, visibility);
+
+        MDagPathArray perCameraPaths;
+        MDagPathArray batchPaths;
+        if(!createCameras(camerasCount, perCameraPaths) || !createCameras(camerasCount, batchPaths))
+        {
+            std::printf("Unable to create %d cameras\n", camerasCount);
+            ++failures;
+            continue;
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const MStatus perCameraStatus =
+            configurePerCamera(perCameraPaths, visibility, PROJECT_DIRECTORY);
+        const double perCameraSeconds = getSeconds(start);
+        start = std::chrono::steady_clock::now();
+        const MStatus batchStatus = MVGCamera::create(batchPaths, visibility, PROJECT_DIRECTORY);
+        const double batchSeconds = getSeconds(start);
+
+        std::printf("%8d %16.3f %12.3f %8.1fx\n", camerasCount, perCameraSeconds, batchSeconds,
+                    batchSeconds > 0.0 ? perCameraSeconds / batchSeconds : 0.0);
+        if(!perCameraStatus || !batchStatus)
+        {
+            std::printf("  configuration failed\n");
+            ++failures;
+            continue;
+        }
+        for(int i = 0; i < camerasCount; ++i)
+        {
+            if(isSameCamera(perCameraPaths[i].node(), batchPaths[i].node()))
+                continue;
+            std::printf("  camera %d differs between the two paths\n", i);
+            ++failures;
+            break;
+        }
+    }
+
+    MLibrary::cleanup(0, false);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,223 @@
+/**
+ * Compare the plane estimators of MVGGeometryUtil on synthetic noisy planes with outliers:
+ * latency and plane error of the adaptive RANSAC (and of the exact least median sweep for line
+ * constrained fits) against LeastMedianOfSquares.
+ *
+ * Usage: meshroomMaya_planeEstimator [trialsCount]
+ */
+#include "meshroomMaya/core/MVGEigen.hpp"
+#include "meshroomMaya/core/MVGLineConstrainedPlaneKernel.hpp"
+#include "meshroomMaya/core/MVGPlaneKernel.hpp"
+#include "meshroomMaya/core/MVGRansac.hpp"
+#include <aliceVision/robustEstimation/leastMedianOfSquares.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace meshroomMaya;
+
+namespace
+{ // empty namespace
+
+/// Same threshold as MVGGeometryUtil::_ransacRelativeThreshold
+const double RELATIVE_THRESHOLD = 0.01;
+const double PLANE_SIZE = 10.0;
+
+struct Scene
+{
+    aliceVision::Mat points;
+    aliceVision::Vec4 plane;
+    /// two points of the plane, for the line constrained fits
+    aliceVision::Vec3 lineP0;
+    aliceVision::Vec3 lineP1;
+    int inliersCount;
+};
+
+/// Noisy samples of a random plane, the last ones replaced by outliers spread around it
+void createScene(std::mt19937& generator, const int pointsCount, const double outlierRatio,
+                 const double noise, Scene& scene)
+{
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::uniform_real_distribution<double> uniform(-0.5 * PLANE_SIZE, 0.5 * PLANE_SIZE);
+    aliceVision::Vec3 n(normal(generator), normal(generator), normal(generator));
+    n.normalize();
+    const aliceVision::Vec3 origin(uniform(generator), uniform(generator), uniform(generator));
+    // orthonormal basis of the plane
+    aliceVision::Vec3 u = n.cross(std::abs(n(0)) < 0.9 ? aliceVision::Vec3::UnitX()
+                                                       : aliceVision::Vec3::UnitY());
+    u.normalize();
+    const aliceVision::Vec3 v = n.cross(u);
+    scene.plane.head<3>() = n;
+    scene.plane(3) = -n.dot(origin);
+    scene.lineP0 = origin - 0.25 * PLANE_SIZE * u;
+    scene.lineP1 = origin + 0.25 * PLANE_SIZE * u;
+
+    scene.inliersCount = pointsCount - (int)(outlierRatio * pointsCount);
+    scene.points.resize(3, pointsCount);
+    for(int i = 0; i < pointsCount; ++i)
+    {
+        const double offset = (i < scene.inliersCount) ? noise * normal(generator)
+                                                         : uniform(generator);
+        scene.points.col(i) =
+            origin + uniform(generator) * u + uniform(generator) * v + offset * n;
+    }
+}
+
+double getBoundingBoxDiagonal(const aliceVision::Mat& points)
+{
+    return (points.rowwise().maxCoeff() - points.rowwise().minCoeff()).norm();
+}
+
+/// Angle between the estimated and the true normals, in degrees
+double getAngleError(const aliceVision::Vec4& model, const aliceVision::Vec4& plane)
+{
+    const double norm = model.head<3>().norm();
+    if(norm <= 0.0)
+        return 90.0;
+    const double cosine = std::abs(model.head<3>().dot(plane.head<3>())) / norm;
+    return std::acos(std::min(1.0, cosine)) * 180.0 / std::acos(-1.0);
+}
+
+/// Mean distance of the true inliers to the estimated plane
+double getDistanceError(const aliceVision::Vec4& model, const Scene& scene)
+{
+    const double norm = model.head<3>().norm();
+    if(norm <= 0.0)
+        return std::numeric_limits<double>::infinity();
+    double sum = 0.0;
+    for(int i = 0; i < scene.inliersCount; ++i)
+        sum += std::abs(model.head<3>().dot(scene.points.col(i)) + model(3)) / norm;
+    return sum / scene.inliersCount;
+}
+
+struct Statistics
+{
+    Statistics()
+        : milliseconds(0.0)
+        , maxMilliseconds(0.0)
+        , angleError(0.0)
+        , distanceError(0.0)
+        , failures(0)
+    {
+    }
+    void add(const double time, const bool found, const aliceVision::Vec4& model,
+             const Scene& scene)
+    {
+        milliseconds += time;
+        maxMilliseconds = std::max(maxMilliseconds, time);
+        if(!found)
+        {
+            ++failures;
+            return;
+        }
+        angleError += getAngleError(model, scene.plane);
+        distanceError += getDistanceError(model, scene);
+    }
+    void print(const char* name, const int trialsCount) const
+    {
+        const int successes = std::max(1, trialsCount - failures);
+        std::printf("    %-22s %9.3f ms (max %8.3f) %9.4f deg %11.5f  %d failures\n", name,
+                    milliseconds / trialsCount, maxMilliseconds, angleError / successes,
+                    distanceError / successes, failures);
+    }
+    double milliseconds;
+    double maxMilliseconds;
+    double angleError;
+    double distanceError;
+    int failures;
+};
+
+typedef std::chrono::steady_clock Clock;
+
+double elapsedMilliseconds(const Clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // empty namespace
+
+int main(int argc, char** argv)
+{
+    const int trialsCount = (argc > 1) ? std::atoi(argv[1]) : 20;
+    const int pointsCounts[] = {20, 200, 2000};
+    const double outlierRatios[] = {0.0, 0.2, 0.4};
+    const double noise = 0.002 * PLANE_SIZE;
+    std::mt19937 generator(42);
+    bool isValid = true;
+
+    std::printf("%d trials per case, noise %g, plane size %g\n", trialsCount, noise, PLANE_SIZE);
+    std::printf("estimator: mean time (max time), mean normal angle error, mean distance of the "
+                "inliers to the plane\n");
+    for(int p = 0; p < 3; ++p)
+    {
+        for(int o = 0; o < 3; ++o)
+        {
+            std::printf("%d points, %d%% outliers\n", pointsCounts[p],
+                        (int)(100 * outlierRatios[o]));
+            Statistics lmeds;
+            Statistics ransac;
+            Statistics lineLmeds;
+            Statistics lineRansac;
+            Statistics lineSweep;
+            Scene scene;
+            for(int t = 0; t < trialsCount; ++t)
+            {
+                createScene(generator, pointsCounts[p], outlierRatios[o], noise, scene);
+                MVGRansacOptions options;
+                options.threshold = RELATIVE_THRESHOLD * getBoundingBoxDiagonal(scene.points);
+
+                // Plane
+                {
+                    PlaneKernel kernel(scene.points);
+                    PlaneKernel::Model model;
+                    double outlierThreshold = std::numeric_limits<double>::infinity();
+                    Clock::time_point start = Clock::now();
+                    aliceVision::robustEstimation::LeastMedianOfSquares(kernel, &model,
+                                                                        &outlierThreshold);
+                    lmeds.add(elapsedMilliseconds(start), true, model, scene);
+
+                    start = Clock::now();
+                    const bool found = adaptiveRansac(kernel, options, &model);
+                    ransac.add(elapsedMilliseconds(start), found, model, scene);
+                }
+
+                // Plane through a line
+                {
+                    LineConstrainedPlaneKernel kernel(scene.points, scene.lineP0, scene.lineP1);
+                    LineConstrainedPlaneKernel::Model model;
+                    double outlierThreshold = std::numeric_limits<double>::infinity();
+                    Clock::time_point start = Clock::now();
+                    aliceVision::robustEstimation::LeastMedianOfSquares(kernel, &model,
+                                                                        &outlierThreshold);
+                    lineLmeds.add(elapsedMilliseconds(start), true, model, scene);
+
+                    start = Clock::now();
+                    bool found = adaptiveRansac(kernel, options, &model);
+                    lineRansac.add(elapsedMilliseconds(start), found, model, scene);
+
+                    start = Clock::now();
+                    found = kernel.FitLeastMedian(&model);
+                    lineSweep.add(elapsedMilliseconds(start), found, model, scene);
+                }
+            }
+            lmeds.print("plane LMedS", trialsCount);
+            ransac.print("plane adaptive RANSAC", trialsCount);
+            lineLmeds.print("line LMedS", trialsCount);
+            lineRansac.print("line adaptive RANSAC", trialsCount);
+            lineSweep.print("line least median", trialsCount);
+            isValid &= (ransac.failures == 0) && (lineRansac.failures == 0) &&
+                       (lineSweep.failures == 0);
+        }
+    }
+    if(!isValid)
+    {
+        std::printf("FAILED: an estimator found no plane\n");
+        return EXIT_FAILURE;
+    }
+    std::printf("OK\n");
+    return EXIT_SUCCESS;
+}
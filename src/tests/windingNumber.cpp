@@ -0,0 +1,255 @@
+/**
+ * Check the winding number kernels of MVGWindingNumber.hpp against the routine they replaced,
+ * then time them.
+ *
+ * Usage: meshroomMaya_windingNumber [pointsCount [edgesCount]]
+ */
+#include "meshroomMaya/core/MVGWindingNumber.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace meshroomMaya;
+
+namespace
+{ // empty namespace
+
+struct Point
+{
+    double x;
+    double y;
+};
+
+typedef std::vector<Point> Polygon;
+
+// Previous routine of MVGPointCloud, with the side test truncated to int
+int isLeft(const Point& P0, const Point& P1, const Point& P2)
+{
+    return (int)((P1.x - P0.x) * (P2.y - P0.y) - (P2.x - P0.x) * (P1.y - P0.y));
+}
+
+int wn_PnPoly(const Point& P, const Polygon& V)
+{
+    int wn = 0;
+    for(size_t i = 0; i < V.size() - 1; i++)
+    {
+        if(V[i].y <= P.y)
+        {
+            if(V[i + 1].y > P.y)
+                if(isLeft(V[i], V[i + 1], P) > 0)
+                    ++wn;
+        }
+        else
+        {
+            if(V[i + 1].y <= P.y)
+                if(isLeft(V[i], V[i + 1], P) < 0)
+                    --wn;
+        }
+    }
+    return wn;
+}
+
+/// The kernels take the polygon as separate x and y arrays
+struct SplitPolygon
+{
+    explicit SplitPolygon(const Polygon& polygon)
+        : x(polygon.size())
+        , y(polygon.size())
+        , edgesCount((int)polygon.size() - 1)
+    {
+        for(size_t i = 0; i < polygon.size(); ++i)
+        {
+            x[i] = polygon[i].x;
+            y[i] = polygon[i].y;
+        }
+    }
+    std::vector<double> x;
+    std::vector<double> y;
+    int edgesCount;
+};
+
+/// Same dispatch as windingNumber::compute, but always with the given kernel
+void computeWith(const bool useAVX2, const SplitPolygon& polygon, const std::vector<double>& x,
+                 const std::vector<double>& y, std::vector<int>& windingNumbers)
+{
+    const int count = (int)x.size();
+    windingNumbers.assign(count, 0);
+    int first = 0;
+    if(useAVX2)
+        first = windingNumber::computeAVX2(&polygon.x[0], &polygon.y[0], polygon.edgesCount,
+                                           &x[0], &y[0], count, &windingNumbers[0]);
+    windingNumber::computeScalar(&polygon.x[0], &polygon.y[0], polygon.edgesCount, &x[0],
+                                 &y[0], first, count, &windingNumbers[0]);
+}
+
+/// Random closed polygon, possibly self-intersecting, with integer view space coordinates
+Polygon randomPolygon(std::mt19937& generator, const int edgesCount, const int size)
+{
+    std::uniform_int_distribution<int> coordinate(0, size);
+    Polygon polygon(edgesCount + 1);
+    for(int i = 0; i < edgesCount; ++i)
+    {
+        polygon[i].x = coordinate(generator);
+        polygon[i].y = coordinate(generator);
+    }
+    polygon[edgesCount] = polygon[0];
+    return polygon;
+}
+
+/// Random integer points, a third of them on the vertices and on the edges of the polygon
+void randomPoints(std::mt19937& generator, const Polygon& polygon, const int size,
+                  const int count, std::vector<double>& x, std::vector<double>& y)
+{
+    std::uniform_int_distribution<int> coordinate(-1, size + 1);
+    std::uniform_int_distribution<int> kind(0, 5);
+    std::uniform_int_distribution<int> edge(0, (int)polygon.size() - 2);
+    x.resize(count);
+    y.resize(count);
+    for(int i = 0; i < count; ++i)
+    {
+        const int k = kind(generator);
+        const Point& p0 = polygon[edge(generator)];
+        if(k == 0)
+        {
+            x[i] = p0.x;
+            y[i] = p0.y;
+        }
+        else if(k == 1)
+        {
+            // on the edge, at an integer position if there is one
+            const int e = edge(generator);
+            const Point& a = polygon[e];
+            const Point& b = polygon[e + 1];
+            const int dx = (int)(b.x - a.x);
+            const int dy = (int)(b.y - a.y);
+            int steps = std::abs(dx);
+            int d = std::abs(dy);
+            while(d != 0)
+            {
+                const int r = steps % d;
+                steps = d;
+                d = r;
+            }
+            const int t =
+                (steps == 0) ? 0 : std::uniform_int_distribution<int>(0, steps)(generator);
+            x[i] = a.x + (steps == 0 ? 0 : dx / steps * t);
+            y[i] = a.y + (steps == 0 ? 0 : dy / steps * t);
+        }
+        else
+        {
+            x[i] = coordinate(generator);
+            y[i] = coordinate(generator);
+        }
+    }
+}
+
+int countMismatches(const std::vector<int>& expected, const std::vector<int>& actual,
+                    const char* name)
+{
+    int mismatches = 0;
+    for(size_t i = 0; i < expected.size(); ++i)
+    {
+        if(expected[i] == actual[i])
+            continue;
+        if(mismatches == 0)
+            std::printf("  %s: point %d has winding number %d instead of %d\n", name, (int)i,
+                        actual[i], expected[i]);
+        ++mismatches;
+    }
+    return mismatches;
+}
+
+double milliseconds(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+} // empty namespace
+
+int main(int argc, char** argv)
+{
+    const int pointsCount = (argc > 1) ? std::atoi(argv[1]) : 200000;
+    const int edgesCount = (argc > 2) ? std::atoi(argv[2]) : 64;
+    const bool useAVX2 = windingNumber::hasAVX2();
+    std::printf("AVX2 kernel: %s\n", useAVX2 ? "checked" : "not available");
+    std::mt19937 generator(42);
+    int mismatches = 0;
+
+    // Integer coordinates, as in view space: all the routines must agree
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<int> expected;
+    std::vector<int> actual;
+    for(int test = 0; test < 200; ++test)
+    {
+        const int size = (test % 2) ? 16 : 2000;
+        const Polygon polygon = randomPolygon(generator, 3 + test % 20, size);
+        const int count = 1 + test * 7;
+        randomPoints(generator, polygon, size, count, x, y);
+        const SplitPolygon splitPolygon(polygon);
+        expected.resize(count);
+        for(int i = 0; i < count; ++i)
+        {
+            const Point point = {x[i], y[i]};
+            expected[i] = wn_PnPoly(point, polygon);
+        }
+        computeWith(false, splitPolygon, x, y, actual);
+        mismatches += countMismatches(expected, actual, "scalar");
+        if(useAVX2)
+        {
+            computeWith(true, splitPolygon, x, y, actual);
+            mismatches += countMismatches(expected, actual, "AVX2");
+        }
+    }
+
+    // Real coordinates: the truncation of the previous routine makes it differ near the edges,
+    // the AVX2 kernel must still match the scalar one
+    const Polygon polygon = randomPolygon(generator, edgesCount, 1000);
+    const SplitPolygon splitPolygon(polygon);
+    std::uniform_real_distribution<double> coordinate(-10.0, 1010.0);
+    x.resize(pointsCount);
+    y.resize(pointsCount);
+    for(int i = 0; i < pointsCount; ++i)
+    {
+        x[i] = coordinate(generator);
+        y[i] = coordinate(generator);
+    }
+    auto start = std::chrono::steady_clock::now();
+    computeWith(false, splitPolygon, x, y, expected);
+    const double scalarTime = milliseconds(start);
+
+    actual.assign(pointsCount, 0);
+    start = std::chrono::steady_clock::now();
+    for(int i = 0; i < pointsCount; ++i)
+    {
+        const Point point = {x[i], y[i]};
+        actual[i] = wn_PnPoly(point, polygon);
+    }
+    const double previousTime = milliseconds(start);
+
+    double avx2Time = 0.0;
+    if(useAVX2)
+    {
+        start = std::chrono::steady_clock::now();
+        computeWith(true, splitPolygon, x, y, actual);
+        avx2Time = milliseconds(start);
+        mismatches += countMismatches(expected, actual, "AVX2 (real coordinates)");
+    }
+
+    std::printf("%d points, %d edges\n", pointsCount, edgesCount);
+    std::printf("  previous routine: %8.2f ms\n", previousTime);
+    std::printf("  scalar kernel:    %8.2f ms\n", scalarTime);
+    if(useAVX2)
+        std::printf("  AVX2 kernel:      %8.2f ms\n", avx2Time);
+    if(mismatches > 0)
+    {
+        std::printf("FAILED: %d mismatches\n", mismatches);
+        return EXIT_FAILURE;
+    }
+    std::printf("OK\n");
+    return EXIT_SUCCESS;
+}